@@ -0,0 +1,113 @@
+//
+//  TBActionBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertController.h"
+#import <objc/runtime.h>
+
+@interface TBActionBenchmarkTarget : NSObject
+@property (nonatomic) NSUInteger calls;
+@end
+
+@implementation TBActionBenchmarkTarget
+- (void)fire { self.calls++; }
+- (void)fireWithObject:(id)object { self.calls++; }
+- (void)fireWithObject:(id)object count:(NSInteger)count flag:(BOOL)flag { self.calls += count; }
+@end
+
+/** Reports the heap cost per button of building an alert with \c count buttons, beyond that of an empty alert. */
+static void TBRunButtonStorageBenchmark(NSString *name, NSUInteger count, TBBenchmarkResult *empty,
+                                        void (^build)(TBAlertController *alert)) {
+    NSString *label = [NSString stringWithFormat:@"%lu buttons: %@", (unsigned long)count, name];
+    TBBenchmarkResult *result = [TBBenchmark run:label iterations:MAX(20000 / count, 100) block:^{
+        TBAlertController *alert = [TBAlertController actionSheetWithTitle:@"Move to" message:nil];
+        build(alert);
+    }];
+
+    printf("%-48s %12.1f bytes/button %6.2f allocs/button\n", label.UTF8String,
+        (result.bytesPerOp - empty.bytesPerOp) / count,
+        (result.allocationsPerOp - empty.allocationsPerOp) / count
+    );
+}
+
+/** Buttons added as actions, against buttons stored compactly until something asks for their actions. */
+static void TBRunButtonStorageBenchmarks(void) {
+    if (!TBBenchmark.countsAllocations) {
+        printf("button storage: allocations can't be counted on this platform; skipped\n");
+        return;
+    }
+
+    TBAlertActionBlock handler = ^(NSArray *strings) { };
+    TBBenchmarkResult *empty = [TBBenchmark run:@"0 buttons" iterations:20000 block:^{
+        (void)[TBAlertController actionSheetWithTitle:@"Move to" message:nil];
+    }];
+
+    for (NSNumber *size in @[@5, @50, @500]) {
+        NSUInteger count = size.unsignedIntegerValue;
+        NSMutableArray<NSString *> *titles = [NSMutableArray new];
+        NSMutableArray<TBAlertActionBlock> *handlers = [NSMutableArray new];
+        for (NSUInteger i = 0; i < count; i++) {
+            [titles addObject:[NSString stringWithFormat:@"Folder %lu", (unsigned long)i]];
+            [handlers addObject:handler];
+        }
+
+        TBRunButtonStorageBenchmark(@"addOtherButton:", count, empty, ^(TBAlertController *alert) {
+            for (NSString *title in titles) {
+                [alert addOtherButton:[[TBAlertAction alloc] initWithTitle:title block:handler]];
+            }
+        });
+        TBRunButtonStorageBenchmark(@"addOtherButtonWithTitle:buttonAction:", count, empty, ^(TBAlertController *alert) {
+            for (NSString *title in titles) {
+                [alert addOtherButtonWithTitle:title buttonAction:handler];
+            }
+        });
+        TBRunButtonStorageBenchmark(@"addOtherButtonsWithTitles:buttonActions:", count, empty, ^(TBAlertController *alert) {
+            [alert addOtherButtonsWithTitles:titles buttonActions:handlers];
+        });
+        // What presenting costs on top, since every button needs an action then
+        TBRunButtonStorageBenchmark(@"bulk, then actions read", count, empty, ^(TBAlertController *alert) {
+            [alert addOtherButtonsWithTitles:titles buttonActions:handlers];
+            (void)alert.actions;
+        });
+    }
+}
+
+void TBRunActionBenchmarks(void) {
+    TBActionBenchmarkTarget *target = [TBActionBenchmarkTarget new];
+    NSArray *strings = @[@"first", @"second"];
+    __block NSUInteger blockCalls = 0;
+
+    NSDictionary<NSString *, TBAlertAction *> *actions = @{
+        @"no action": [[TBAlertAction alloc] initWithTitle:@"None"],
+        @"block": [[TBAlertAction alloc] initWithTitle:@"Block" block:^(NSArray *values) {
+            blockCalls++;
+        }],
+        @"target": [[TBAlertAction alloc] initWithTitle:@"Target" target:target action:@selector(fire)],
+        @"target-object": [[TBAlertAction alloc]
+            initWithTitle:@"Object" target:target action:@selector(fireWithObject:) object:@"object"
+        ],
+        @"target-arguments": [[TBAlertAction alloc]
+            initWithTitle:@"Arguments" target:target action:@selector(fireWithObject:count:flag:)
+            arguments:@[@"object", @1, @YES]
+        ],
+    };
+
+    for (NSString *name in [actions.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        TBAlertAction *action = actions[name];
+        printf("%-48s %12zu bytes/action\n",
+            [NSString stringWithFormat:@"%@ (%@)", name, NSStringFromClass(action.class)].UTF8String,
+            class_getInstanceSize(action.class)
+        );
+
+        [TBBenchmark run:[@"perform: " stringByAppendingString:name] iterations:1000000 block:^{
+            [action perform:strings];
+        }];
+    }
+
+    TBRunButtonStorageBenchmarks();
+}
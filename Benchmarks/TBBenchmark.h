@@ -0,0 +1,41 @@
+//
+//  TBBenchmark.h
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** The result of running a single benchmark. */
+@interface TBBenchmarkResult : NSObject
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) NSUInteger iterations;
+@property (nonatomic, readonly) double nanosecondsPerOp;
+@property (nonatomic, readonly) double allocationsPerOp;
+/** Bytes requested from the heap per iteration, including any freed before the iteration ended. */
+@property (nonatomic, readonly) double bytesPerOp;
+/** The most memory the process had resident at once, as of the end of this benchmark. */
+@property (nonatomic, readonly) size_t peakResidentBytes;
+@end
+
+/** Runs small blocks of code many times and reports time and heap allocations per iteration. */
+@interface TBBenchmark : NSObject
+
+/** Whether this platform can count heap allocations. If not, \c allocationsPerOp and \c bytesPerOp are always \c 0. */
+@property (nonatomic, readonly, class) BOOL countsAllocations;
+
+/** Every result so far, in the order the benchmarks ran. */
+@property (nonatomic, readonly, class) NSArray<TBBenchmarkResult *> *results;
+/** The most memory this process has had resident at once so far, in bytes, or \c 0 if unknown. */
+@property (nonatomic, readonly, class) size_t peakResidentBytes;
+
+/** Runs \c block \c iterations times after a short warm up, inside an autorelease pool, and logs the result. */
++ (TBBenchmarkResult *)run:(NSString *)name iterations:(NSUInteger)iterations block:(void (^)(void))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,204 @@
+//
+//  TBBenchmark.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmark.h"
+#include <stdatomic.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#pragma mark Allocation counting
+
+static _Atomic(unsigned long long) TBAllocationCount = 0;
+static _Atomic(unsigned long long) TBAllocatedBytes = 0;
+
+static inline void TBCountAllocation(size_t size) {
+    atomic_fetch_add_explicit(&TBAllocationCount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&TBAllocatedBytes, size, memory_order_relaxed);
+}
+
+#if defined(__APPLE__)
+
+// The same hook used by MallocStackLogging; it's called for every
+// allocation and deallocation in every malloc zone.
+typedef void (TBMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t skip);
+extern TBMallocLogger *malloc_logger;
+
+#define TB_MALLOC_LOG_TYPE_ALLOCATE 2
+#define TB_MALLOC_LOG_TYPE_DEALLOCATE 4
+
+static void TBCountingMallocLogger(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t skip) {
+    if (type & TB_MALLOC_LOG_TYPE_ALLOCATE) {
+        // Reallocations pass the old pointer, then the new size
+        TBCountAllocation(type & TB_MALLOC_LOG_TYPE_DEALLOCATE ? arg3 : arg2);
+    }
+}
+
+static BOOL TBInstallAllocationCounter(void) {
+    if (!malloc_logger) {
+        malloc_logger = TBCountingMallocLogger;
+    }
+
+    return malloc_logger == TBCountingMallocLogger;
+}
+
+#elif defined(__GLIBC__)
+
+// Interpose the allocator; glibc exports its implementation under these names.
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) {
+    TBCountAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    TBCountAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    TBCountAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+static BOOL TBInstallAllocationCounter(void) {
+    return YES;
+}
+
+#else
+
+static BOOL TBInstallAllocationCounter(void) {
+    return NO;
+}
+
+#endif
+
+static unsigned long long TBAllocations(void) {
+    return atomic_load_explicit(&TBAllocationCount, memory_order_relaxed);
+}
+
+static unsigned long long TBBytes(void) {
+    return atomic_load_explicit(&TBAllocatedBytes, memory_order_relaxed);
+}
+
+static size_t TBPeakResidentBytes(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss;
+#else
+    // Kilobytes everywhere else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+}
+
+static unsigned long long TBNanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+#pragma mark - TBBenchmarkResult
+
+@implementation TBBenchmarkResult
+
+- (instancetype)initWithName:(NSString *)name iterations:(NSUInteger)iterations
+                 nanoseconds:(unsigned long long)nanoseconds allocations:(unsigned long long)allocations
+                       bytes:(unsigned long long)bytes peakResidentBytes:(size_t)peakResidentBytes {
+    self = [super init];
+    if (self) {
+        _name = name.copy;
+        _iterations = iterations;
+        _nanosecondsPerOp = (double)nanoseconds / iterations;
+        _allocationsPerOp = (double)allocations / iterations;
+        _bytesPerOp = (double)bytes / iterations;
+        _peakResidentBytes = peakResidentBytes;
+    }
+
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%-48s %12.1f ns/op %10.2f allocs/op",
+        self.name.UTF8String, self.nanosecondsPerOp, self.allocationsPerOp
+    ];
+}
+
+@end
+
+#pragma mark - TBBenchmark
+
+@implementation TBBenchmark
+
+static NSMutableArray<TBBenchmarkResult *> *TBBenchmarkResults = nil;
+
++ (NSArray<TBBenchmarkResult *> *)results {
+    return TBBenchmarkResults.copy ?: @[];
+}
+
++ (size_t)peakResidentBytes {
+    return TBPeakResidentBytes();
+}
+
++ (BOOL)countsAllocations {
+    static BOOL counts = NO;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        counts = TBInstallAllocationCounter();
+    });
+
+    return counts;
+}
+
++ (TBBenchmarkResult *)run:(NSString *)name iterations:(NSUInteger)iterations block:(void (^)(void))block {
+    NSParameterAssert(iterations > 0);
+    BOOL countsAllocations = self.countsAllocations;
+
+    // Warm up caches, lazily initialized statics, etc.
+    @autoreleasepool {
+        for (NSUInteger i = 0; i < MAX(iterations / 10, 1); i++) {
+            block();
+        }
+    }
+
+    unsigned long long allocations = 0, bytes = 0, start = 0, end = 0;
+    @autoreleasepool {
+        allocations = TBAllocations();
+        bytes = TBBytes();
+        start = TBNanoseconds();
+        for (NSUInteger i = 0; i < iterations; i++) {
+            block();
+        }
+        end = TBNanoseconds();
+        allocations = TBAllocations() - allocations;
+        bytes = TBBytes() - bytes;
+    }
+
+    TBBenchmarkResult *result = [[TBBenchmarkResult alloc]
+        initWithName:name
+        iterations:iterations
+        nanoseconds:end - start
+        allocations:countsAllocations ? allocations : 0
+        bytes:countsAllocations ? bytes : 0
+        peakResidentBytes:TBPeakResidentBytes()
+    ];
+
+    if (!TBBenchmarkResults) {
+        TBBenchmarkResults = [NSMutableArray new];
+    }
+    [TBBenchmarkResults addObject:result];
+
+    printf("%s\n", result.description.UTF8String);
+    return result;
+}
+
+@end
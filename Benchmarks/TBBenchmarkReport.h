@@ -0,0 +1,41 @@
+//
+//  TBBenchmarkReport.h
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmark.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Benchmark results as JSON, which can be checked in as a baseline and compared with later runs:
+
+ \code
+ { "peak_rss_bytes": 18874368, "results": [
+     { "name": "...", "iterations": 20000, "ns_per_op": 812.4, "allocs_per_op": 9.0,
+       "bytes_per_op": 704.0, "peak_rss_bytes": 9437184 }, ... ] }
+ \endcode */
+@interface TBBenchmarkReport : NSObject
+
+- (instancetype)initWithResults:(NSArray<TBBenchmarkResult *> *)results peakResidentBytes:(size_t)peakResidentBytes;
+/** @return \c nil if \c data isn't a report. */
+- (nullable instancetype)initWithJSONData:(NSData *)data error:(NSError **)error;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly) NSData *JSONData;
+/** Whether the report has no results, like a baseline that hasn't been recorded yet. */
+@property (nonatomic, readonly, getter=isEmpty) BOOL empty;
+
+/** Describes each benchmark that took longer or allocated more per iteration than it did in \c baseline,
+ by more than \c tolerance, a fraction of the baseline; and the peak resident memory of the whole run.
+ Allocations must also have grown by at least half an allocation per iteration. A benchmark that isn't
+ in both reports, or a baseline without a time or peak memory to compare with, is also listed, so that
+ the baseline can't silently fall out of date.
+ @return An empty array if nothing regressed. */
+- (NSArray<NSString *> *)regressionsFromBaseline:(TBBenchmarkReport *)baseline tolerance:(double)tolerance;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,141 @@
+//
+//  TBBenchmarkReport.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkReport.h"
+
+static NSString * const TBBenchmarkReportErrorDomain = @"TBBenchmarkReportErrorDomain";
+
+@implementation TBBenchmarkReport {
+    /// Each benchmark's entry, by name
+    NSDictionary<NSString *, NSDictionary *> *_entries;
+    /// In the order the benchmarks ran
+    NSArray<NSDictionary *> *_results;
+    size_t _peakResidentBytes;
+}
+
+- (instancetype)initWithResults:(NSArray<TBBenchmarkResult *> *)results peakResidentBytes:(size_t)peakResidentBytes {
+    NSMutableArray<NSDictionary *> *entries = [NSMutableArray new];
+    for (TBBenchmarkResult *result in results) {
+        [entries addObject:@{
+            @"name": result.name,
+            @"iterations": @(result.iterations),
+            @"ns_per_op": @(result.nanosecondsPerOp),
+            @"allocs_per_op": @(result.allocationsPerOp),
+            @"bytes_per_op": @(result.bytesPerOp),
+            @"peak_rss_bytes": @(result.peakResidentBytes),
+        }];
+    }
+
+    return [self initWithEntries:entries peakResidentBytes:peakResidentBytes];
+}
+
+- (instancetype)initWithJSONData:(NSData *)data error:(NSError **)error {
+    NSDictionary *report = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+    if (!report) {
+        return nil;
+    }
+
+    NSArray *entries = [report isKindOfClass:[NSDictionary class]] ? report[@"results"] : nil;
+    if (![entries isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = [NSError errorWithDomain:TBBenchmarkReportErrorDomain code:1 userInfo:@{
+                NSLocalizedDescriptionKey: @"Not a benchmark report: expected an object with a \"results\" array"
+            }];
+        }
+        return nil;
+    }
+
+    for (NSDictionary *entry in entries) {
+        if (![entry isKindOfClass:[NSDictionary class]] || ![entry[@"name"] isKindOfClass:[NSString class]]) {
+            if (error) {
+                *error = [NSError errorWithDomain:TBBenchmarkReportErrorDomain code:2 userInfo:@{
+                    NSLocalizedDescriptionKey: @"Not a benchmark report: every result needs a \"name\""
+                }];
+            }
+            return nil;
+        }
+    }
+
+    return [self initWithEntries:entries peakResidentBytes:[report[@"peak_rss_bytes"] unsignedLongLongValue]];
+}
+
+- (instancetype)initWithEntries:(NSArray<NSDictionary *> *)entries peakResidentBytes:(size_t)peakResidentBytes {
+    self = [super init];
+    if (self) {
+        NSMutableDictionary *byName = [NSMutableDictionary new];
+        for (NSDictionary *entry in entries) {
+            byName[entry[@"name"]] = entry;
+        }
+
+        _results = entries.copy;
+        _entries = byName;
+        _peakResidentBytes = peakResidentBytes;
+    }
+
+    return self;
+}
+
+- (NSData *)JSONData {
+    NSDictionary *report = @{
+        @"peak_rss_bytes": @(_peakResidentBytes),
+        @"results": _results,
+    };
+
+    return [NSJSONSerialization dataWithJSONObject:report options:NSJSONWritingPrettyPrinted error:nil];
+}
+
+- (BOOL)isEmpty {
+    return !_results.count;
+}
+
+- (NSArray<NSString *> *)regressionsFromBaseline:(TBBenchmarkReport *)baseline tolerance:(double)tolerance {
+    NSMutableArray<NSString *> *regressions = [NSMutableArray new];
+    for (NSDictionary *entry in _results) {
+        // Without a time to compare with, a benchmark could regress without anyone noticing
+        NSDictionary *base = baseline->_entries[entry[@"name"]];
+        double ns = [entry[@"ns_per_op"] doubleValue], baseNs = [base[@"ns_per_op"] doubleValue];
+        if (!(baseNs > 0)) {
+            [regressions addObject:[NSString stringWithFormat:@"%@: not in the baseline", entry[@"name"]]];
+            continue;
+        }
+
+        if (ns > baseNs * (1 + tolerance)) {
+            [regressions addObject:[NSString stringWithFormat:@"%@: %.1f ns/op, was %.1f (+%.0f%%)",
+                entry[@"name"], ns, baseNs, (ns / baseNs - 1) * 100
+            ]];
+        }
+
+        // Counts are exact, but a zero baseline can't be scaled, and warm up can leave a fraction behind
+        double allocs = [entry[@"allocs_per_op"] doubleValue], baseAllocs = [base[@"allocs_per_op"] doubleValue];
+        if (allocs > baseAllocs * (1 + tolerance) && allocs - baseAllocs >= 0.5) {
+            [regressions addObject:[NSString stringWithFormat:@"%@: %.2f allocs/op, was %.2f",
+                entry[@"name"], allocs, baseAllocs
+            ]];
+        }
+    }
+
+    // Renamed or removed benchmarks leave stale entries behind
+    for (NSDictionary *base in baseline->_results) {
+        if (!_entries[base[@"name"]]) {
+            [regressions addObject:[NSString stringWithFormat:@"%@: in the baseline, but didn't run", base[@"name"]]];
+        }
+    }
+
+    size_t peak = _peakResidentBytes, basePeak = baseline->_peakResidentBytes;
+    if (!basePeak) {
+        [regressions addObject:@"peak resident memory: not in the baseline"];
+    } else if (peak > basePeak * (1 + tolerance)) {
+        [regressions addObject:[NSString stringWithFormat:@"peak resident memory: %.1fMB, was %.1fMB",
+            peak / (1024.0 * 1024.0), basePeak / (1024.0 * 1024.0)
+        ]];
+    }
+
+    return regressions;
+}
+
+@end
@@ -0,0 +1,30 @@
+//
+//  TBBenchmarkSuites.h
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmark.h"
+
+/// Builder construction: \c +[TBAlert makeAlert:] with short and long fragment chains.
+extern void TBRunBuilderBenchmarks(void);
+/// The same alerts built with the \c TBAlertController API directly, reading \c actions and \c numberOfButtons,
+/// \c removeButtonAtIndex: churn, and capturing text field values when a button is tapped.
+extern void TBRunControllerBenchmarks(void);
+/// \c -[TBAlertAction perform:] for each action style, and the instance size of each; then the heap
+/// bytes and allocations per button of alerts with 5, 50, and 500 buttons, stored compactly or as actions.
+extern void TBRunActionBenchmarks(void);
+/// Showing and dismissing with the headless presenter, with and without \c prepareForPresentation,
+/// batched updates to a presented alert, data source driven pickers, the deadline scheduler,
+/// the cost of tracing to a \c TBAlertTraceBuffer, and answering alerts with a \c TBScriptedAlertPresenter.
+extern void TBRunPresentationBenchmarks(void);
+/// Opening compiled \c TBAlertCatalogs of growing size, decoding one alert, and compiling specs.
+extern void TBRunCatalogBenchmarks(void);
+/// Building alerts on many threads at once, and showing alerts that change between presentations.
+extern void TBRunConcurrencyBenchmarks(void);
+/// A \c TBAlertScheduler working through a backlog of alerts of mixed priority.
+extern void TBRunSchedulerBenchmarks(void);
+/// Finding the view controller to present from in a synthetic tree of 1,000 nodes, cached and not.
+extern void TBRunResolverBenchmarks(void);
@@ -0,0 +1,67 @@
+//
+//  TBBuilderBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertController.h"
+
+void TBRunBuilderBenchmarks(void) {
+    [TBBenchmark run:@"makeAlert: title, message, 2 buttons" iterations:20000 block:^{
+        [TBAlert makeAlert:^(TBAlert *make) {
+            make.title(@"Request failed").message(@"Please try again later.");
+            make.button(@"Retry").handler(^(NSArray<NSString *> *strings) { });
+            make.button(@"Cancel").cancelStyle();
+        }];
+    }];
+
+    [TBBenchmark run:@"makeAlert: 4 buttons, 1 text field" iterations:20000 block:^{
+        [TBAlert makeAlert:^(TBAlert *make) {
+            make.title(@"Sign in");
+            make.textField(@"Password");
+            make.button(@"One");
+            make.button(@"Two").enabled(NO);
+            make.button(@"Delete").destructiveStyle();
+            make.button(@"Cancel").cancelStyle();
+        }];
+    }];
+
+    // Speculatively built alerts should cost nothing for strings that are never shown
+    NSDateFormatter *formatter = [NSDateFormatter new];
+    formatter.dateStyle = NSDateFormatterLongStyle;
+    formatter.timeStyle = NSDateFormatterLongStyle;
+    [TBBenchmark run:@"makeAlert: formatted strings, never shown" iterations:20000 block:^{
+        [TBAlert makeAlert:^(TBAlert *make) {
+            make.title(@"Request failed at ").title([formatter stringFromDate:[NSDate date]]);
+            make.message([NSString localizedStringWithFormat:@"%@ bytes were not sent.", @(123456789)]);
+            make.button(@"Retry");
+        }];
+    }];
+    [TBBenchmark run:@"makeAlert: provided strings, never shown" iterations:20000 block:^{
+        [TBAlert makeAlert:^(TBAlert *make) {
+            make.titleProvider(^{
+                return [@"Request failed at " stringByAppendingString:[formatter stringFromDate:[NSDate date]]];
+            });
+            make.messageProvider(^{
+                return [NSString localizedStringWithFormat:@"%@ bytes were not sent.", @(123456789)];
+            });
+            make.button(@"Retry");
+        }];
+    }];
+
+    // Localized copy is often assembled from many small fragments
+    for (NSUInteger fragments = 8; fragments <= 512; fragments *= 8) {
+        NSString *name = [NSString stringWithFormat:@"makeAlert: %lu title fragments", (unsigned long)fragments];
+        [TBBenchmark run:name iterations:MAX(64, 20000 / fragments) block:^{
+            [TBAlert makeAlert:^(TBAlert *make) {
+                for (NSUInteger i = 0; i < fragments; i++) {
+                    make.title(@"fragment ").message(@"fragment ");
+                }
+                make.button(@"OK").title(@" then").title(@" close");
+            }];
+        }];
+    }
+}
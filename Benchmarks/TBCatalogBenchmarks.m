@@ -0,0 +1,67 @@
+//
+//  TBCatalogBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertCatalog.h"
+
+/// Specs shaped like an app's worth of alerts: mostly unique titles, with shared buttons and messages
+static NSArray<NSDictionary *> *TBCatalogBenchmarkSpecs(NSUInteger count) {
+    NSMutableArray *specs = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [specs addObject:@{
+            @"identifier": [NSString stringWithFormat:@"feature%lu.alert%lu", (unsigned long)(i / 20), (unsigned long)i],
+            @"title": [NSString stringWithFormat:@"Something happened (%lu)", (unsigned long)i],
+            @"message": i % 2 ? @"Please try again later." : @"{count} items could not be saved.",
+            @"buttons": @[@"Retry", @{ @"title": @"Delete", @"role": @"destructive" }, @{ @"title": @"Cancel", @"role": @"cancel" }],
+            @"textFields": i % 10 ? @[] : @[@{ @"identifier": @"password", @"placeholder": @"Password", @"secure": @YES }],
+        }];
+    }
+
+    return specs;
+}
+
+/// Exits if the specs don't compile, which would leave nothing to measure
+static NSData *TBCompileBenchmarkCatalog(NSUInteger count) {
+    NSError *error = nil;
+    NSData *data = [TBAlertCatalog compileSpecs:TBCatalogBenchmarkSpecs(count) error:&error];
+    if (!data) {
+        fprintf(stderr, "error: %lu specs didn't compile: %s\n", (unsigned long)count, error.localizedDescription.UTF8String);
+        exit(1);
+    }
+
+    return data;
+}
+
+void TBRunCatalogBenchmarks(void) {
+    for (NSUInteger count = 100; count <= 10000; count *= 10) {
+        NSData *data = TBCompileBenchmarkCatalog(count);
+        NSString *identifier = [NSString stringWithFormat:@"feature%lu.alert%lu",
+            (unsigned long)(count / 2 / 20), (unsigned long)(count / 2)
+        ];
+
+        // Should stay flat as the catalog grows
+        NSString *name = [NSString stringWithFormat:@"catalog: open, %lu alerts", (unsigned long)count];
+        [TBBenchmark run:name iterations:20000 block:^{
+            [TBAlertCatalog catalogWithData:data error:nil];
+        }];
+
+        name = [NSString stringWithFormat:@"catalog: open and decode one, %lu alerts", (unsigned long)count];
+        [TBBenchmark run:name iterations:5000 block:^{
+            [[TBAlertCatalog catalogWithData:data error:nil] alertControllerWithIdentifier:identifier];
+        }];
+    }
+
+    TBAlertCatalog *catalog = [TBAlertCatalog catalogWithData:TBCompileBenchmarkCatalog(1000) error:nil];
+    [TBBenchmark run:@"catalog: alert controller, already decoded" iterations:20000 block:^{
+        [catalog alertControllerWithIdentifier:@"feature25.alert500"];
+    }];
+
+    [TBBenchmark run:@"catalog: compile 1000 specs" iterations:20 block:^{
+        [TBAlertCatalog compileSpecs:TBCatalogBenchmarkSpecs(1000) error:nil];
+    }];
+}
@@ -0,0 +1,37 @@
+//
+//  TBConcurrencyBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertController.h"
+
+void TBRunConcurrencyBenchmarks(void) {
+    NSUInteger threads = MAX(NSProcessInfo.processInfo.activeProcessorCount, 4);
+
+    // Alerts built where their data arrives, such as in networking callbacks
+    [TBBenchmark run:[NSString stringWithFormat:@"makeAlert: %lu threads at once", (unsigned long)threads]
+          iterations:2000 block:^{
+        dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^(size_t i) {
+            [TBAlert makeAlert:^(TBAlert *make) {
+                make.title(@"Request failed").message(@"Please try again later.");
+                make.button(@"Retry").handler(^(NSArray<NSString *> *strings) { });
+                make.button(@"Cancel").cancelStyle();
+            }];
+        });
+    }];
+
+    // Taking a snapshot shares the buttons; only the next change after it copies them
+    TBAlertController *sheet = [TBAlertController actionSheetWithTitle:@"Move to" message:nil];
+    for (NSUInteger i = 0; i < 64; i++) {
+        [sheet addOtherButtonWithTitle:@"Folder"];
+    }
+    [TBBenchmark run:@"show + dismiss: 64 buttons, changed each time" iterations:5000 block:^{
+        [sheet setButtonEnabled:YES atIndex:0];
+        [sheet showFromViewController:nil animated:NO completion:nil];
+        [sheet dismissAnimated:NO completion:nil];
+    }];
+}
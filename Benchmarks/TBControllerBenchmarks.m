@@ -0,0 +1,76 @@
+//
+//  TBControllerBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertController.h"
+#import "TBHeadlessAlertPresenter.h"
+
+void TBRunControllerBenchmarks(void) {
+    // The same alerts as the builder benchmarks, without the builder
+    [TBBenchmark run:@"direct: title, message, 2 buttons" iterations:20000 block:^{
+        TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Request failed" message:@"Please try again later."];
+        [alert addOtherButtonWithTitle:@"Retry" buttonAction:^(NSArray *strings) { }];
+        [alert setCancelButtonWithTitle:@"Cancel"];
+    }];
+    [TBBenchmark run:@"direct: 4 buttons, 1 text field" iterations:20000 block:^{
+        TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Sign in" message:nil];
+        [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+            textField.placeholder = @"Password";
+        }];
+        [alert addOtherButtonWithTitle:@"One"];
+        [alert addOtherButtonWithTitle:@"Two"];
+        [alert setButtonEnabled:NO atIndex:1];
+        [alert addOtherButtonWithTitle:@"Delete"];
+        alert.destructiveButtonIndex = 2;
+        [alert setCancelButtonWithTitle:@"Cancel"];
+    }];
+
+    // Reads between changes, as when a caller checks the buttons it has added so far
+    TBAlertController *sheet = [TBAlertController actionSheetWithTitle:@"Move to" message:nil];
+    for (NSUInteger i = 0; i < 16; i++) {
+        [sheet addOtherButtonWithTitle:[NSString stringWithFormat:@"Folder %lu", (unsigned long)i]];
+    }
+    [sheet setCancelButtonWithTitle:@"Cancel"];
+    [TBBenchmark run:@"numberOfButtons: 16 buttons" iterations:1000000 block:^{
+        (void)sheet.numberOfButtons;
+    }];
+    [TBBenchmark run:@"actions: 16 buttons, unchanged" iterations:1000000 block:^{
+        (void)sheet.actions;
+    }];
+    [TBBenchmark run:@"actions: 16 buttons, changed each time" iterations:20000 block:^{
+        [sheet setButtonEnabled:YES atIndex:0];
+        (void)sheet.actions;
+    }];
+
+    // Removing from the front shifts every other button down
+    [TBBenchmark run:@"removeButtonAtIndex: add 16, remove 16 from the front" iterations:20000 block:^{
+        for (NSUInteger i = 0; i < 16; i++) {
+            [sheet addOtherButtonWithTitle:@"Scratch"];
+        }
+        for (NSUInteger i = 0; i < 16; i++) {
+            [sheet removeButtonAtIndex:0];
+        }
+    }];
+
+    // Text field values are captured once per decision and handed to the action
+    TBHeadlessAlertPresenter *presenter = [TBHeadlessAlertPresenter new];
+    TBAlertController *login = [TBAlertController alertViewWithTitle:@"Sign in" message:nil];
+    login.presenter = presenter;
+    login.alertViewStyle = UIAlertViewStyleLoginAndPasswordInput;
+    __block NSUInteger captured = 0;
+    [login addOtherButtonWithTitle:@"Sign In" buttonAction:^(NSArray *strings) {
+        captured += strings.count;
+    }];
+    [TBBenchmark run:@"text fields: show, type 2, tap" iterations:20000 block:^{
+        [login showFromViewController:nil animated:NO completion:nil];
+        TBHeadlessAlertPresentation *presentation = presenter.topPresentation;
+        [presentation setText:@"tanner" forTextFieldAtIndex:0];
+        [presentation setText:@"hunter2" forTextFieldAtIndex:1];
+        [presentation tapButtonAtIndex:0];
+    }];
+}
@@ -0,0 +1,147 @@
+//
+//  TBPresentationBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertController.h"
+#import "TBHeadlessAlertPresenter.h"
+#import "TBScriptedAlertPresenter.h"
+
+/** Serves \c count numbered items, like a time zone picker. */
+@interface TBNumberedItems : NSObject <TBAlertControllerDataSource>
+@property (nonatomic) NSUInteger count;
+@end
+
+@implementation TBNumberedItems
+
+- (NSUInteger)numberOfItemsInAlertController:(TBAlertController *)alertController {
+    return self.count;
+}
+
+- (NSString *)alertController:(TBAlertController *)alertController titleForItemAtIndex:(NSUInteger)index {
+    return [NSString stringWithFormat:@"Item %lu", (unsigned long)index];
+}
+
+- (void)alertController:(TBAlertController *)alertController didSelectItemAtIndex:(NSUInteger)index {
+
+}
+
+@end
+
+/** An action sheet with \c count buttons and a cancel button. */
+static TBAlertController *TBLargeActionSheet(NSUInteger count) {
+    TBAlertController *sheet = [TBAlertController actionSheetWithTitle:@"Move to" message:nil];
+    for (NSUInteger i = 0; i < count; i++) {
+        [sheet addOtherButtonWithTitle:[NSString stringWithFormat:@"Folder %lu", (unsigned long)i]];
+    }
+    [sheet setCancelButtonWithTitle:@"Cancel"];
+    return sheet;
+}
+
+void TBRunPresentationBenchmarks(void) {
+    TBAlertController *sheet = TBLargeActionSheet(64);
+
+    [TBBenchmark run:@"show + dismiss: 64 buttons" iterations:5000 block:^{
+        [sheet showFromViewController:nil animated:NO completion:nil];
+        [sheet dismissAnimated:NO completion:nil];
+    }];
+
+    // Preparation happens off the measured path, as it would while the user reads the screen
+    // Enough for the warm up (a tenth of the iterations) and the measured run
+    NSMutableArray<TBAlertController *> *prepared = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 5000 + 500; i++) {
+        TBAlertController *copy = TBLargeActionSheet(64);
+        [copy prepareForPresentation];
+        [prepared addObject:copy];
+    }
+
+    __block NSUInteger next = 0;
+    [TBBenchmark run:@"show + dismiss: 64 buttons, prepared" iterations:5000 block:^{
+        TBAlertController *alert = prepared[next++];
+        [alert showFromViewController:nil animated:NO completion:nil];
+        [alert dismissAnimated:NO completion:nil];
+    }];
+
+    // A progress alert whose buttons change many times before the run loop turns
+    [TBBenchmark run:@"update: 24 edits batched, 8 buttons" iterations:5000 block:^{
+        TBAlertController *alert = TBLargeActionSheet(8);
+        [alert showFromViewController:nil animated:NO completion:nil];
+        for (NSUInteger i = 0; i < 8; i++) {
+            [alert setButtonEnabled:i % 2 atIndex:i];
+            [alert addOtherButtonWithTitle:@"Retry"];
+            [alert removeButtonAtIndex:0];
+        }
+        [alert updateIfNeeded];
+        [alert dismissAnimated:NO completion:nil];
+    }];
+
+    // Pickers with thousands of entries; no actions are created until one is chosen
+    TBNumberedItems *items = [TBNumberedItems new];
+    items.count = 2000;
+
+    [TBBenchmark run:@"data source: show + tap, 2000 items" iterations:200 block:^{
+        TBAlertController *picker = [TBAlertController alertViewWithTitle:@"Pick one" message:nil];
+        picker.dataSource = items;
+        [picker setCancelButtonWithTitle:@"Cancel"];
+        [picker showFromViewController:nil animated:NO completion:nil];
+        [[(TBHeadlessAlertPresenter *)picker.presenter topPresentation] tapButtonAtIndex:1234];
+    }];
+
+    [TBBenchmark run:@"data source: filter \"Item 1\" then \"Item 12\", 2000 items" iterations:200 block:^{
+        TBAlertController *picker = [TBAlertController alertViewWithTitle:@"Pick one" message:nil];
+        picker.dataSource = items;
+        picker.filterText = @"Item 1";
+        picker.filterText = @"Item 12";
+    }];
+
+    // Many transient notices at once share one wakeup; the manual clock keeps this deterministic
+    TBAlertManualClock *clock = [TBAlertManualClock new];
+    TBAlertDeadlineScheduler *scheduler = [[TBAlertDeadlineScheduler alloc] initWithClock:clock];
+
+    [TBBenchmark run:@"deadlines: schedule 1000, cancel half, fire the rest" iterations:200 block:^{
+        NSUInteger tokens[1000];
+        for (NSUInteger i = 0; i < 1000; i++) {
+            tokens[i] = [scheduler scheduleAfter:(i % 37) * 0.1 handler:^{ }];
+        }
+        for (NSUInteger i = 0; i < 1000; i += 2) {
+            [scheduler cancelDeadline:tokens[i]];
+        }
+        [clock advanceBy:4];
+    }];
+
+    // Tracing every lifecycle event to a ring buffer, drained every 64 alerts as an app might upload them
+    TBAlertTraceBuffer *buffer = [[TBAlertTraceBuffer alloc] initWithCapacity:1024];
+    TBAlertTrace.sink = buffer;
+    __block NSUInteger traced = 0;
+
+    [TBBenchmark run:@"show + tap: 64 buttons, traced" iterations:5000 block:^{
+        [sheet showFromViewController:nil animated:NO completion:nil];
+        [[(TBHeadlessAlertPresenter *)sheet.presenter topPresentation] tapButtonAtIndex:0];
+        if (++traced % 64 == 0) {
+            [buffer drainJSON];
+        }
+    }];
+
+    TBAlertTrace.sink = nil;
+
+    [TBBenchmark run:@"show + tap: 64 buttons, untraced" iterations:5000 block:^{
+        [sheet showFromViewController:nil animated:NO completion:nil];
+        [[(TBHeadlessAlertPresenter *)sheet.presenter topPresentation] tapButtonAtIndex:0];
+    }];
+
+    // A test suite's alerts, answered by the third of four rules
+    TBScriptedAlertPresenter *responder = [TBScriptedAlertPresenter new];
+    for (NSString *pattern in @[@"^Delete", @"^Sign in", @"^Move to", @"^Saved"]) {
+        [responder addRule:[TBAlertResponseRule ruleWithTitlePattern:pattern]];
+    }
+    sheet.presenter = responder;
+
+    [TBBenchmark run:@"scripted: show + answer, 64 buttons" iterations:5000 block:^{
+        [sheet showFromViewController:nil animated:NO completion:nil];
+        [responder clearTranscript];
+    }];
+}
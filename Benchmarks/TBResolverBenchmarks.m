@@ -0,0 +1,34 @@
+//
+//  TBResolverBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBPresentingViewControllerResolver.h"
+#import "TBSyntheticNode.h"
+
+void TBRunResolverBenchmarks(void) {
+    TBSyntheticNode *root = TBSyntheticTree();
+    TBPresentingViewControllerResolver *resolver = [TBPresentingViewControllerResolver new];
+
+    [TBBenchmark run:@"resolver: top of 1,000 nodes, cached" iterations:200000 block:^{
+        [resolver topNodeFromRoot:root];
+    }];
+
+    [TBBenchmark run:@"resolver: top of 1,000 nodes, invalidated each time" iterations:200000 block:^{
+        [resolver invalidate];
+        [resolver topNodeFromRoot:root];
+    }];
+
+    TBSyntheticNode *top = TBTopModal(root);
+    TBSyntheticNode *sheet = [TBSyntheticNode new];
+    [TBBenchmark run:@"resolver: present + resolve + dismiss + resolve, 1,000 nodes" iterations:100000 block:^{
+        [top present:sheet];
+        [resolver topNodeFromRoot:root];
+        [top dismiss];
+        [resolver topNodeFromRoot:root];
+    }];
+}
@@ -0,0 +1,33 @@
+//
+//  TBSchedulerBenchmarks.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBAlertScheduler.h"
+#import "TBHeadlessAlertPresenter.h"
+
+void TBRunSchedulerBenchmarks(void) {
+    TBHeadlessAlertPresenter *presenter = [TBHeadlessAlertPresenter new];
+    TBAlertScheduler *scheduler = [TBAlertScheduler new];
+    NSMutableArray<TBAlertController *> *alerts = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 500; i++) {
+        TBAlertController *alert = [TBAlertController alertViewWithTitle:[NSString stringWithFormat:@"Notice %lu", (unsigned long)i] message:nil];
+        alert.presenter = presenter;
+        [alert setCancelButtonWithTitle:@"OK"];
+        [alerts addObject:alert];
+    }
+
+    // A backlog of notices at a spread of priorities, shown and dismissed one at a time
+    [TBBenchmark run:@"scheduler: 500 alerts of mixed priority, queued then tapped through" iterations:50 block:^{
+        for (NSUInteger i = 0; i < alerts.count; i++) {
+            [scheduler scheduleAlert:alerts[i] priority:TBAlertPriorityLow + (i * 7919 % 500) fromViewController:nil];
+        }
+        while (presenter.topPresentation) {
+            [presenter.topPresentation tapButtonAtIndex:0];
+        }
+    }];
+}
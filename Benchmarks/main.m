@@ -0,0 +1,111 @@
+//
+//  main.m
+//  TBAlertBenchmarks
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBBenchmarkSuites.h"
+#import "TBBenchmarkReport.h"
+#import "TBAlertController.h"
+#import "TBHeadlessAlertPresenter.h"
+
+static int TBUsage(const char *program) {
+    fprintf(stderr, "usage: %s [--json <report>] [--baseline <report>] [--tolerance <fraction>]\n", program);
+    return 2;
+}
+
+/// Runs every benchmark suite. For CI, write a JSON report and fail on regressions from a checked-in one:
+///
+///     tbalert-bench --json report.json --baseline Benchmarks/baseline.json --tolerance 0.25
+///
+/// Exits with 1 if any benchmark is slower or allocates more than its baseline by more than the
+/// tolerance, 0.25 by default, or if resident memory peaked that much higher. Benchmarks missing from
+/// the baseline, or in it but no longer run, fail too. A baseline that doesn't exist or has no results
+/// yet only prints a warning, since there is nothing to compare with.
+int main(int argc, const char *argv[]) {
+    @autoreleasepool {
+        NSString *reportPath = nil, *baselinePath = nil;
+        double tolerance = 0.25;
+        for (int i = 1; i < argc; i++) {
+            if (i + 1 == argc) {
+                return TBUsage(argv[0]);
+            }
+
+            if (!strcmp(argv[i], "--json")) {
+                reportPath = @(argv[++i]);
+            } else if (!strcmp(argv[i], "--baseline")) {
+                baselinePath = @(argv[++i]);
+            } else if (!strcmp(argv[i], "--tolerance")) {
+                char *end = NULL;
+                tolerance = strtod(argv[++i], &end);
+                if (*end || tolerance < 0) {
+                    return TBUsage(argv[0]);
+                }
+            } else {
+                return TBUsage(argv[0]);
+            }
+        }
+
+        // Read up front, so that a bad path doesn't waste a whole run
+        TBBenchmarkReport *baseline = nil;
+        if (baselinePath && ![NSFileManager.defaultManager fileExistsAtPath:baselinePath]) {
+            fprintf(stderr, "warning: %s doesn't exist; not checking for regressions\n", baselinePath.UTF8String);
+        } else if (baselinePath) {
+            NSError *error = nil;
+            NSData *data = [NSData dataWithContentsOfFile:baselinePath options:0 error:&error];
+            baseline = data ? [[TBBenchmarkReport alloc] initWithJSONData:data error:&error] : nil;
+            if (!baseline) {
+                fprintf(stderr, "error: %s: %s\n", baselinePath.UTF8String, error.localizedDescription.UTF8String);
+                return 1;
+            }
+            if (baseline.empty) {
+                fprintf(stderr, "warning: %s has no results yet; not checking for regressions\n", baselinePath.UTF8String);
+                baseline = nil;
+            }
+        }
+
+        TBAlertController.defaultPresenter = [TBHeadlessAlertPresenter new];
+
+        if (!TBBenchmark.countsAllocations) {
+            printf("Allocation counting is unavailable on this platform\n");
+        }
+
+        TBRunBuilderBenchmarks();
+        TBRunControllerBenchmarks();
+        TBRunActionBenchmarks();
+        TBRunPresentationBenchmarks();
+        TBRunCatalogBenchmarks();
+        TBRunConcurrencyBenchmarks();
+        TBRunSchedulerBenchmarks();
+        TBRunResolverBenchmarks();
+
+        TBBenchmarkReport *report = [[TBBenchmarkReport alloc]
+            initWithResults:TBBenchmark.results peakResidentBytes:TBBenchmark.peakResidentBytes
+        ];
+        printf("peak resident memory: %.1fMB\n", TBBenchmark.peakResidentBytes / (1024.0 * 1024.0));
+
+        if (reportPath) {
+            NSError *error = nil;
+            if (![report.JSONData writeToFile:reportPath options:NSDataWritingAtomic error:&error]) {
+                fprintf(stderr, "error: %s: %s\n", reportPath.UTF8String, error.localizedDescription.UTF8String);
+                return 1;
+            }
+        }
+
+        if (baseline) {
+            NSArray<NSString *> *regressions = [report regressionsFromBaseline:baseline tolerance:tolerance];
+            for (NSString *regression in regressions) {
+                fprintf(stderr, "regression: %s\n", regression.UTF8String);
+            }
+            if (regressions.count) {
+                return 1;
+            }
+
+            printf("no regressions from %s beyond %.0f%%\n", baselinePath.UTF8String, tolerance * 100);
+        }
+    }
+
+    return 0;
+}
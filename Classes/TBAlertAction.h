@@ -6,7 +6,7 @@
 //  Copyright (c) 2021 Tanner. All rights reserved.
 //
 
-#import <UIKit/UIKit.h>
+#import "TBAlertPlatform.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -17,19 +17,27 @@ NS_ASSUME_NONNULL_BEGIN
 /** A void returning block that takes no parameters. */
 typedef void (^TBVoidBlock)();
 /** A void returning block that takes an array of strings representing the text in each of the text fields of the associated \c TBAlertController.
- If there were no text fields, or if the alert controller style was \c TBAlertControllerStyleActionSheet the array is empty and can be ignored. */
+ If there were no text fields, or if the alert controller style was \c TBAlertControllerStyleActionSheet the array is empty and can be ignored.
+ When called by a \c TBAlertController, the array is a \c TBAlertTextFieldValues, which also supports lookup by text field identifier. */
 typedef void (^TBAlertActionBlock)(NSArray *textFieldStrings);
+/** Returns a string, such as a title, the first time it's needed instead of up front. */
+typedef NSString * _Nullable (^TBAlertStringProvider)(void);
 
-/** All possible action styles (no action, block, target-selector, and single-parameter target-selector). */
+/** All possible action styles (no action, block, target-selector, single-parameter target-selector, and multi-parameter target-selector). */
 typedef NS_ENUM(NSInteger, TBAlertActionStyle) {
     TBAlertActionStyleNoAction = 0,
     TBAlertActionStyleBlock,
     TBAlertActionStyleTarget,
-    TBAlertActionStyleTargetObject
+    TBAlertActionStyleTargetObject,
+    TBAlertActionStyleTargetArguments
 };
 
 /** This class provides a way to add actions to a \c TBAlertController similar to how actions are added to \c UIAlertController.
- All actions added to a \c TBAlertController are converted to \c TBAlertActions. Any \c TBAlertController is safe to use after being properly initialized. */
+ All actions added to a \c TBAlertController are converted to \c TBAlertActions. Any \c TBAlertController is safe to use after being properly initialized.
+ 
+ \c TBAlertAction is a class cluster; each initializer returns an instance of a private subclass that only stores what
+ its style needs. Target-selector style actions keep their target, and look up the method to call once,
+ then again only if the target's class changes. */
 @interface TBAlertAction : NSObject
 
 ///------------------
@@ -45,18 +53,29 @@ typedef NS_ENUM(NSInteger, TBAlertActionStyle) {
 @property (nonatomic                    ) BOOL     enabled;
 /** The title of the action, displayed on the button representing it. */
 @property (nonatomic, readonly, copy    ) NSString *title;
-/** The target of the \c action property. \c nil if it's style is not \c TBAlertActionStyleTarget or \c TBAlertActionStyleTargetObject. */
+/** If set, \c title is replaced by the result of this block the first time it is read, usually
+ when the alert is presented, and the result is kept. Use this when a title is expensive to build
+ and the alert might never be shown. Setting it discards any title it already provided.
+ The provider is called on whichever thread reads \c title first, and outside of any lock. */
+@property (nonatomic, copy, nullable    ) TBAlertStringProvider titleProvider;
+/** The target of the \c action property. \c nil if it's style is not a target-selector style. */
 @property (nonatomic, readonly, nullable) id       target;
-/** The selector called on the \c target property when triggered. \c nil if it's style is not \c TBAlertActionStyleTarget or \c TBAlertActionStyleTargetObject. */
+/** The selector called on the \c target property when triggered. \c nil if it's style is not a target-selector style. */
 @property (nonatomic, readonly, nullable) SEL      action;
 /** The object used when the \c style property is \c TBAlertActionStyleTargetObject. */
 @property (nonatomic, readonly, nullable) id       object;
+/** The arguments used when the \c style property is \c TBAlertActionStyleTargetArguments. */
+@property (nonatomic, readonly, nullable) NSArray  *arguments;
+/** An optional, stable identifier for looking the action up with \c -[TBAlertController buttonWithIdentifier:]. */
+@property (nonatomic, copy, nullable    ) NSString *identifier;
 
 
 ///--------------------
 /// @name Initializers
 ///--------------------
 
+/** Initializes a \c TBAlertAction whose title comes from \c titleProvider and a block to execute when triggered. */
++ (instancetype)actionWithTitleProvider:(TBAlertStringProvider)titleProvider block:(nullable TBAlertActionBlock)block;
 /** Initializes a \c TBAlertAction with the given title. */
 - (id)initWithTitle:(NSString *)title;
 /** Initializes a \c TBAlertAction with the given title and a block to execute when triggered.
@@ -77,6 +96,24 @@ typedef NS_ENUM(NSInteger, TBAlertActionStyle) {
  @param action A selector to perform on the \c target object when the action is triggered.
  @param object An object to pass to \c action. Behavior is undefined for \c nil values. */
 - (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action object:(nullable id)object;
+/** Initializes a \c TBAlertAction with the given title and a target-selector style action which takes any number of parameters.
+ 
+ The method's signature is checked once, here. Object parameters are passed as-is, with \c NSNull standing in for \c nil.
+ Scalar parameters are unboxed from \c NSNumber arguments, and other parameters from \c NSValue arguments of exactly
+ the same type. If \c target doesn't respond to \c action or any argument doesn't fit, this asserts, and in release
+ builds returns an action that does nothing.
+ 
+ @param title The button title
+ @param target The object to perform the \c action selector on when the action is triggered.
+ @param action A selector to perform on the \c target object when the action is triggered. It must take exactly \c arguments.count parameters.
+ @param arguments The arguments to pass to \c action, in order. */
+- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action arguments:(NSArray *)arguments;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Makes the next read of \c title call \c titleProvider again. Does nothing without a \c titleProvider.
+ @see -[TBAlertController invalidateProvidedStrings] */
+- (void)invalidateTitle;
 
 ///-----------------------------
 /// @name Triggering the Action
@@ -7,98 +7,446 @@
 //
 
 #import "TBAlertAction.h"
+#import <objc/runtime.h>
 
-@implementation TBAlertAction
+#pragma mark - Private subclasses
+
+/// Does nothing when performed.
+@interface TBNoAlertAction : TBAlertAction
+@end
+
+/// Calls a block with the text field strings.
+@interface TBBlockAlertAction : TBAlertAction {
+    TBAlertActionBlock _block;
+}
+@end
+
+/// Calls a method taking no parameters on a target.
+@interface TBTargetAlertAction : TBAlertAction {
+    @protected
+    id _target;
+    SEL _action;
+    Class _cachedClass;
+    IMP _cachedIMP;
+}
+/// Does not check \c target or \c action
+- (id)initWithTitle:(NSString *)title validTarget:(id)target action:(SEL)action;
+/// @return The implementation of \c action for \c target, looked up again only if its class has changed, or \c NULL
+- (IMP)implementationForTarget:(id)target;
+@end
+
+/// Calls a method taking a single object on a target.
+@interface TBTargetObjectAlertAction : TBTargetAlertAction {
+    id _object;
+}
+@end
+
+/// Calls a method taking any number of parameters on a target.
+@interface TBTargetArgumentsAlertAction : TBTargetAlertAction {
+    NSArray *_arguments;
+    NSInvocation *_invocation;
+}
+/// \c invocation must already hold \c arguments
+- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action
+          arguments:(NSArray *)arguments invocation:(NSInvocation *)invocation;
+@end
+
+#pragma mark - TBAlertAction
+
+/// Returned by +alloc so that the initializers can return the right subclass without a wasted allocation.
+static TBAlertAction *TBAlertActionPlaceholder = nil;
+
+@implementation TBAlertAction {
+    BOOL _titleProvided;
+}
+
+@synthesize title = _title;
+@synthesize titleProvider = _titleProvider;
+
++ (instancetype)allocWithZone:(NSZone *)zone {
+    if (self == [TBAlertAction class]) {
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            TBAlertActionPlaceholder = [super allocWithZone:zone];
+        });
+
+        return TBAlertActionPlaceholder;
+    }
+
+    return [super allocWithZone:zone];
+}
 
 - (id)initWithTitle:(NSString *)title {
     NSParameterAssert(title);
-    
+
+    if (self == TBAlertActionPlaceholder) {
+        return [[TBNoAlertAction alloc] initWithTitle:title];
+    }
+
     self = [super init];
     if (self) {
         _title   = title;
         _enabled = YES;
-        _style   = TBAlertActionStyleNoAction;
     }
-    
+
     return self;
 }
 
 - (id)initWithTitle:(NSString *)title block:(TBAlertActionBlock)block {
-    self = [self initWithTitle:title];
+    return [[TBBlockAlertAction alloc] initWithTitle:title block:block];
+}
+
++ (instancetype)actionWithTitleProvider:(TBAlertStringProvider)titleProvider block:(TBAlertActionBlock)block {
+    NSParameterAssert(titleProvider);
+
+    TBAlertAction *action = [[self alloc] initWithTitle:@"" block:block];
+    action.titleProvider = titleProvider;
+    return action;
+}
+
+- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action {
+    NSParameterAssert(target); NSParameterAssert(action);
+
+    if (target && action) {
+        return [[TBTargetAlertAction alloc] initWithTitle:title validTarget:target action:action];
+    }
+
+    return [[TBNoAlertAction alloc] initWithTitle:title];
+}
+
+- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action object:(id)object {
+    NSParameterAssert(target); NSParameterAssert(action);
+
+    if (target && action) {
+        return [[TBTargetObjectAlertAction alloc] initWithTitle:title target:target action:action object:object];
+    }
+
+    return [[TBNoAlertAction alloc] initWithTitle:title];
+}
+
+- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action arguments:(NSArray *)arguments {
+    NSParameterAssert(target); NSParameterAssert(action); NSParameterAssert(arguments);
+
+    // Checked for real, not just asserted; a mismatched argument would be copied out of bounds
+    NSInvocation *invocation = target && action && arguments ? TBInvocationWithArguments(target, action, arguments) : nil;
+    if (invocation) {
+        return [[TBTargetArgumentsAlertAction alloc]
+            initWithTitle:title target:target action:action arguments:arguments invocation:invocation
+        ];
+    }
+
+    NSAssert(!(target && action && arguments), @"%@ can't be called on %@ with arguments %@",
+             NSStringFromSelector(action), target, arguments);
+    return [[TBNoAlertAction alloc] initWithTitle:title];
+}
+
+#pragma mark Properties
+
+- (NSString *)title {
+    // Resolved once; presenters read the title of every button each time they diff them.
+    // Alerts are used from any thread, so resolve it like TBAlertController resolves its own title
+    for (;;) {
+        TBAlertStringProvider pending = nil;
+        @synchronized (self) {
+            if (!_titleProvider || _titleProvided) {
+                return _title;
+            }
+            pending = _titleProvider;
+        }
+
+        NSString *result = [pending() copy] ?: @"";
+        @synchronized (self) {
+            // Unless another thread replaced the provider meanwhile
+            if (pending == _titleProvider && !_titleProvided) {
+                _title = result;
+                _titleProvided = YES;
+            }
+        }
+    }
+}
+
+- (TBAlertStringProvider)titleProvider {
+    @synchronized (self) {
+        return _titleProvider;
+    }
+}
+
+- (void)setTitleProvider:(TBAlertStringProvider)titleProvider {
+    titleProvider = [titleProvider copy];
+    @synchronized (self) {
+        _titleProvider = titleProvider;
+        _titleProvided = NO;
+    }
+}
+
+- (void)invalidateTitle {
+    @synchronized (self) {
+        _titleProvided = NO;
+    }
+}
+
+- (TBAlertActionStyle)style {
+    return TBAlertActionStyleNoAction;
+}
+
+- (TBAlertActionBlock)block {
+    return nil;
+}
+
+- (id)target {
+    return nil;
+}
+
+- (SEL)action {
+    return NULL;
+}
+
+- (id)object {
+    return nil;
+}
+
+- (NSArray *)arguments {
+    return nil;
+}
+
+#pragma mark Performing
+
+- (void)perform {
+    [self perform:@[]];
+}
+
+- (void)perform:(NSArray *)textFieldInputStrings {
+    // Nothing to do
+}
+
+@end
+
+#pragma mark - TBNoAlertAction
+
+@implementation TBNoAlertAction
+@end
+
+#pragma mark - TBBlockAlertAction
+
+@implementation TBBlockAlertAction
+
+- (id)initWithTitle:(NSString *)title block:(TBAlertActionBlock)block {
+    self = [super initWithTitle:title];
     if (self) {
-        _block = block ?: ^(id _) { };
-        _style = TBAlertActionStyleBlock;
+        _block = [block copy] ?: ^(id _) { };
     }
-    
+
     return self;
 }
 
-- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action {
-    NSParameterAssert(target); NSParameterAssert(action);
-    self = [self initWithTitle:title];
-    
-    if (self && target && action) {
+- (TBAlertActionStyle)style {
+    return TBAlertActionStyleBlock;
+}
+
+- (TBAlertActionBlock)block {
+    return _block;
+}
+
+- (void)perform:(NSArray *)textFieldInputStrings {
+    _block(textFieldInputStrings ?: @[]);
+}
+
+@end
+
+#pragma mark - TBTargetAlertAction
+
+@implementation TBTargetAlertAction
+
+- (id)initWithTitle:(NSString *)title validTarget:(id)target action:(SEL)action {
+    self = [super initWithTitle:title];
+    if (self) {
         _target = target;
         _action = action;
-        _style = TBAlertActionStyleTarget;
+        [self implementationForTarget:target];
     }
-    
+
     return self;
 }
 
+- (TBAlertActionStyle)style {
+    return TBAlertActionStyleTarget;
+}
+
+- (id)target {
+    return _target;
+}
+
+- (SEL)action {
+    return _action;
+}
+
+- (IMP)implementationForTarget:(id)target {
+    // Re-resolve if the target's class was swapped out from under us, i.e. by KVO
+    Class cls = object_getClass(target);
+    if (cls != _cachedClass) {
+        _cachedClass = cls;
+        _cachedIMP = [target respondsToSelector:_action] ? [target methodForSelector:_action] : NULL;
+    }
+
+    return _cachedIMP;
+}
+
+- (void)perform:(NSArray *)textFieldInputStrings {
+    IMP imp = [self implementationForTarget:_target];
+    if (imp) {
+        ((void (*)(id, SEL))imp)(_target, _action);
+    }
+}
+
+@end
+
+#pragma mark - TBTargetObjectAlertAction
+
+@implementation TBTargetObjectAlertAction
+
 - (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action object:(id)object {
-    self = [self initWithTitle:title target:target action:action];
+    self = [super initWithTitle:title validTarget:target action:action];
     if (self) {
         _object = object;
-        _style  = TBAlertActionStyleTargetObject;
     }
-    
+
     return self;
 }
 
-- (void)perform {
-    [self perform:@[]];
+- (TBAlertActionStyle)style {
+    return TBAlertActionStyleTargetObject;
+}
+
+- (id)object {
+    return _object;
 }
 
 - (void)perform:(NSArray *)textFieldInputStrings {
-    if (!textFieldInputStrings) {
-        textFieldInputStrings = @[];
-    }
-    
-    switch (self.style) {
-        case TBAlertActionStyleNoAction:
-            break;
-            
-        case TBAlertActionStyleBlock: {
-            if (self.block) {
-                self.block(textFieldInputStrings);
-            }
-            
-            break;
-        }
-            
-        case TBAlertActionStyleTarget: {
-            IMP imp = [self.target methodForSelector:self.action];
-            void (*func)(id, SEL) = (void *)imp;
-            
-            if ([self.target respondsToSelector:self.action]) {
-                func(self.target, self.action);
-            }
-            
-            break;
+    IMP imp = [self implementationForTarget:_target];
+    if (imp) {
+        ((void (*)(id, SEL, id))imp)(_target, _action, _object);
+    }
+}
+
+@end
+
+#pragma mark - TBTargetArgumentsAlertAction
+
+#define TBSetScalarArgument(code, type, getter) \
+    case code: { \
+        type value = [argument getter]; \
+        [invocation setArgument:&value atIndex:index]; \
+        return YES; \
+    }
+
+/// Copies the contents of \c value, which must hold exactly \c size bytes, into \c bytes.
+static void TBValueGetBytes(NSValue *value, void *bytes, NSUInteger size) {
+#if __APPLE__
+    if (@available(iOS 11.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+        [value getValue:bytes size:size];
+        return;
+    }
+#endif
+    [value getValue:bytes];
+}
+
+/// Sets an argument of \c invocation, unboxing \c argument if the parameter isn't an object.
+/// @return \c NO, leaving the argument unset, if \c argument can't be passed for the parameter.
+static BOOL TBInvocationSetArgument(NSInvocation *invocation, id argument, NSUInteger index) {
+    const char *type = [invocation.methodSignature getArgumentTypeAtIndex:index];
+
+    // Skip qualifiers like const, in, out
+    while (*type && strchr("rnNoORV", *type)) {
+        type++;
+    }
+
+    if (*type == '@' || *type == '#') {
+        id object = argument == [NSNull null] ? nil : argument;
+        [invocation setArgument:&object atIndex:index];
+        return YES;
+    }
+
+    if ([argument isKindOfClass:[NSNumber class]]) {
+        switch (*type) {
+            TBSetScalarArgument('c', char, charValue)
+            TBSetScalarArgument('C', unsigned char, unsignedCharValue)
+            TBSetScalarArgument('s', short, shortValue)
+            TBSetScalarArgument('S', unsigned short, unsignedShortValue)
+            TBSetScalarArgument('i', int, intValue)
+            TBSetScalarArgument('I', unsigned int, unsignedIntValue)
+            TBSetScalarArgument('l', long, longValue)
+            TBSetScalarArgument('L', unsigned long, unsignedLongValue)
+            TBSetScalarArgument('q', long long, longLongValue)
+            TBSetScalarArgument('Q', unsigned long long, unsignedLongLongValue)
+            TBSetScalarArgument('f', float, floatValue)
+            TBSetScalarArgument('d', double, doubleValue)
+            TBSetScalarArgument('B', bool, boolValue)
+            default:
+                return NO;
         }
-            
-        case TBAlertActionStyleTargetObject: {
-            IMP imp = [self.target methodForSelector:self.action];
-            void (*func)(id, SEL, id) = (void *)imp;
-            
-            if ([self.target respondsToSelector:self.action]) {
-                func(self.target, self.action, self.object);
-            }
-            
-            break;
+    }
+
+    // The value must hold exactly the parameter's type, or copying it out would overrun the buffer
+    if (![argument isKindOfClass:[NSValue class]] || strcmp([argument objCType], type) != 0) {
+        return NO;
+    }
+
+    NSUInteger size = 0;
+    NSGetSizeAndAlignment(type, &size, NULL);
+    NSMutableData *buffer = [NSMutableData dataWithLength:size];
+    TBValueGetBytes(argument, buffer.mutableBytes, size);
+    [invocation setArgument:buffer.mutableBytes atIndex:index];
+    return YES;
+}
+
+/// @return An invocation of \c action with \c arguments and no target, or \c nil if \c target
+/// doesn't respond to \c action or \c arguments don't fit its parameters.
+static NSInvocation *TBInvocationWithArguments(id target, SEL action, NSArray *arguments) {
+    NSMethodSignature *signature = [target methodSignatureForSelector:action];
+    if (!signature || signature.numberOfArguments != arguments.count + 2) {
+        return nil;
+    }
+
+    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:signature];
+    invocation.selector = action;
+    for (NSUInteger i = 0; i < arguments.count; i++) {
+        if (!TBInvocationSetArgument(invocation, arguments[i], i + 2)) {
+            return nil;
         }
     }
+
+    [invocation retainArguments];
+    return invocation;
+}
+
+#undef TBSetScalarArgument
+
+@implementation TBTargetArgumentsAlertAction
+
+- (id)initWithTitle:(NSString *)title target:(id)target action:(SEL)action
+          arguments:(NSArray *)arguments invocation:(NSInvocation *)invocation {
+    self = [super initWithTitle:title validTarget:target action:action];
+    if (self) {
+        // Built once; only the target changes between calls
+        _arguments = arguments.copy;
+        _invocation = invocation;
+    }
+
+    return self;
+}
+
+- (TBAlertActionStyle)style {
+    return TBAlertActionStyleTargetArguments;
+}
+
+- (NSArray *)arguments {
+    return _arguments;
+}
+
+- (void)perform:(NSArray *)textFieldInputStrings {
+    if ([self implementationForTarget:_target]) {
+        [_invocation invokeWithTarget:_target];
+    }
 }
 
 @end
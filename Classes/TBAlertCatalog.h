@@ -0,0 +1,97 @@
+//
+//  TBAlertCatalog.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertTemplate.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Errors from compiling or opening a \c TBAlertCatalog use this domain. */
+extern NSString * const TBAlertCatalogErrorDomain;
+
+typedef NS_ENUM(NSInteger, TBAlertCatalogErrorCode) {
+    /** A spec is missing its identifier, has a value of the wrong type, or describes an alert that can't exist. */
+    TBAlertCatalogErrorInvalidSpec = 1,
+    /** Two specs have the same identifier. */
+    TBAlertCatalogErrorDuplicateIdentifier,
+    /** A file isn't a compiled catalog, or was compiled by an incompatible version. */
+    TBAlertCatalogErrorInvalidCatalog,
+};
+
+/** Alerts described by data instead of code, compiled ahead of time into one compact file.
+
+ Each alert is described by a spec, a JSON object such as:
+
+ \code
+ {
+     "identifier": "upload.failed",
+     "style": "alert",
+     "title": "Upload failed",
+     "message": "{count} files could not be uploaded.",
+     "buttons": [
+         "Retry",
+         { "title": "Delete", "role": "destructive" },
+         { "title": "Cancel", "role": "cancel" }
+     ],
+     "textFields": [
+         { "identifier": "password", "placeholder": "Password", "secure": true }
+     ]
+ }
+ \endcode
+
+ Only \c identifier is required. \c style is \c "alert" or \c "sheet". A button is a title, or an object
+ with a \c title, a \c role of \c "default", \c "cancel", or \c "destructive", and \c enabled; at most one
+ button may cancel, and at most one may be destructive. Text fields are only allowed in alerts.
+ Strings may contain \c TBAlertTemplate placeholders.
+
+ Opening a catalog maps the file into memory and reads nothing else, so it costs the same with ten
+ alerts or ten thousand. Each alert is decoded the first time it's asked for and kept as a
+ \c TBAlertTemplate; strings shared by several alerts are decoded once and shared.
+ Catalogs are safe to use from any thread. */
+@interface TBAlertCatalog : NSObject
+
+/** Maps a catalog written by \c compileSpecsInDirectory:toFile:error: into memory. */
++ (nullable instancetype)catalogWithContentsOfFile:(NSString *)path error:(NSError **)error;
+/** Reads a catalog from memory, such as one returned by \c compileSpecs:error:. */
++ (nullable instancetype)catalogWithData:(NSData *)data error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** The number of alerts in the catalog. */
+@property (nonatomic, readonly) NSUInteger count;
+/** Every alert's identifier, sorted. Unlike everything else, this reads the whole catalog. */
+@property (nonatomic, readonly) NSArray<NSString *> *identifiers;
+
+/** @return A template for the alert with the given identifier, or \c nil if there isn't one.
+ The same template is returned every time. */
+- (nullable TBAlertTemplate *)templateWithIdentifier:(NSString *)identifier;
+
+/** @return A new alert controller for the alert with the given identifier, or \c nil if there isn't one.
+ Alert controllers from a catalog have the same \c identifier. Its buttons have no actions; see \c alertControllerWithIdentifier:parameters:handlers:. */
+- (nullable TBAlertController *)alertControllerWithIdentifier:(NSString *)identifier;
+/** @return A new alert controller for the alert with the given identifier, or \c nil if there isn't one.
+ @see -[TBAlertTemplate alertControllerWithParameters:handlers:] */
+- (nullable TBAlertController *)alertControllerWithIdentifier:(NSString *)identifier
+                                                   parameters:(nullable NSDictionary<NSString *, id> *)parameters
+                                                     handlers:(nullable NSDictionary<NSString *, TBAlertActionBlock> *)handlers;
+
+///---------------
+/// @name Compiling
+///---------------
+
+/** Compiles specs into a catalog.
+ @return The compiled catalog, or \c nil if any spec is invalid or two share an identifier. */
++ (nullable NSData *)compileSpecs:(NSArray<NSDictionary<NSString *, id> *> *)specs error:(NSError **)error;
+
+/** Compiles every \c .json file in \c directory into one catalog at \c path.
+ Each file holds a single spec or an array of them.
+ @return \c NO if any file can't be read or any spec is invalid; the error says which. */
++ (BOOL)compileSpecsInDirectory:(NSString *)directory toFile:(NSString *)path error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
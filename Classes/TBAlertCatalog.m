@@ -0,0 +1,411 @@
+//
+//  TBAlertCatalog.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertCatalog.h"
+#import "TBAlertCatalogFormat.h"
+
+NSString * const TBAlertCatalogErrorDomain = @"TBAlertCatalogErrorDomain";
+
+static NSError *TBAlertCatalogError(TBAlertCatalogErrorCode code, NSString *format, ...) NS_FORMAT_FUNCTION(2, 3);
+static NSError *TBAlertCatalogError(TBAlertCatalogErrorCode code, NSString *format, ...) {
+    va_list args;
+    va_start(args, format);
+    NSString *description = [[NSString alloc] initWithFormat:format arguments:args];
+    va_end(args);
+
+    return [NSError errorWithDomain:TBAlertCatalogErrorDomain code:code userInfo:@{
+        NSLocalizedDescriptionKey: description
+    }];
+}
+
+@implementation TBAlertCatalog {
+    TBAlertCatalogFile _file;
+    /// Keeps the bytes of catalogs read from memory alive
+    NSData *_data;
+    /// Guarded by \c self
+    NSMutableDictionary<NSString *, TBAlertTemplate *> *_templates;
+    /// String table index to decoded string; guarded by \c self
+    NSMutableDictionary<NSNumber *, NSString *> *_strings;
+}
+
+#pragma mark - Opening
+
+- (instancetype)initWithFile:(TBAlertCatalogFile)file data:(NSData *)data {
+    self = [super init];
+    if (self) {
+        _file = file;
+        _data = data;
+        _templates = [NSMutableDictionary new];
+        _strings = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
++ (instancetype)catalogWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    TBAlertCatalogFile file;
+    if (!TBAlertCatalogFileOpen(path.fileSystemRepresentation, &file)) {
+        if (error) {
+            *error = TBAlertCatalogError(TBAlertCatalogErrorInvalidCatalog, @"%@ is not an alert catalog", path);
+        }
+        return nil;
+    }
+
+    return [[self alloc] initWithFile:file data:nil];
+}
+
++ (instancetype)catalogWithData:(NSData *)data error:(NSError **)error {
+    NSParameterAssert(data);
+
+    // Our copy can't change out from under us
+    data = data.copy;
+    TBAlertCatalogFile file;
+    if (!TBAlertCatalogFileInit(data.bytes, data.length, &file)) {
+        if (error) {
+            *error = TBAlertCatalogError(TBAlertCatalogErrorInvalidCatalog, @"The data is not an alert catalog");
+        }
+        return nil;
+    }
+
+    return [[self alloc] initWithFile:file data:data];
+}
+
+- (void)dealloc {
+    TBAlertCatalogFileClose(&_file);
+}
+
+#pragma mark - Reading
+
+- (NSUInteger)count {
+    return _file.entryCount;
+}
+
+- (NSArray<NSString *> *)identifiers {
+    NSMutableArray *identifiers = [NSMutableArray arrayWithCapacity:_file.entryCount];
+    @synchronized (self) {
+        for (uint32_t i = 0; i < _file.entryCount; i++) {
+            TBAlertCatalogEntry entry;
+            NSString *identifier = nil;
+            if (TBAlertCatalogFileEntryAtIndex(&_file, i, &entry) && (identifier = [self stringAtIndex:entry.identifier])) {
+                [identifiers addObject:identifier];
+            }
+        }
+    }
+
+    return identifiers;
+}
+
+/// Call while synchronized on \c self
+/// @return \c nil for \c TBAlertCatalogNoString or a malformed string
+- (NSString *)stringAtIndex:(uint32_t)index {
+    NSNumber *key = @(index);
+    NSString *string = _strings[key];
+    if (!string) {
+        const char *bytes = TBAlertCatalogFileString(&_file, index, NULL);
+        string = bytes ? @(bytes) : nil;
+        if (string) {
+            _strings[key] = string;
+        }
+    }
+
+    return string;
+}
+
+/// Call while synchronized on \c self
+- (TBAlertController *)decodeEntry:(const TBAlertCatalogEntry *)entry {
+    TBAlertController *alert = [TBAlertController
+        alertControllerWithTitle:[self stringAtIndex:entry->title]
+        message:[self stringAtIndex:entry->message]
+        preferredStyle:entry->style == TBAlertCatalogStyleSheet ? UIAlertControllerStyleActionSheet : UIAlertControllerStyleAlert
+    ];
+
+    // The compiler only allows one cancel button, and it always goes last
+    NSInteger otherButtons = 0;
+    for (size_t i = 0; i < entry->buttonCount; i++) {
+        TBAlertCatalogButton button = TBAlertCatalogEntryButton(entry, i);
+        TBAlertAction *action = [[TBAlertAction alloc] initWithTitle:[self stringAtIndex:button.title] ?: @""];
+        action.enabled = button.enabled;
+
+        switch (button.role) {
+            case TBAlertCatalogButtonRoleDefault:
+                [alert addAction:action];
+                otherButtons++;
+                break;
+            case TBAlertCatalogButtonRoleCancel:
+                [alert setCancelButton:action];
+                break;
+            case TBAlertCatalogButtonRoleDestructive:
+                [alert addAction:action];
+                alert.destructiveButtonIndex = otherButtons++;
+                break;
+        }
+    }
+
+    for (size_t i = 0; i < entry->textFieldCount; i++) {
+        TBAlertCatalogTextField textField = TBAlertCatalogEntryTextField(entry, i);
+        NSString *placeholder = [self stringAtIndex:textField.placeholder];
+        BOOL secure = textField.secure;
+        [alert addTextFieldWithIdentifier:[self stringAtIndex:textField.identifier]
+                     configurationHandler:^(UITextField *field) {
+            field.placeholder = placeholder;
+            field.secureTextEntry = secure;
+        }];
+    }
+
+    return alert;
+}
+
+- (TBAlertTemplate *)templateWithIdentifier:(NSString *)identifier {
+    NSParameterAssert(identifier);
+
+    @synchronized (self) {
+        TBAlertTemplate *template = _templates[identifier];
+        if (template) {
+            return template;
+        }
+
+        const char *bytes = identifier.UTF8String;
+        TBAlertCatalogEntry entry;
+        if (!bytes || !TBAlertCatalogFileFindEntry(&_file, bytes, strlen(bytes), &entry)) {
+            return nil;
+        }
+
+        // Sheets can't have text fields; only a corrupt catalog would have both
+        if (entry.style == TBAlertCatalogStyleSheet && entry.textFieldCount) {
+            return nil;
+        }
+
+        template = [[TBAlertTemplate alloc] initWithAlertController:[self decodeEntry:&entry]];
+        _templates[identifier] = template;
+        return template;
+    }
+}
+
+- (TBAlertController *)alertControllerWithIdentifier:(NSString *)identifier {
+    TBAlertController *alert = [[self templateWithIdentifier:identifier] alertController];
+    alert.identifier = identifier;
+    return alert;
+}
+
+- (TBAlertController *)alertControllerWithIdentifier:(NSString *)identifier
+                                          parameters:(NSDictionary<NSString *, id> *)parameters
+                                            handlers:(NSDictionary<NSString *, TBAlertActionBlock> *)handlers {
+    TBAlertController *alert = [[self templateWithIdentifier:identifier] alertControllerWithParameters:parameters handlers:handlers];
+    alert.identifier = identifier;
+    return alert;
+}
+
+#pragma mark - Compiling
+
+/// @return \c YES if \c value is absent or a string, which is stored in \c string
+static BOOL TBSpecString(NSDictionary *spec, NSString *key, NSString **string) {
+    id value = spec[key];
+    if (value && ![value isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+    *string = value;
+    return YES;
+}
+
+/// @return \c YES if \c value is absent or a boolean, which is stored in \c flag
+static BOOL TBSpecBool(NSDictionary *spec, NSString *key, BOOL defaultValue, BOOL *flag) {
+    id value = spec[key];
+    if (value && ![value isKindOfClass:[NSNumber class]]) {
+        return NO;
+    }
+    *flag = value ? [value boolValue] : defaultValue;
+    return YES;
+}
+
+/// Adds one spec to \c writer. The C strings it passes along live as long as the current autorelease pool.
+static BOOL TBAlertCatalogAddSpec(TBAlertCatalogWriter *writer, id spec, NSString *source, NSError **error) {
+    #define TBSpecFail(code, ...) do { \
+        if (error) *error = TBAlertCatalogError(code, __VA_ARGS__); \
+        return NO; \
+    } while (0)
+
+    if (![spec isKindOfClass:[NSDictionary class]]) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: each spec must be an object", source);
+    }
+
+    NSString *identifier = nil, *title = nil, *message = nil, *style = nil;
+    if (!TBSpecString(spec, @"identifier", &identifier) || !identifier.length) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: a spec is missing its identifier", source);
+    }
+    if (!TBSpecString(spec, @"title", &title) || !TBSpecString(spec, @"message", &message) ||
+        !TBSpecString(spec, @"style", &style)) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: title, message, and style must be strings", source, identifier);
+    }
+
+    TBAlertCatalogStyle catalogStyle = TBAlertCatalogStyleAlert;
+    if ([style isEqualToString:@"sheet"]) {
+        catalogStyle = TBAlertCatalogStyleSheet;
+    } else if (style && ![style isEqualToString:@"alert"]) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: unknown style \"%@\"", source, identifier, style);
+    }
+
+    NSArray *buttons = spec[@"buttons"] ?: @[];
+    NSArray *textFields = spec[@"textFields"] ?: @[];
+    if (![buttons isKindOfClass:[NSArray class]] || ![textFields isKindOfClass:[NSArray class]]) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: buttons and textFields must be arrays", source, identifier);
+    }
+    if (buttons.count > UINT8_MAX || textFields.count > UINT8_MAX) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: too many buttons or text fields", source, identifier);
+    }
+    if (catalogStyle == TBAlertCatalogStyleSheet && textFields.count) {
+        TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: action sheets can't have text fields", source, identifier);
+    }
+
+    NSMutableData *buttonSpecs = [NSMutableData dataWithLength:buttons.count * sizeof(TBAlertCatalogButtonSpec)];
+    TBAlertCatalogButtonSpec *buttonSpec = buttonSpecs.mutableBytes;
+    BOOL hasCancel = NO, hasDestructive = NO;
+    for (id button in buttons) {
+        NSDictionary *buttonDict = [button isKindOfClass:[NSString class]] ? @{ @"title": button } : button;
+        NSString *buttonTitle = nil, *role = nil;
+        BOOL enabled = YES;
+        if (![buttonDict isKindOfClass:[NSDictionary class]] || !TBSpecString(buttonDict, @"title", &buttonTitle) ||
+            !buttonTitle || !TBSpecString(buttonDict, @"role", &role) || !TBSpecBool(buttonDict, @"enabled", YES, &enabled)) {
+            TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: each button needs a title", source, identifier);
+        }
+
+        TBAlertCatalogButtonRole buttonRole = TBAlertCatalogButtonRoleDefault;
+        if ([role isEqualToString:@"cancel"]) {
+            if (hasCancel) {
+                TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: only one button can cancel", source, identifier);
+            }
+            hasCancel = YES;
+            buttonRole = TBAlertCatalogButtonRoleCancel;
+        } else if ([role isEqualToString:@"destructive"]) {
+            // An alert has one destructiveButtonIndex; a second would silently replace the first
+            if (hasDestructive) {
+                TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: only one button can be destructive", source, identifier);
+            }
+            hasDestructive = YES;
+            buttonRole = TBAlertCatalogButtonRoleDestructive;
+        } else if (role && ![role isEqualToString:@"default"]) {
+            TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: unknown button role \"%@\"", source, identifier, role);
+        }
+
+        *buttonSpec++ = (TBAlertCatalogButtonSpec){ buttonTitle.UTF8String, buttonRole, enabled };
+    }
+
+    NSMutableData *textFieldSpecs = [NSMutableData dataWithLength:textFields.count * sizeof(TBAlertCatalogTextFieldSpec)];
+    TBAlertCatalogTextFieldSpec *textFieldSpec = textFieldSpecs.mutableBytes;
+    for (NSDictionary *textField in textFields) {
+        NSString *textFieldIdentifier = nil, *placeholder = nil;
+        BOOL secure = NO;
+        if (![textField isKindOfClass:[NSDictionary class]] || !TBSpecString(textField, @"identifier", &textFieldIdentifier) ||
+            !TBSpecString(textField, @"placeholder", &placeholder) || !TBSpecBool(textField, @"secure", NO, &secure)) {
+            TBSpecFail(TBAlertCatalogErrorInvalidSpec, @"%@: %@: each text field must be an object", source, identifier);
+        }
+
+        *textFieldSpec++ = (TBAlertCatalogTextFieldSpec){ textFieldIdentifier.UTF8String, placeholder.UTF8String, secure };
+    }
+
+    TBAlertCatalogEntrySpec entry = {
+        .identifier = identifier.UTF8String,
+        .title = title.UTF8String,
+        .message = message.UTF8String,
+        .style = catalogStyle,
+        .buttons = buttonSpecs.bytes,
+        .buttonCount = buttons.count,
+        .textFields = textFieldSpecs.bytes,
+        .textFieldCount = textFields.count,
+    };
+
+    if (!TBAlertCatalogWriterAddEntry(writer, &entry)) {
+        TBSpecFail(TBAlertCatalogErrorDuplicateIdentifier, @"%@: %@: identifier is already used", source, identifier);
+    }
+
+    return YES;
+    #undef TBSpecFail
+}
+
+/// @return The compiled catalog, or \c nil if \c writer can't be laid out
+static NSData *TBAlertCatalogFinish(TBAlertCatalogWriter *writer, NSError **error) {
+    uint8_t *bytes = NULL;
+    size_t length = 0;
+    if (!TBAlertCatalogWriterFinish(writer, &bytes, &length)) {
+        if (error) {
+            *error = TBAlertCatalogError(TBAlertCatalogErrorInvalidCatalog, @"The catalog is too large");
+        }
+        return nil;
+    }
+
+    return [NSData dataWithBytesNoCopy:bytes length:length freeWhenDone:YES];
+}
+
++ (NSData *)compileSpecs:(NSArray<NSDictionary<NSString *, id> *> *)specs error:(NSError **)error {
+    NSParameterAssert(specs);
+
+    TBAlertCatalogWriter *writer = TBAlertCatalogWriterCreate();
+    NSError *failure = nil;
+    BOOL added = YES;
+    for (NSUInteger i = 0; added && i < specs.count; i++) {
+        @autoreleasepool {
+            NSString *source = [NSString stringWithFormat:@"spec %lu", (unsigned long)i];
+            added = TBAlertCatalogAddSpec(writer, specs[i], source, &failure);
+        }
+    }
+
+    NSData *catalog = added ? TBAlertCatalogFinish(writer, &failure) : nil;
+    TBAlertCatalogWriterFree(writer);
+
+    if (!catalog && error) {
+        *error = failure;
+    }
+    return catalog;
+}
+
++ (BOOL)compileSpecsInDirectory:(NSString *)directory toFile:(NSString *)path error:(NSError **)error {
+    NSArray *contents = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:directory error:error];
+    if (!contents) {
+        return NO;
+    }
+
+    // Sorted, so that the same specs always compile to the same bytes
+    NSArray *fileNames = [[contents filteredArrayUsingPredicate:
+        [NSPredicate predicateWithFormat:@"pathExtension == 'json'"]
+    ] sortedArrayUsingSelector:@selector(compare:)];
+
+    TBAlertCatalogWriter *writer = TBAlertCatalogWriterCreate();
+    NSError *failure = nil;
+    BOOL added = YES;
+    for (NSString *fileName in fileNames) {
+        @autoreleasepool {
+            NSString *filePath = [directory stringByAppendingPathComponent:fileName];
+            NSData *json = [NSData dataWithContentsOfFile:filePath options:0 error:&failure];
+            id specs = json ? [NSJSONSerialization JSONObjectWithData:json options:0 error:&failure] : nil;
+            if (!specs) {
+                added = NO;
+                break;
+            }
+
+            for (id spec in [specs isKindOfClass:[NSArray class]] ? specs : @[specs]) {
+                if (!TBAlertCatalogAddSpec(writer, spec, fileName, &failure)) {
+                    added = NO;
+                    break;
+                }
+            }
+            if (!added) {
+                break;
+            }
+        }
+    }
+
+    NSData *catalog = added ? TBAlertCatalogFinish(writer, &failure) : nil;
+    TBAlertCatalogWriterFree(writer);
+
+    BOOL written = catalog && [catalog writeToFile:path options:NSDataWritingAtomic error:&failure];
+    if (!written && error) {
+        *error = failure;
+    }
+    return written;
+}
+
+@end
@@ -0,0 +1,522 @@
+//
+//  TBAlertCatalogFormat.c
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#include "TBAlertCatalogFormat.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char TBAlertCatalogMagic[4] = { 'T', 'B', 'A', 'C' };
+static const uint16_t TBAlertCatalogVersion = 1;
+
+// Sizes of the records on disk
+enum {
+    TBAlertCatalogHeaderSize = 32,
+    TBAlertCatalogEntrySize = 20,
+    TBAlertCatalogButtonSize = 8,
+    TBAlertCatalogTextFieldSize = 12,
+};
+
+enum {
+    TBAlertCatalogButtonEnabled = 1 << 0,
+    TBAlertCatalogTextFieldSecure = 1 << 0,
+};
+
+static inline uint16_t TBRead16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint32_t TBRead32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline void TBWrite16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static inline void TBWrite32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/** @return \c true if \c count records of \c size bytes starting at \c offset fit in \c length bytes. */
+static inline bool TBRangeFits(size_t offset, size_t count, size_t size, size_t length) {
+    return offset <= length && count <= (length - offset) / size;
+}
+
+// Reading
+
+bool TBAlertCatalogFileInit(const void *bytes, size_t length, TBAlertCatalogFile *catalog) {
+    memset(catalog, 0, sizeof(*catalog));
+    const uint8_t *header = bytes;
+    if (!bytes || length < TBAlertCatalogHeaderSize ||
+        memcmp(header, TBAlertCatalogMagic, sizeof(TBAlertCatalogMagic)) != 0 ||
+        TBRead16(header + 4) != TBAlertCatalogVersion ||
+        TBRead16(header + 6) < TBAlertCatalogHeaderSize) {
+        return false;
+    }
+
+    uint32_t entryCount = TBRead32(header + 8);
+    uint32_t stringCount = TBRead32(header + 12);
+    uint32_t entriesOffset = TBRead32(header + 16);
+    uint32_t stringOffsetsOffset = TBRead32(header + 20);
+    uint32_t stringsOffset = TBRead32(header + 24);
+    uint32_t stringsLength = TBRead32(header + 28);
+
+    if (!TBRangeFits(entriesOffset, entryCount, TBAlertCatalogEntrySize, length) ||
+        !TBRangeFits(stringOffsetsOffset, (size_t)stringCount + 1, sizeof(uint32_t), length) ||
+        !TBRangeFits(stringsOffset, stringsLength, 1, length)) {
+        return false;
+    }
+
+    catalog->bytes = bytes;
+    catalog->length = length;
+    catalog->entryCount = entryCount;
+    catalog->stringCount = stringCount;
+    catalog->entries = header + entriesOffset;
+    catalog->stringOffsets = header + stringOffsetsOffset;
+    catalog->strings = header + stringsOffset;
+    catalog->stringsLength = stringsLength;
+    return true;
+}
+
+bool TBAlertCatalogFileOpen(const char *path, TBAlertCatalogFile *catalog) {
+    memset(catalog, 0, sizeof(*catalog));
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size < TBAlertCatalogHeaderSize) {
+        close(descriptor);
+        return false;
+    }
+
+    // Pages are only read in as entries are looked up
+    size_t length = (size_t)info.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    if (!TBAlertCatalogFileInit(mapping, length, catalog)) {
+        munmap(mapping, length);
+        return false;
+    }
+
+    catalog->mapping = mapping;
+    return true;
+}
+
+void TBAlertCatalogFileClose(TBAlertCatalogFile *catalog) {
+    if (catalog->mapping) {
+        munmap(catalog->mapping, catalog->length);
+    }
+    memset(catalog, 0, sizeof(*catalog));
+}
+
+const char *TBAlertCatalogFileString(const TBAlertCatalogFile *catalog, uint32_t index, size_t *length) {
+    if (index >= catalog->stringCount) {
+        return NULL;
+    }
+
+    // Each string ends with a NUL, right where the next one starts
+    uint32_t start = TBRead32(catalog->stringOffsets + (size_t)index * 4);
+    uint32_t end = TBRead32(catalog->stringOffsets + (size_t)index * 4 + 4);
+    if (start >= end || end > catalog->stringsLength || catalog->strings[end - 1] != '\0') {
+        return NULL;
+    }
+
+    if (length) {
+        *length = end - start - 1;
+    }
+    return (const char *)catalog->strings + start;
+}
+
+static inline bool TBStringIndexIsValid(const TBAlertCatalogFile *catalog, uint32_t index) {
+    return index == TBAlertCatalogNoString || index < catalog->stringCount;
+}
+
+bool TBAlertCatalogFileEntryAtIndex(const TBAlertCatalogFile *catalog, uint32_t index, TBAlertCatalogEntry *entry) {
+    if (index >= catalog->entryCount) {
+        return false;
+    }
+
+    const uint8_t *record = catalog->entries + (size_t)index * TBAlertCatalogEntrySize;
+    uint32_t itemsOffset = TBRead32(record + 12);
+    uint8_t style = record[16];
+    size_t buttonCount = record[17];
+    size_t textFieldCount = record[18];
+    size_t itemsLength = buttonCount * TBAlertCatalogButtonSize + textFieldCount * TBAlertCatalogTextFieldSize;
+
+    TBAlertCatalogEntry decoded = {
+        .identifier = TBRead32(record),
+        .title = TBRead32(record + 4),
+        .message = TBRead32(record + 8),
+        .style = (TBAlertCatalogStyle)style,
+        .buttonCount = buttonCount,
+        .textFieldCount = textFieldCount,
+        .items = catalog->bytes + itemsOffset,
+    };
+
+    if (decoded.identifier >= catalog->stringCount ||
+        !TBStringIndexIsValid(catalog, decoded.title) ||
+        !TBStringIndexIsValid(catalog, decoded.message) ||
+        style > TBAlertCatalogStyleSheet ||
+        !TBRangeFits(itemsOffset, itemsLength, 1, catalog->length)) {
+        return false;
+    }
+
+    *entry = decoded;
+    return true;
+}
+
+bool TBAlertCatalogFileFindEntry(const TBAlertCatalogFile *catalog,
+                                 const char *identifier, size_t length,
+                                 TBAlertCatalogEntry *entry) {
+    uint32_t low = 0, high = catalog->entryCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        const uint8_t *record = catalog->entries + (size_t)mid * TBAlertCatalogEntrySize;
+
+        size_t candidateLength;
+        const char *candidate = TBAlertCatalogFileString(catalog, TBRead32(record), &candidateLength);
+        if (!candidate) {
+            return false;
+        }
+
+        // Byte order, shorter first on a tie; the same order the writer sorts in
+        int order = memcmp(candidate, identifier, candidateLength < length ? candidateLength : length);
+        if (order == 0) {
+            order = (candidateLength > length) - (candidateLength < length);
+        }
+
+        if (order == 0) {
+            return TBAlertCatalogFileEntryAtIndex(catalog, mid, entry);
+        }
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
+TBAlertCatalogButton TBAlertCatalogEntryButton(const TBAlertCatalogEntry *entry, size_t index) {
+    const uint8_t *record = entry->items + index * TBAlertCatalogButtonSize;
+    uint8_t role = record[4];
+    return (TBAlertCatalogButton){
+        .title = TBRead32(record),
+        .role = role <= TBAlertCatalogButtonRoleDestructive ? (TBAlertCatalogButtonRole)role : TBAlertCatalogButtonRoleDefault,
+        .enabled = (record[5] & TBAlertCatalogButtonEnabled) != 0,
+    };
+}
+
+TBAlertCatalogTextField TBAlertCatalogEntryTextField(const TBAlertCatalogEntry *entry, size_t index) {
+    const uint8_t *record = entry->items + entry->buttonCount * TBAlertCatalogButtonSize
+                            + index * TBAlertCatalogTextFieldSize;
+    return (TBAlertCatalogTextField){
+        .identifier = TBRead32(record),
+        .placeholder = TBRead32(record + 4),
+        .secure = (record[8] & TBAlertCatalogTextFieldSecure) != 0,
+    };
+}
+
+// Writing
+
+typedef struct TBWriterEntry {
+    uint32_t identifier;
+    uint32_t title;
+    uint32_t message;
+    TBAlertCatalogStyle style;
+    uint8_t buttonCount;
+    uint8_t textFieldCount;
+    /** Where this entry's items start in the writer's item buffer */
+    size_t itemsOffset;
+} TBWriterEntry;
+
+struct TBAlertCatalogWriter {
+    /** Every distinct string, each followed by its NUL */
+    uint8_t *strings;
+    size_t stringsLength, stringsCapacity;
+    uint32_t *stringOffsets;
+    /** Whether each string is already some entry's identifier */
+    bool *isIdentifier;
+    uint32_t stringCount, stringCapacity;
+
+    /** Open addressing; each slot holds a string index plus one, or zero if empty */
+    uint32_t *slots;
+    uint32_t slotCount;
+
+    TBWriterEntry *entries;
+    uint32_t entryCount, entryCapacity;
+
+    /** The encoded buttons and text fields of every entry */
+    uint8_t *items;
+    size_t itemsLength, itemsCapacity;
+};
+
+static bool TBGrow(void **buffer, size_t elementSize, size_t needed, size_t *capacity) {
+    if (needed <= *capacity) {
+        return true;
+    }
+
+    size_t grown = *capacity ? *capacity : 64;
+    while (grown < needed) {
+        grown *= 2;
+    }
+
+    void *resized = realloc(*buffer, grown * elementSize);
+    if (!resized) {
+        return false;
+    }
+    *buffer = resized;
+    *capacity = grown;
+    return true;
+}
+
+/** FNV-1a; interning only needs to spread short strings well */
+static uint32_t TBStringHash(const char *string, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)string[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool TBWriterRehash(TBAlertCatalogWriter *writer, uint32_t slotCount) {
+    uint32_t *slots = calloc(slotCount, sizeof(uint32_t));
+    if (!slots) {
+        return false;
+    }
+
+    for (uint32_t index = 0; index < writer->stringCount; index++) {
+        const char *string = (const char *)writer->strings + writer->stringOffsets[index];
+        uint32_t slot = TBStringHash(string, strlen(string)) & (slotCount - 1);
+        while (slots[slot]) {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        slots[slot] = index + 1;
+    }
+
+    free(writer->slots);
+    writer->slots = slots;
+    writer->slotCount = slotCount;
+    return true;
+}
+
+/** @return The index of \c string, adding it if it's new; \c TBAlertCatalogNoString if \c string is \c NULL.
+ @param ok Set to \c false if memory could not be allocated. */
+static uint32_t TBWriterIntern(TBAlertCatalogWriter *writer, const char *string, bool *ok) {
+    if (!string || !*ok) {
+        return TBAlertCatalogNoString;
+    }
+
+    // Keep the table at most half full
+    if ((writer->stringCount + 1) * 2 > writer->slotCount &&
+        !TBWriterRehash(writer, writer->slotCount ? writer->slotCount * 2 : 256)) {
+        *ok = false;
+        return TBAlertCatalogNoString;
+    }
+
+    size_t length = strlen(string);
+    uint32_t slot = TBStringHash(string, length) & (writer->slotCount - 1);
+    while (writer->slots[slot]) {
+        uint32_t index = writer->slots[slot] - 1;
+        if (strcmp((const char *)writer->strings + writer->stringOffsets[index], string) == 0) {
+            return index;
+        }
+        slot = (slot + 1) & (writer->slotCount - 1);
+    }
+
+    size_t stringCapacity = writer->stringCapacity;
+    if (writer->stringCount == TBAlertCatalogNoString - 1 ||
+        !TBGrow((void **)&writer->strings, 1, writer->stringsLength + length + 1, &writer->stringsCapacity) ||
+        !TBGrow((void **)&writer->stringOffsets, sizeof(uint32_t), writer->stringCount + 1, &stringCapacity)) {
+        *ok = false;
+        return TBAlertCatalogNoString;
+    }
+
+    // Both arrays are indexed by string, so they grow together
+    if (stringCapacity != writer->stringCapacity) {
+        bool *isIdentifier = realloc(writer->isIdentifier, stringCapacity * sizeof(bool));
+        if (!isIdentifier) {
+            *ok = false;
+            return TBAlertCatalogNoString;
+        }
+        writer->isIdentifier = isIdentifier;
+        writer->stringCapacity = (uint32_t)stringCapacity;
+    }
+
+    uint32_t index = writer->stringCount++;
+    writer->stringOffsets[index] = (uint32_t)writer->stringsLength;
+    writer->isIdentifier[index] = false;
+    memcpy(writer->strings + writer->stringsLength, string, length + 1);
+    writer->stringsLength += length + 1;
+    writer->slots[slot] = index + 1;
+    return index;
+}
+
+TBAlertCatalogWriter *TBAlertCatalogWriterCreate(void) {
+    return calloc(1, sizeof(TBAlertCatalogWriter));
+}
+
+void TBAlertCatalogWriterFree(TBAlertCatalogWriter *writer) {
+    if (!writer) {
+        return;
+    }
+    free(writer->strings);
+    free(writer->stringOffsets);
+    free(writer->isIdentifier);
+    free(writer->slots);
+    free(writer->entries);
+    free(writer->items);
+    free(writer);
+}
+
+bool TBAlertCatalogWriterAddEntry(TBAlertCatalogWriter *writer, const TBAlertCatalogEntrySpec *spec) {
+    if (!spec->identifier || spec->buttonCount > UINT8_MAX || spec->textFieldCount > UINT8_MAX ||
+        spec->style > TBAlertCatalogStyleSheet) {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t identifier = TBWriterIntern(writer, spec->identifier, &ok);
+    if (!ok || writer->isIdentifier[identifier]) {
+        return false;
+    }
+
+    size_t itemsLength = spec->buttonCount * TBAlertCatalogButtonSize
+                         + spec->textFieldCount * TBAlertCatalogTextFieldSize;
+    size_t entryCapacity = writer->entryCapacity;
+    if (!TBGrow((void **)&writer->entries, sizeof(TBWriterEntry), writer->entryCount + 1, &entryCapacity) ||
+        !TBGrow((void **)&writer->items, 1, writer->itemsLength + itemsLength, &writer->itemsCapacity)) {
+        return false;
+    }
+    writer->entryCapacity = (uint32_t)entryCapacity;
+
+    TBWriterEntry entry = {
+        .identifier = identifier,
+        .title = TBWriterIntern(writer, spec->title, &ok),
+        .message = TBWriterIntern(writer, spec->message, &ok),
+        .style = spec->style,
+        .buttonCount = (uint8_t)spec->buttonCount,
+        .textFieldCount = (uint8_t)spec->textFieldCount,
+        .itemsOffset = writer->itemsLength,
+    };
+
+    uint8_t *record = writer->items + writer->itemsLength;
+    if (itemsLength) {
+        memset(record, 0, itemsLength);
+    }
+    for (size_t i = 0; i < spec->buttonCount; i++, record += TBAlertCatalogButtonSize) {
+        const TBAlertCatalogButtonSpec *button = &spec->buttons[i];
+        TBWrite32(record, TBWriterIntern(writer, button->title, &ok));
+        record[4] = (uint8_t)button->role;
+        record[5] = button->enabled ? TBAlertCatalogButtonEnabled : 0;
+    }
+    for (size_t i = 0; i < spec->textFieldCount; i++, record += TBAlertCatalogTextFieldSize) {
+        const TBAlertCatalogTextFieldSpec *textField = &spec->textFields[i];
+        TBWrite32(record, TBWriterIntern(writer, textField->identifier, &ok));
+        TBWrite32(record + 4, TBWriterIntern(writer, textField->placeholder, &ok));
+        record[8] = textField->secure ? TBAlertCatalogTextFieldSecure : 0;
+    }
+
+    // Strings interned before running out of memory stay in the table, unused; the entry is not added
+    if (!ok) {
+        return false;
+    }
+
+    writer->isIdentifier[identifier] = true;
+    writer->entries[writer->entryCount++] = entry;
+    writer->itemsLength += itemsLength;
+    return true;
+}
+
+typedef struct TBSortedEntry {
+    const char *identifier;
+    const TBWriterEntry *entry;
+} TBSortedEntry;
+
+static int TBSortedEntryCompare(const void *a, const void *b) {
+    return strcmp(((const TBSortedEntry *)a)->identifier, ((const TBSortedEntry *)b)->identifier);
+}
+
+bool TBAlertCatalogWriterFinish(TBAlertCatalogWriter *writer, uint8_t **bytes, size_t *length) {
+    size_t entriesOffset = TBAlertCatalogHeaderSize;
+    size_t itemsOffset = entriesOffset + (size_t)writer->entryCount * TBAlertCatalogEntrySize;
+    size_t stringOffsetsOffset = itemsOffset + writer->itemsLength;
+    size_t stringsOffset = stringOffsetsOffset + ((size_t)writer->stringCount + 1) * sizeof(uint32_t);
+    size_t total = stringsOffset + writer->stringsLength;
+    if (total > UINT32_MAX) {
+        return false;
+    }
+
+    uint8_t *catalog = calloc(1, total);
+    TBSortedEntry *sorted = malloc((writer->entryCount ? writer->entryCount : 1) * sizeof(TBSortedEntry));
+    if (!catalog || !sorted) {
+        free(catalog);
+        free(sorted);
+        return false;
+    }
+
+    memcpy(catalog, TBAlertCatalogMagic, sizeof(TBAlertCatalogMagic));
+    TBWrite16(catalog + 4, TBAlertCatalogVersion);
+    TBWrite16(catalog + 6, TBAlertCatalogHeaderSize);
+    TBWrite32(catalog + 8, writer->entryCount);
+    TBWrite32(catalog + 12, writer->stringCount);
+    TBWrite32(catalog + 16, (uint32_t)entriesOffset);
+    TBWrite32(catalog + 20, (uint32_t)stringOffsetsOffset);
+    TBWrite32(catalog + 24, (uint32_t)stringsOffset);
+    TBWrite32(catalog + 28, (uint32_t)writer->stringsLength);
+
+    for (uint32_t i = 0; i < writer->entryCount; i++) {
+        const TBWriterEntry *entry = &writer->entries[i];
+        sorted[i] = (TBSortedEntry){ (const char *)writer->strings + writer->stringOffsets[entry->identifier], entry };
+    }
+    qsort(sorted, writer->entryCount, sizeof(TBSortedEntry), TBSortedEntryCompare);
+
+    for (uint32_t i = 0; i < writer->entryCount; i++) {
+        const TBWriterEntry *entry = sorted[i].entry;
+        uint8_t *record = catalog + entriesOffset + (size_t)i * TBAlertCatalogEntrySize;
+        TBWrite32(record, entry->identifier);
+        TBWrite32(record + 4, entry->title);
+        TBWrite32(record + 8, entry->message);
+        TBWrite32(record + 12, (uint32_t)(itemsOffset + entry->itemsOffset));
+        record[16] = (uint8_t)entry->style;
+        record[17] = entry->buttonCount;
+        record[18] = entry->textFieldCount;
+    }
+    free(sorted);
+
+    if (writer->itemsLength) {
+        memcpy(catalog + itemsOffset, writer->items, writer->itemsLength);
+    }
+    for (uint32_t i = 0; i < writer->stringCount; i++) {
+        TBWrite32(catalog + stringOffsetsOffset + (size_t)i * 4, writer->stringOffsets[i]);
+    }
+    TBWrite32(catalog + stringOffsetsOffset + (size_t)writer->stringCount * 4, (uint32_t)writer->stringsLength);
+    if (writer->stringsLength) {
+        memcpy(catalog + stringsOffset, writer->strings, writer->stringsLength);
+    }
+
+    *bytes = catalog;
+    *length = total;
+    return true;
+}
@@ -0,0 +1,156 @@
+//
+//  TBAlertCatalogFormat.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#ifndef TBAlertCatalogFormat_h
+#define TBAlertCatalogFormat_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The binary format behind \c TBAlertCatalog, in plain C so that it can be built and tested anywhere.
+
+ A catalog is one little-endian file:
+
+ - A fixed-size header.
+ - A table of fixed-size entries sorted by identifier, so that an entry is found by binary search
+   without reading any other entry.
+ - The buttons and text fields of every entry.
+ - A string table. Each distinct string is stored once, however many entries use it, and is
+   referred to everywhere else by its index.
+
+ Opening a catalog only checks the header. Everything else is checked when it is read, so opening
+ costs the same however many entries there are. */
+
+/** Refers to no string, such as the message of an alert without one. */
+#define TBAlertCatalogNoString UINT32_MAX
+
+typedef enum TBAlertCatalogStyle {
+    TBAlertCatalogStyleAlert = 0,
+    TBAlertCatalogStyleSheet = 1,
+} TBAlertCatalogStyle;
+
+typedef enum TBAlertCatalogButtonRole {
+    TBAlertCatalogButtonRoleDefault = 0,
+    TBAlertCatalogButtonRoleCancel = 1,
+    TBAlertCatalogButtonRoleDestructive = 2,
+} TBAlertCatalogButtonRole;
+
+typedef struct TBAlertCatalogButton {
+    uint32_t title;
+    TBAlertCatalogButtonRole role;
+    bool enabled;
+} TBAlertCatalogButton;
+
+typedef struct TBAlertCatalogTextField {
+    /** Looks the text field up in \c TBAlertTextFieldValues; may be \c TBAlertCatalogNoString */
+    uint32_t identifier;
+    uint32_t placeholder;
+    bool secure;
+} TBAlertCatalogTextField;
+
+/** One alert, as stored. Strings are indexes into the catalog's string table. */
+typedef struct TBAlertCatalogEntry {
+    uint32_t identifier;
+    uint32_t title;
+    uint32_t message;
+    TBAlertCatalogStyle style;
+    size_t buttonCount;
+    size_t textFieldCount;
+    /** The buttons, then the text fields; use the accessors below. */
+    const uint8_t *items;
+} TBAlertCatalogEntry;
+
+/** A catalog in memory. Owns its bytes only if it was opened from a file. */
+typedef struct TBAlertCatalogFile {
+    const uint8_t *bytes;
+    size_t length;
+    uint32_t entryCount;
+    uint32_t stringCount;
+    const uint8_t *entries;
+    const uint8_t *stringOffsets;
+    const uint8_t *strings;
+    size_t stringsLength;
+    void *mapping;
+} TBAlertCatalogFile;
+
+// Reading
+
+/** Maps a compiled catalog into memory.
+ @return \c false if the file can't be read or isn't a catalog of a version this code understands. */
+extern bool TBAlertCatalogFileOpen(const char *path, TBAlertCatalogFile *catalog);
+/** Reads a compiled catalog from memory, which must outlive \c catalog and must not change. */
+extern bool TBAlertCatalogFileInit(const void *bytes, size_t length, TBAlertCatalogFile *catalog);
+/** Unmaps a catalog opened with \c TBAlertCatalogFileOpen; does nothing for other catalogs. */
+extern void TBAlertCatalogFileClose(TBAlertCatalogFile *catalog);
+
+/** @return The string at \c index, which is NUL-terminated, or \c NULL if there isn't one or it is malformed.
+ @param length If not \c NULL, set to the length of the string in bytes, without the NUL. */
+extern const char *TBAlertCatalogFileString(const TBAlertCatalogFile *catalog, uint32_t index, size_t *length);
+
+/** @return \c true and sets \c entry if \c catalog has a well-formed entry with the given identifier. */
+extern bool TBAlertCatalogFileFindEntry(const TBAlertCatalogFile *catalog,
+                                        const char *identifier, size_t length,
+                                        TBAlertCatalogEntry *entry);
+/** @return \c true and sets \c entry if the entry at \c index, in identifier order, is well-formed. */
+extern bool TBAlertCatalogFileEntryAtIndex(const TBAlertCatalogFile *catalog, uint32_t index,
+                                           TBAlertCatalogEntry *entry);
+
+extern TBAlertCatalogButton TBAlertCatalogEntryButton(const TBAlertCatalogEntry *entry, size_t index);
+extern TBAlertCatalogTextField TBAlertCatalogEntryTextField(const TBAlertCatalogEntry *entry, size_t index);
+
+// Writing
+
+typedef struct TBAlertCatalogButtonSpec {
+    const char *title;
+    TBAlertCatalogButtonRole role;
+    bool enabled;
+} TBAlertCatalogButtonSpec;
+
+typedef struct TBAlertCatalogTextFieldSpec {
+    const char *identifier;
+    const char *placeholder;
+    bool secure;
+} TBAlertCatalogTextFieldSpec;
+
+/** One alert to compile. Any string but the identifier may be \c NULL. */
+typedef struct TBAlertCatalogEntrySpec {
+    const char *identifier;
+    const char *title;
+    const char *message;
+    TBAlertCatalogStyle style;
+    const TBAlertCatalogButtonSpec *buttons;
+    size_t buttonCount;
+    const TBAlertCatalogTextFieldSpec *textFields;
+    size_t textFieldCount;
+} TBAlertCatalogEntrySpec;
+
+typedef struct TBAlertCatalogWriter TBAlertCatalogWriter;
+
+extern TBAlertCatalogWriter *TBAlertCatalogWriterCreate(void);
+extern void TBAlertCatalogWriterFree(TBAlertCatalogWriter *writer);
+
+/** Copies an entry into the writer, interning its strings.
+ @return \c false if the identifier is missing or already used, there are too many buttons or
+ text fields, or memory could not be allocated. */
+extern bool TBAlertCatalogWriterAddEntry(TBAlertCatalogWriter *writer, const TBAlertCatalogEntrySpec *spec);
+
+/** Lays out every entry added so far as a catalog.
+ @param bytes Set to the catalog, which the caller must \c free.
+ @return \c false if memory could not be allocated or the catalog would be too large. */
+extern bool TBAlertCatalogWriterFinish(TBAlertCatalogWriter *writer, uint8_t **bytes, size_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
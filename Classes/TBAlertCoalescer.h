@@ -0,0 +1,55 @@
+//
+//  TBAlertCoalescer.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertController.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Folds alerts which look the same into one, so that a burst of identical errors shows a single alert.
+
+ An alert shown while an equivalent one is still on its way to the screen or visible, and within
+ \c window of the last such alert, is not presented at all. It waits on the visible alert instead:
+ when the user chooses a button there, the button at the same index is performed on every alert folded
+ into it and each one's result, if it was presented for one, is resolved, in the order they were shown.
+ If the visible alert is dismissed without a button, so is every alert folded into it.
+
+ Folding happens on the thread that shows the alert, so a storm of alerts shown from background
+ threads never reaches the main thread, except to update the repeat count if there is one.
+ A folded alert's \c showFromViewController: completion is called right away. Alerts with a
+ \c dataSource are never folded.
+
+ Coalescing is opt-in: set \c TBAlertController.coalescer. Safe to use from any thread. */
+@interface TBAlertCoalescer : NSObject
+
+- (instancetype)initWithClock:(id<TBAlertClock>)clock NS_DESIGNATED_INITIALIZER;
+/** Uses a \c TBAlertSystemClock. */
+- (instancetype)init;
+
+@property (nonatomic, readonly) id<TBAlertClock> clock;
+/** How long after an alert an equivalent one is still folded into it. Each folded alert
+ starts the window over, so a steady storm keeps folding. Defaults to 10 seconds. */
+@property (nonatomic) NSTimeInterval window;
+/** If set, the visible alert's message gets a line with the number of alerts folded into it so far,
+ formatted with this string, which takes one \c %lu. Its own message is restored once it is dismissed.
+ Defaults to \c nil, which leaves the message alone. */
+@property (nonatomic, copy, nullable) NSString *repeatCountFormat;
+
+/** Folds \c alert into an equivalent alert that is already queued or visible, if there is one,
+ and otherwise remembers \c alert as the one to fold later alerts into.
+ Called by \c showFromViewController:animated:completion:; there's rarely a need to call it directly.
+ @return \c YES if \c alert was folded and must not be presented. */
+- (BOOL)coalesceAlert:(TBAlertController *)alert;
+
+/** Alerts with the same fingerprint are equivalent. Covers the style, title, message, each button's
+ title and style, and the identifiers and number of text fields; text field configuration handlers
+ can't be compared, so they are not covered. @return \c 0 for alerts with a \c dataSource. */
++ (uint64_t)fingerprintOfAlert:(TBAlertController *)alert;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,213 @@
+//
+//  TBAlertCoalescer.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertCoalescer.h"
+
+/** Implemented in TBAlertController.m */
+@interface TBAlertController (TBAlertCoalescing)
+- (uint64_t)coalescingFingerprint;
+- (void)acceptDuplicates;
+- (BOOL)isAcceptingDuplicates;
+- (BOOL)isFolded;
+- (BOOL)foldDuplicate:(TBAlertController *)duplicate;
+@end
+
+#pragma mark - TBAlertCoalescedAlert
+
+/** The alert that later equivalent alerts are folded into. */
+@interface TBAlertCoalescedAlert : NSObject {
+    @public
+    __weak TBAlertController *_alert;
+    uint64_t _fingerprint;
+    /// Its message before any repeat count was added
+    NSString *_message;
+    /// Its message with the newest repeat count, if any
+    NSString *_repeatMessage;
+    /// The message with a repeat count it was last actually given, on the main thread
+    NSString *_appliedMessage;
+    /// Whether the main thread has yet to give it \c _repeatMessage
+    BOOL _applyPending;
+    NSUInteger _count;
+    NSTimeInterval _lastSeen;
+}
+@end
+
+@implementation TBAlertCoalescedAlert
+@end
+
+#pragma mark - TBAlertCoalescer
+
+@implementation TBAlertCoalescer {
+    /// Keyed by fingerprint. Synchronize on self to use it.
+    NSMutableDictionary<NSNumber *, TBAlertCoalescedAlert *> *_alerts;
+    /// Alerts given a repeat count, until they're dismissed, even once \c _alerts forgets them.
+    /// Synchronize on self to use it.
+    NSMapTable<TBAlertController *, TBAlertCoalescedAlert *> *_counted;
+}
+
+- (instancetype)init {
+    return [self initWithClock:[TBAlertSystemClock new]];
+}
+
+- (instancetype)initWithClock:(id<TBAlertClock>)clock {
+    NSParameterAssert(clock);
+
+    self = [super init];
+    if (self) {
+        _clock = clock;
+        _window = 10;
+        _alerts = [NSMutableDictionary new];
+        _counted = [NSMapTable weakToStrongObjectsMapTable];
+
+        [NSNotificationCenter.defaultCenter addObserver:self
+            selector:@selector(alertDidDismiss:)
+            name:TBAlertControllerDidDismissNotification
+            object:nil
+        ];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    [NSNotificationCenter.defaultCenter removeObserver:self];
+}
+
++ (uint64_t)fingerprintOfAlert:(TBAlertController *)alert {
+    return [alert coalescingFingerprint];
+}
+
+- (BOOL)coalesceAlert:(TBAlertController *)alert {
+    // Shown again while it's already in play, such as after hopping to the main thread
+    if ([alert isAcceptingDuplicates]) {
+        return NO;
+    }
+    if ([alert isFolded]) {
+        return YES;
+    }
+
+    uint64_t fingerprint = [alert coalescingFingerprint];
+    if (!fingerprint) {
+        return NO;
+    }
+
+    // Read outside the lock; it may call a provider
+    NSString *message = alert.message;
+    NSTimeInterval now = self.clock.now;
+    NSString *format = self.repeatCountFormat;
+
+    TBAlertController *target = nil;
+    BOOL applyRepeatCount = NO;
+    @synchronized (self) {
+        TBAlertCoalescedAlert *existing = _alerts[@(fingerprint)];
+        TBAlertController *candidate = existing ? existing->_alert : nil;
+        if (candidate && now - existing->_lastSeen <= self.window && [candidate foldDuplicate:alert]) {
+            existing->_lastSeen = now;
+            target = candidate;
+
+            if (format) {
+                NSString *repeats = [NSString stringWithFormat:format, (unsigned long)++existing->_count];
+                NSString *original = existing->_message;
+                existing->_repeatMessage = original.length ? [NSString stringWithFormat:@"%@\n\n%@", original, repeats] : repeats;
+                [_counted setObject:existing forKey:candidate];
+
+                // One trip to the main thread at a time, however many alerts fold meanwhile
+                applyRepeatCount = !existing->_applyPending;
+                existing->_applyPending = YES;
+            } else {
+                existing->_count++;
+            }
+        } else {
+            [self removeExpiredAlertsAt:now];
+
+            TBAlertCoalescedAlert *coalesced = [TBAlertCoalescedAlert new];
+            coalesced->_alert = alert;
+            coalesced->_fingerprint = fingerprint;
+            coalesced->_message = message;
+            coalesced->_count = 1;
+            coalesced->_lastSeen = now;
+            _alerts[@(fingerprint)] = coalesced;
+            [alert acceptDuplicates];
+        }
+    }
+
+    if (!target) {
+        return NO;
+    }
+
+    if (applyRepeatCount) {
+        if (NSThread.isMainThread) {
+            [self applyRepeatCountToAlert:target];
+        } else {
+            __weak TBAlertController *weakTarget = target;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self applyRepeatCountToAlert:weakTarget];
+            });
+        }
+    }
+
+    return YES;
+}
+
+/** Gives \c alert its message with the newest repeat count. Only ever called on the main thread, and reads
+ the count when it runs, so a thread that folded an alert earlier can't overwrite a later count. */
+- (void)applyRepeatCountToAlert:(TBAlertController *)alert {
+    NSString *repeatMessage = nil;
+    @synchronized (self) {
+        TBAlertCoalescedAlert *coalesced = alert ? [_counted objectForKey:alert] : nil;
+        if (!coalesced) {
+            // Dismissed meanwhile
+            return;
+        }
+
+        coalesced->_applyPending = NO;
+        coalesced->_appliedMessage = repeatMessage = coalesced->_repeatMessage;
+    }
+
+    alert.message = repeatMessage;
+}
+
+/** Gives a dismissed alert its own message back, so the repeat count doesn't outlive the repeats,
+ unless something else changed the message since. */
+- (void)alertDidDismiss:(NSNotification *)notification {
+    TBAlertController *alert = notification.object;
+    NSString *message = nil, *appliedMessage = nil;
+    @synchronized (self) {
+        TBAlertCoalescedAlert *coalesced = [_counted objectForKey:alert];
+        if (!coalesced) {
+            return;
+        }
+
+        message = coalesced->_message;
+        appliedMessage = coalesced->_appliedMessage;
+        [_counted removeObjectForKey:alert];
+        if (_alerts[@(coalesced->_fingerprint)] == coalesced) {
+            [_alerts removeObjectForKey:@(coalesced->_fingerprint)];
+        }
+    }
+
+    // Also on the main thread, so no repeat count is applied after this
+    if (appliedMessage && [alert.message isEqualToString:appliedMessage]) {
+        alert.message = message;
+    }
+}
+
+/** Forgets alerts which are gone or can no longer have alerts folded into them. Call while synchronized on \c self. */
+- (void)removeExpiredAlertsAt:(NSTimeInterval)now {
+    NSMutableArray<NSNumber *> *expired = [NSMutableArray new];
+    [_alerts enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, TBAlertCoalescedAlert *coalesced, BOOL *stop) {
+        TBAlertController *alert = coalesced->_alert;
+        if (!alert || ![alert isAcceptingDuplicates] || now - coalesced->_lastSeen > self.window) {
+            [expired addObject:key];
+        }
+    }];
+
+    [_alerts removeObjectsForKeys:expired];
+}
+
+@end
@@ -6,7 +6,7 @@
 //  Copyright (c) 2021 Tanner. All rights reserved.
 //
 
-#import <UIKit/UIKit.h>
+#import "TBAlertPlatform.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -16,9 +16,11 @@ typedef void (^TBAlertReveal)(void);
 typedef void (^TBAlertBuilder)(TBAlert *make);
 typedef TBAlert * _Nonnull (^TBAlertStringProperty)(NSString * _Nullable);
 typedef TBAlert * _Nonnull (^TBAlertStringArg)(NSString * _Nullable);
+typedef TBAlert * _Nonnull (^TBAlertStringProviderProperty)(NSString * _Nullable(^provider)(void));
 typedef TBAlert * _Nonnull (^TBAlertTextField)(void(^configurationHandler)(UITextField *textField));
 typedef TBAlertActionBuilder * _Nonnull (^TBAlertAddAction)(NSString *title);
 typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionStringProperty)(NSString * _Nullable);
+typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionStringProviderProperty)(NSString * _Nullable(^provider)(void));
 typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionProperty)(void);
 typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionBOOLProperty)(BOOL);
 typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionHandler)(void(^handler)(NSArray<NSString *> *strings));
@@ -48,6 +50,14 @@ typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionHandler)(void(^handler)(N
 ///
 /// Call in succession to append strings to the message.
 @property (nonatomic, readonly) TBAlertStringProperty message;
+/// Set the alert's title to the result of a block, which is only called
+/// once the alert is shown or its title is read.
+///
+/// Use this instead of \c title when the title is expensive to build and
+/// the alert might never be shown. Any fragments passed to \c title are ignored.
+@property (nonatomic, readonly) TBAlertStringProviderProperty titleProvider;
+/// Like \c titleProvider, for the alert's message.
+@property (nonatomic, readonly) TBAlertStringProviderProperty messageProvider;
 /// Add a button with a given title with the default style and no action.
 @property (nonatomic, readonly) TBAlertAddAction button;
 /// Add a text field with the given (optional) placeholder text.
@@ -66,6 +76,9 @@ typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionHandler)(void(^handler)(N
 ///
 /// Call in succession to append strings to the title.
 @property (nonatomic, readonly) TBAlertActionStringProperty title;
+/// Set the action's title to the result of a block, which is only called
+/// once the alert is shown or the title is read. Any fragments passed to \c title are ignored.
+@property (nonatomic, readonly) TBAlertActionStringProviderProperty titleProvider;
 /// Make the action destructive. It appears with red text.
 @property (nonatomic, readonly) TBAlertActionProperty destructiveStyle;
 /// Make the action cancel-style. It appears with a bolder font.
@@ -77,7 +90,9 @@ typedef TBAlertActionBuilder * _Nonnull (^TBAlertActionHandler)(void(^handler)(N
 /// Access the underlying TBAlertAction, should you need to change it while
 /// the encompassing alert is being displayed. For example, you may want to
 /// enable or disable a button based on the input of some text fields in the alert.
-/// Do not call this more than once per instance.
+/// Works inside the builder block or after it returns; afterwards, this is the action the
+/// alert controller made for the button, or a detached one if the button was removed.
+/// The action's properties can't be changed through the builder once this is called.
 @property (nonatomic, readonly) TBAlertAction *action;
 
 @end
@@ -21,7 +21,53 @@ _Pragma("clang diagnostic ignored \"-Wshadow\"") \
 __strong typeof(var) var = __weak__##var; \
 _Pragma("clang diagnostic pop")
 
-@interface TBAlert ()
+/// Appends \c fragment to a string made up of fragments.
+///
+/// The first fragment is kept as-is; a mutable buffer is only created once a
+/// second fragment arrives, so that long fragment chains are linear instead of
+/// copying the whole string for each fragment.
+static void TBAppendFragment(NSString * __strong *head, NSMutableString * __strong *buffer, NSString *fragment) {
+    if (*buffer) {
+        [*buffer appendString:fragment ?: @""];
+    } else if (*head) {
+        *buffer = [NSMutableString stringWithString:*head];
+        [*buffer appendString:fragment ?: @""];
+        *head = nil;
+    } else {
+        *head = fragment;
+    }
+}
+
+/// @return The string made up of all fragments passed to \c TBAppendFragment, or \c nil if there were none.
+static NSString *TBFreezeFragments(NSString *head, NSMutableString *buffer) {
+    return buffer ? buffer.copy : head.copy;
+}
+
+/** Implemented in TBAlertController.m */
+@interface TBAlertController (TBAlertButtonStorage)
+/// @return The serial number of the new button
+- (uint32_t)addOtherButtonWithTitle:(NSString *)title enabled:(BOOL)enabled buttonAction:(TBAlertActionBlock)buttonBlock;
+/// @return The action for the button with the given serial number, created if needed, or \c nil if it was removed
+- (TBAlertAction *)actionForButtonWithSerial:(uint32_t)serial;
+@end
+
+@interface TBAlert () {
+    // Property blocks are created once per builder and reused
+    TBAlertStringProperty _titleBlock;
+    TBAlertStringProperty _messageBlock;
+    TBAlertStringProviderProperty _titleProviderBlock;
+    TBAlertStringProviderProperty _messageProviderBlock;
+    TBAlertAddAction _buttonBlock;
+    TBAlertStringArg _textFieldBlock;
+    TBAlertTextField _configuredTextFieldBlock;
+
+    NSString *_titleHead;
+    NSMutableString *_titleBuffer;
+    NSString *_messageHead;
+    NSMutableString *_messageBuffer;
+    TBAlertStringProvider _titleProvider;
+    TBAlertStringProvider _messageProvider;
+}
 @property (nonatomic, readonly) TBAlertController *_controller;
 @property (nonatomic, readonly) NSMutableArray<TBAlertActionBuilder *> *_actions;
 @end
@@ -29,13 +75,28 @@ _Pragma("clang diagnostic pop")
 #define TBAlertActionMutationAssertion() \
 NSAssert(!self._action, @"Cannot mutate action after retreiving underlying UIAlertAction");
 
-@interface TBAlertActionBuilder ()
-@property (nonatomic) TBAlertController *_controller;
-@property (nonatomic) NSString *_title;
+@interface TBAlertActionBuilder () {
+    TBAlertActionStringProperty _titleBlock;
+    TBAlertActionStringProviderProperty _titleProviderBlock;
+    TBAlertActionProperty _destructiveStyleBlock;
+    TBAlertActionProperty _cancelStyleBlock;
+    TBAlertActionBOOLProperty _enabledBlock;
+    TBAlertActionHandler _handlerBlock;
+
+    /// The controller the button was added to without an action, and the button's serial number there
+    __weak TBAlertController *_addedTo;
+    uint32_t _serial;
+
+    @public
+    NSString *_titleHead;
+    NSMutableString *_titleBuffer;
+}
 @property (nonatomic) UIAlertActionStyle _style;
 @property (nonatomic) BOOL _disable;
 @property (nonatomic) TBAlertActionBlock _handler;
+@property (nonatomic) TBAlertStringProvider _titleProvider;
 @property (nonatomic) TBAlertAction *_action;
+- (void)addToController:(TBAlertController *)controller;
 @end
 
 @implementation TBAlert
@@ -63,30 +124,50 @@ NSAssert(!self._action, @"Cannot mutate action after retreiving underlying UIAle
         alertControllerWithTitle:nil message:nil preferredStyle:style
     ];
     
+    TBAlertTraceEmit(controller.traceIdentifier, TBAlertTraceEventBuild, TBAlertTracePhaseBegin);
+    
     // Create alert builder
     TBAlert *alert = [[self alloc] initWithController:controller];
 
     // Configure alert
     block(alert);
 
-    // Add actions
+    // Title and message are only built once, after all fragments are in, or not until they're needed
+    if (alert->_titleProvider) {
+        controller.titleProvider = alert->_titleProvider;
+    } else {
+        controller.title = TBFreezeFragments(alert->_titleHead, alert->_titleBuffer);
+    }
+    if (alert->_messageProvider) {
+        controller.messageProvider = alert->_messageProvider;
+    } else {
+        controller.message = TBFreezeFragments(alert->_messageHead, alert->_messageBuffer);
+    }
+
+    // Add actions; the cancel button always goes last, so other buttons keep the index they're added at
+    [controller reserveCapacityForOtherButtons:alert._actions.count];
+    NSInteger otherButtons = 0;
     for (TBAlertActionBuilder *builder in alert._actions) {
-        TBAlertAction *action = builder.action;
         switch (builder._style) {
             case UIAlertActionStyleDefault:
-                [controller addAction:action];
+                [builder addToController:controller];
+                otherButtons++;
                 break;
             case UIAlertActionStyleCancel:
-                [controller setCancelButton:action];
+                [controller setCancelButton:builder.action];
                 break;
             case UIAlertActionStyleDestructive:
-                [controller addAction:action];
-                // I don't like this... But it's for API compat, so
-                controller.destructiveButtonIndex = [controller.actions indexOfObject:action];
+                [builder addToController:controller];
+                controller.destructiveButtonIndex = otherButtons++;
         }
     }
 
-    return alert._controller;
+    // Handlers may have captured the builder; don't let it keep the controller or its actions alive
+    [alert._actions removeAllObjects];
+    alert->__controller = nil;
+    
+    TBAlertTraceEmit(controller.traceIdentifier, TBAlertTraceEventBuild, TBAlertTracePhaseEnd);
+    return controller;
 }
 
 + (void)make:(TBAlertBuilder)block
@@ -127,51 +208,99 @@ NSAssert(!self._action, @"Cannot mutate action after retreiving underlying UIAle
 #pragma mark Configuration
 
 - (TBAlertStringProperty)title {
-    return ^TBAlert *(NSString *title) {
-        if (self._controller.title) {
-            self._controller.title = [self._controller.title stringByAppendingString:title ?: @""];
-        } else {
-            self._controller.title = title;
-        }
-        return self;
-    };
+    if (!_titleBlock) {
+        weakify(self)
+        _titleBlock = ^TBAlert *(NSString *title) {
+            strongify(self)
+            TBAppendFragment(&self->_titleHead, &self->_titleBuffer, title);
+            return self;
+        };
+    }
+
+    return _titleBlock;
 }
 
 - (TBAlertStringProperty)message {
-    return ^TBAlert *(NSString *message) {
-        if (self._controller.message) {
-            self._controller.message = [self._controller.message stringByAppendingString:message ?: @""];
-        } else {
-            self._controller.message = message;
-        }
-        return self;
-    };
+    if (!_messageBlock) {
+        weakify(self)
+        _messageBlock = ^TBAlert *(NSString *message) {
+            strongify(self)
+            TBAppendFragment(&self->_messageHead, &self->_messageBuffer, message);
+            return self;
+        };
+    }
+
+    return _messageBlock;
+}
+
+- (TBAlertStringProviderProperty)titleProvider {
+    if (!_titleProviderBlock) {
+        weakify(self)
+        _titleProviderBlock = ^TBAlert *(TBAlertStringProvider provider) {
+            strongify(self)
+            self->_titleProvider = provider;
+            return self;
+        };
+    }
+
+    return _titleProviderBlock;
+}
+
+- (TBAlertStringProviderProperty)messageProvider {
+    if (!_messageProviderBlock) {
+        weakify(self)
+        _messageProviderBlock = ^TBAlert *(TBAlertStringProvider provider) {
+            strongify(self)
+            self->_messageProvider = provider;
+            return self;
+        };
+    }
+
+    return _messageProviderBlock;
 }
 
 - (TBAlertAddAction)button {
-    return ^TBAlertActionBuilder *(NSString *title) {
-        TBAlertActionBuilder *action = TBAlertActionBuilder.new.title(title);
-        action._controller = self._controller;
-        [self._actions addObject:action];
-        return action;
-    };
+    if (!_buttonBlock) {
+        weakify(self)
+        _buttonBlock = ^TBAlertActionBuilder *(NSString *title) {
+            strongify(self)
+            TBAlertActionBuilder *action = [TBAlertActionBuilder new];
+            action->_titleHead = title;
+            [self._actions addObject:action];
+            return action;
+        };
+    }
+
+    return _buttonBlock;
 }
 
 - (TBAlertStringArg)textField {
-    return ^TBAlert *(NSString *placeholder) {
-        [self._controller addTextFieldWithConfigurationHandler:^(UITextField *textField) {
-            textField.placeholder = placeholder;
-        }];
+    if (!_textFieldBlock) {
+        weakify(self)
+        _textFieldBlock = ^TBAlert *(NSString *placeholder) {
+            strongify(self)
+            [self._controller addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+                textField.placeholder = placeholder;
+            }];
+
+            return self;
+        };
+    }
 
-        return self;
-    };
+    return _textFieldBlock;
 }
 
 - (TBAlertTextField)configuredTextField {
-    return ^TBAlert *(void(^configurationHandler)(UITextField *)) {
-        [self._controller addTextFieldWithConfigurationHandler:configurationHandler];
-        return self;
-    };
+    if (!_configuredTextFieldBlock) {
+        weakify(self)
+        _configuredTextFieldBlock = ^TBAlert *(void(^configurationHandler)(UITextField *)) {
+            strongify(self)
+            [self._controller addTextFieldWithConfigurationHandler:configurationHandler];
+            return self;
+        };
+    }
+
+    return _configuredTextFieldBlock;
 }
 
 @end
@@ -179,48 +308,87 @@ NSAssert(!self._action, @"Cannot mutate action after retreiving underlying UIAle
 @implementation TBAlertActionBuilder
 
 - (TBAlertActionStringProperty)title {
-    return ^TBAlertActionBuilder *(NSString *title) {
-        TBAlertActionMutationAssertion();
-        if (self._title) {
-            self._title = [self._title stringByAppendingString:title ?: @""];
-        } else {
-            self._title = title;
-        }
-        return self;
-    };
+    if (!_titleBlock) {
+        weakify(self)
+        _titleBlock = ^TBAlertActionBuilder *(NSString *title) {
+            strongify(self)
+            TBAlertActionMutationAssertion();
+            TBAppendFragment(&self->_titleHead, &self->_titleBuffer, title);
+            return self;
+        };
+    }
+
+    return _titleBlock;
+}
+
+- (TBAlertActionStringProviderProperty)titleProvider {
+    if (!_titleProviderBlock) {
+        weakify(self)
+        _titleProviderBlock = ^TBAlertActionBuilder *(TBAlertStringProvider provider) {
+            strongify(self)
+            TBAlertActionMutationAssertion();
+            self._titleProvider = provider;
+            return self;
+        };
+    }
+
+    return _titleProviderBlock;
 }
 
 - (TBAlertActionProperty)destructiveStyle {
-    return ^TBAlertActionBuilder *() {
-        TBAlertActionMutationAssertion();
-        self._style = UIAlertActionStyleDestructive;
-        return self;
-    };
+    if (!_destructiveStyleBlock) {
+        weakify(self)
+        _destructiveStyleBlock = ^TBAlertActionBuilder *() {
+            strongify(self)
+            TBAlertActionMutationAssertion();
+            self._style = UIAlertActionStyleDestructive;
+            return self;
+        };
+    }
+
+    return _destructiveStyleBlock;
 }
 
 - (TBAlertActionProperty)cancelStyle {
-    return ^TBAlertActionBuilder *() {
-        TBAlertActionMutationAssertion();
-        self._style = UIAlertActionStyleCancel;
-        return self;
-    };
+    if (!_cancelStyleBlock) {
+        weakify(self)
+        _cancelStyleBlock = ^TBAlertActionBuilder *() {
+            strongify(self)
+            TBAlertActionMutationAssertion();
+            self._style = UIAlertActionStyleCancel;
+            return self;
+        };
+    }
+
+    return _cancelStyleBlock;
 }
 
 - (TBAlertActionBOOLProperty)enabled {
-    return ^TBAlertActionBuilder *(BOOL enabled) {
-        TBAlertActionMutationAssertion();
-        self._disable = !enabled;
-        return self;
-    };
+    if (!_enabledBlock) {
+        weakify(self)
+        _enabledBlock = ^TBAlertActionBuilder *(BOOL enabled) {
+            strongify(self)
+            TBAlertActionMutationAssertion();
+            self._disable = !enabled;
+            return self;
+        };
+    }
+
+    return _enabledBlock;
 }
 
 - (TBAlertActionHandler)handler {
-    return ^TBAlertActionBuilder *(void(^handler)(NSArray<NSString *> *)) {
-        TBAlertActionMutationAssertion();
+    if (!_handlerBlock) {
+        weakify(self)
+        _handlerBlock = ^TBAlertActionBuilder *(void(^handler)(NSArray<NSString *> *)) {
+            strongify(self)
+            TBAlertActionMutationAssertion();
+            self._handler = handler;
+            return self;
+        };
+    }
 
-        self._handler = handler;
-        return self;
-    };
+    return _handlerBlock;
 }
 
 - (TBAlertAction *)action {
@@ -228,14 +396,38 @@ NSAssert(!self._action, @"Cannot mutate action after retreiving underlying UIAle
         return self._action;
     }
 
+    // Added without one; use the action the controller makes for the button, so changes to it show
+    TBAlertController *controller = _addedTo;
+    if (controller) {
+        self._action = [controller actionForButtonWithSerial:_serial];
+        if (self._action) {
+            return self._action;
+        }
+    }
+
     self._action = [[TBAlertAction alloc]
-        initWithTitle:self._title
+        initWithTitle:TBFreezeFragments(_titleHead, _titleBuffer) ?: @""
         block:self._handler
     ];
     self._action.enabled = !self._disable;
+    self._action.titleProvider = self._titleProvider;
 
     return self._action;
 }
 
-@end
+/// Adds the button without creating an action for it, unless it already has one or needs one for its provider.
+- (void)addToController:(TBAlertController *)controller {
+    if (self._action || self._titleProvider) {
+        [controller addAction:self.action];
+        return;
+    }
 
+    _addedTo = controller;
+    _serial = [controller
+        addOtherButtonWithTitle:TBFreezeFragments(_titleHead, _titleBuffer) ?: @""
+        enabled:!self._disable
+        buttonAction:self._handler
+    ];
+}
+
+@end
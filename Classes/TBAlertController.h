@@ -8,6 +8,11 @@
 
 #import "TBAlertAction.h"
 #import "TBAlertController+Builder.h"
+#import "TBAlertPresenter.h"
+#import "TBAlertTextFieldValues.h"
+#import "TBAlertResult.h"
+#import "TBAlertDeadlineScheduler.h"
+#import "TBAlertTrace.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -17,7 +22,48 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
     TBAlertControllerStyleAlert
 };
 
+/** The identifier of the text field added by \c addFilterTextFieldWithPlaceholder:. */
+extern NSString * const TBAlertControllerFilterTextFieldIdentifier;
+/** Posted on the main thread once an alert controller is dismissed, by a button or otherwise, and its
+ presentation, if it had one, is off screen. The object is the alert controller. */
+extern NSString * const TBAlertControllerDidDismissNotification;
 
+@class TBAlertController, TBAlertCoalescer;
+
+/** Supplies a long list of buttons to a \c TBAlertController on demand, such as for a picker.
+ Actions for items are only created when they are needed, such as when one is chosen. */
+@protocol TBAlertControllerDataSource <NSObject>
+
+/** @return The number of items to show, before filtering. */
+- (NSUInteger)numberOfItemsInAlertController:(TBAlertController *)alertController;
+/** @return The title of the button for the item at \c index. */
+- (NSString *)alertController:(TBAlertController *)alertController titleForItemAtIndex:(NSUInteger)index;
+/** Called when the button for the item at \c index is chosen. */
+- (void)alertController:(TBAlertController *)alertController didSelectItemAtIndex:(NSUInteger)index;
+
+@optional
+
+/** @return A stable identifier for the item at \c index, which lets live updates recognize
+ items that moved after \c reloadData, and lets items be found with \c buttonWithIdentifier:. */
+- (nullable NSString *)alertController:(TBAlertController *)alertController identifierForItemAtIndex:(NSUInteger)index;
+/** Defaults to a case and diacritic insensitive search for \c filterText in the item's title.
+ An item which doesn't match some text must not match any text beginning with it. */
+- (BOOL)alertController:(TBAlertController *)alertController itemAtIndex:(NSUInteger)index matchesFilter:(NSString *)filterText;
+
+@end
+
+
+/** Alert controllers can be built, changed, and shown from any thread.
+ 
+ Showing an alert from another thread does everything it can on that thread, such as calling
+ \c titleProvider, then hops to the main thread once to present it. Presenters are given a snapshot
+ of the alert as it was when they started; changes made on other threads meanwhile are applied
+ afterwards like any other change to a presented alert. Snapshots share storage with the alert
+ controller until it next changes, so taking one copies nothing.
+ 
+ The data source, \c filterText, \c popoverSourceView, dismissing, and \c updateIfNeeded are for
+ the main thread only. Change the \c enabled state of buttons with \c setButtonEnabled:atIndex:
+ rather than on the action itself while other threads may be using the alert. */
 @interface TBAlertController : NSObject
 
 ///------------------
@@ -36,6 +82,12 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
 @property (nonatomic, copy, nullable) NSString         *title;
 /** The message of the alert controller. */
 @property (nonatomic, copy, nullable) NSString         *message;
+/** If set, \c title is replaced by the result of this block the first time it is read, usually
+ when the alert is presented, and the result is kept. Alerts which are built but never shown never call it.
+ Setting \c title discards the provider. */
+@property (nonatomic, copy, nullable) TBAlertStringProvider titleProvider;
+/** Like \c titleProvider, for \c message. Setting \c message discards the provider. */
+@property (nonatomic, copy, nullable) TBAlertStringProvider messageProvider;
 /** The reference view for UIPopoverViewController on iPad */
 @property (nonatomic, assign, nullable) UIView         *popoverSourceView;
 /** Defaults to \c NSNotFound. Values greater than the number of buttons are allowed but will be ignored and discarded. */
@@ -43,8 +95,30 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
 /** @return The number of "other buttons" added + the cancel button, if you added one. */
 @property (nonatomic, readonly) NSUInteger numberOfButtons;
 /** @return An array of \c TBAlertActions representing all "other button" actions and the cancel button action,
- if you added one. Gauranteed to never be \c nil. */
+ if you added one. Gauranteed to never be \c nil.
+ @note Buttons added with a title are stored compactly, and get an action the first time one is needed, such as by
+ this property or when the alert is presented. This creates an action for every button and every data source item;
+ prefer \c numberOfButtons and \c buttonAtIndex: when using a \c dataSource. */
 @property (nonatomic, readonly) NSArray<TBAlertAction *> *actions;
+/** If greater than \c 0, the alert dismisses itself this many seconds after it is presented.
+ Every alert's deadline is handled by \c TBAlertDeadlineScheduler.sharedScheduler. */
+@property (nonatomic) NSTimeInterval deadline;
+/** The button to trigger when the \c deadline passes, as if passed to \c dismissWithButtonIndex:.
+ Defaults to \c NSNotFound, which dismisses the alert without performing any action. */
+@property (nonatomic) NSUInteger deadlineButtonIndex;
+/** Names the alert for tests and tools, such as the rules of a \c TBScriptedAlertPresenter.
+ Alerts from a \c TBAlertCatalog are given their identifier in the catalog. */
+@property (nonatomic, copy, nullable) NSString *identifier;
+/** Unique to this alert controller for the life of the process. Events sent to \c TBAlertTrace.sink are keyed by it. */
+@property (nonatomic, readonly) uint64_t traceIdentifier;
+/** The presenter used to display this alert controller. Defaults to \c defaultPresenter. */
+@property (nonatomic, null_resettable) id<TBAlertPresenter> presenter;
+/** The presenter used by alert controllers which were not given one.
+ Defaults to a \c TBUIKitAlertPresenter, or a \c TBHeadlessAlertPresenter where UIKit is unavailable. */
+@property (nonatomic, class, null_resettable) id<TBAlertPresenter> defaultPresenter;
+/** If set, folds alerts shown while an equivalent one is visible into that one. Defaults to \c nil.
+ Set it before showing any alerts. @see \c TBAlertCoalescer */
+@property (nonatomic, class, nullable) TBAlertCoalescer *coalescer;
 
 ///--------------------
 /// @name Initializers
@@ -145,12 +219,44 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
  @param action A selector to perform on the \c target object when the button is triggered.
  @param object An object to pass to \c action. Behavior is undefined for \c nil values. */
 - (void)addOtherButtonWithTitle:(NSString *)title target:(id)target action:(SEL)action withObject:(nullable id)object;
+/** Adds an actionless button for each title, with room reserved for all of them up front. */
+- (void)addOtherButtonsWithTitles:(NSArray<NSString *> *)titles;
+/** Adds a button for each title, which executes the block at the same index of \c buttonBlocks when it is triggered.
+ @param buttonBlocks As many blocks as there are titles, or \c nil for actionless buttons. */
+- (void)addOtherButtonsWithTitles:(NSArray<NSString *> *)titles buttonActions:(nullable NSArray<TBAlertActionBlock> *)buttonBlocks;
+/** Makes room for \c count more buttons, so that adding them one at a time doesn't grow storage as it goes. */
+- (void)reserveCapacityForOtherButtons:(NSUInteger)count;
 /** @note You can also use this to enable or disable the cancel button if you have one set.
  @warning This is a feature of UIAlertAction and is only available on iOS 8. */
 - (void)setButtonEnabled:(BOOL)enabled atIndex:(NSUInteger)buttonIndex NS_AVAILABLE_IOS(8_0);
 /** Removes a button.
  @note You can also use this to remove the cancel button if you have one set. */
 - (void)removeButtonAtIndex:(NSUInteger)buttonIndex;
+/** @return The action for the button at \c buttonIndex. The cancel button, if any, is last. */
+- (TBAlertAction *)buttonAtIndex:(NSUInteger)buttonIndex;
+/** @return The action with the given \c identifier, including data source items, or \c nil if there is none. */
+- (nullable TBAlertAction *)buttonWithIdentifier:(NSString *)identifier;
+
+///-------------------
+/// @name Data source
+///-------------------
+
+#pragma mark Data source
+
+/** Supplies additional buttons, shown after any "other buttons" and before the cancel button.
+ Setting this calls \c reloadData. */
+@property (nonatomic, weak, nullable) id<TBAlertControllerDataSource> dataSource;
+/** When set, only data source items matching this text are shown. Typing into the text field
+ added by \c addFilterTextFieldWithPlaceholder: sets this. Each extension of the previous
+ filter text only looks at the items which matched it. */
+@property (nonatomic, copy, nullable) NSString *filterText;
+
+/** Asks the data source for its items again. Actions for previous items are discarded. */
+- (void)reloadData;
+/** Adds a text field which sets \c filterText as the user types.
+ @note Like any other text field, this requires \c TBAlertControllerStyleAlert.
+ \c UIAlertController cannot remove buttons once presented, so it is replaced without animation as the list narrows. */
+- (void)addFilterTextFieldWithPlaceholder:(nullable NSString *)placeholder NS_AVAILABLE_IOS(8_0);
 
 ///-------------------
 /// @name Text Fields
@@ -164,6 +270,36 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
  @note This will work in conjunction with the \c alertViewStyle property on iOS 8 (it is safe to set \c alertViewStyle and use this method).
  @note The text fields for the \c alertViewStyle property will always come out on top of any fields added here. */
 - (void)addTextFieldWithConfigurationHandler:(void (^)(UITextField *textField))configurationHandler NS_AVAILABLE_IOS(8_0);
+/** Same as \c addTextFieldWithConfigurationHandler:, but the text field's text can also be looked up
+ by \c identifier in the \c TBAlertTextFieldValues passed to button actions.
+
+ @param identifier An optional identifier for the text field. */
+- (void)addTextFieldWithIdentifier:(nullable NSString *)identifier
+              configurationHandler:(void (^)(UITextField *textField))configurationHandler NS_AVAILABLE_IOS(8_0);
+
+///-----------------------------------
+/// @name Updating a presented alert
+///-----------------------------------
+
+#pragma mark Updating a presented alert
+
+/** Incremented every time the title, message, buttons, or text fields change. */
+@property (nonatomic, readonly) NSUInteger modelVersion;
+
+/** Adding, removing, enabling, or disabling buttons or changing \c destructiveButtonIndex while
+ the alert is presented updates the presentation in place on the next turn of the run loop.
+ All changes made before then are applied together. Changes to text fields are not applied
+ to an alert which is already presented.
+
+ Call this after changing the \c enabled property of one of the \c actions directly. */
+- (void)setNeedsUpdate;
+/** Applies any pending changes to the presented alert immediately instead of waiting for the run loop.
+ Call this on the main thread. */
+- (void)updateIfNeeded;
+/** Calls \c titleProvider, \c messageProvider, and the \c titleProvider of every button again the next
+ time their strings are needed, such as after the locale changes. A presented alert is updated as if
+ \c title, \c message, and the buttons had been set again; otherwise nothing is called until the alert is shown. */
+- (void)invalidateProvidedStrings;
 
 ///----------------------------------------------------
 /// @name Displaying / dismissing the alert controller
@@ -182,11 +318,46 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
  @note \c viewController has no effect on iOS 7 when using \c TBAlertControllerStyleAlert.
  @note When using \c TBAlertControllerStyleActionSheet, the action sheet is shown from `viewController.view.window`.
  @note \c animated has no effect on iOS 7.
+ @note With \c TBUIKitAlertPresenter, if \c viewController is \c nil or already presenting something, the alert is
+ presented from the top-most view controller over it, or of the key window. An alert that can't be presented at all
+ is dismissed right away.
  
  @param viewController The view controller that should present the alert controller.
  @param animated Whether or not to animate the presentation. This value is ignored on iOS 7.
  @param completion An optional block to execute when the alert controller has been presented. You may pass \c nil to this parameter. */
 - (void)showFromViewController:(UIViewController *)viewController animated:(BOOL)animated completion:(nullable TBVoidBlock)completion;
+/** Presents the alert controller from the top-most view controller of the key window, as found by
+ \c TBPresentingViewControllerResolver.sharedResolver. */
+- (void)showFromAutomaticPresenter;
+/** Presents the alert controller from the top-most view controller of the key window, as found by
+ \c TBPresentingViewControllerResolver.sharedResolver. If there is none, the alert is shown from \c nil,
+ which only presenters that don't need a view controller, such as \c TBHeadlessAlertPresenter, accept.
+ 
+ @param animated Whether or not to animate the presentation.
+ @param completion An optional block to execute when the alert controller has been presented. */
+- (void)showFromAutomaticPresenterAnimated:(BOOL)animated completion:(nullable TBVoidBlock)completion;
+/** Builds everything needed to show the alert ahead of time, such as the \c UIAlertController
+ and its actions and text fields, so that showing it later only has to present it.
+ 
+ The result is used by the next call to \c showFromViewController:animated:completion:, and discarded
+ if the buttons, text fields, \c popoverSourceView, or \c presenter change before then.
+ Calling this again while still prepared does nothing. */
+- (void)prepareForPresentation;
+/** Whether or not the next presentation will use the work done by \c prepareForPresentation. */
+@property (nonatomic, readonly, getter=isPreparedForPresentation) BOOL preparedForPresentation;
+/** Presents the alert controller and calls \c completion exactly once, with the button that was chosen or why none was.
+ If the alert's own \c deadline passes first, the result is that of \c deadlineButtonIndex, or \c TBAlertResultReasonTimedOut.
+ The chosen button's action, if any, is performed first. From Swift, this can be awaited:
+ \c let result = await alert.presentForResult(from: self, cancellationToken: nil, timeout: 0)
+ 
+ @param viewController The view controller that should present the alert controller.
+ @param token An optional token which dismisses the alert when cancelled.
+ @param timeout The number of seconds after which to give up on the alert and dismiss it, or \c 0 to wait indefinitely.
+ @param completion Called with the result once the alert is resolved. Released as soon as it has been called. */
+- (void)presentForResultFromViewController:(nullable UIViewController *)viewController
+                         cancellationToken:(nullable TBAlertCancellationToken *)token
+                                   timeout:(NSTimeInterval)timeout
+                                completion:(void (^)(TBAlertResult *result))completion;
 
 /** Convenience method for programmatically dismissing the alert controller.
  
@@ -203,6 +374,33 @@ typedef NS_ENUM(NSInteger, TBAlertControllerStyle) {
  @warning This is a feature of \c UIAlertController and only available on iOS 8. */
 - (void)dismissAnimated:(BOOL)animated completion:(nullable TBVoidBlock)completion NS_AVAILABLE_IOS(8_0);
 
-NS_ASSUME_NONNULL_END
+@end
+
+///------------------------------
+/// @name Presenter support
+///------------------------------
+
+/** Methods intended for use by \c TBAlertPresenter implementations. */
+@interface TBAlertController (TBAlertPresenter)
+
+/** Configuration handlers for every text field, including those implied by \c alertViewStyle, in display order. */
+@property (nonatomic, readonly) NSArray<void (^)(UITextField *textField)> *textFieldConfigurationHandlers;
+/** Parallel to \c textFieldConfigurationHandlers, with \c NSNull for text fields without an identifier. */
+@property (nonatomic, readonly) NSArray *textFieldIdentifiers;
+
+/** @return The title of the button at \c buttonIndex, without creating an action for data source items. */
+- (NSString *)titleForButtonAtIndex:(NSUInteger)buttonIndex;
+/** @return Whether or not the button at \c buttonIndex is enabled, without creating an action for data source items. */
+- (BOOL)isButtonEnabledAtIndex:(NSUInteger)buttonIndex;
+/** @return The style to display the button at \c buttonIndex with. The cancel button is always last. */
+- (UIAlertActionStyle)actionStyleForButtonAtIndex:(NSUInteger)buttonIndex;
+
+/** Notifies the alert controller that a button was chosen in \c presentation, which has already dismissed itself.
+ The text in the presentation's text fields is captured before the button's action, if enabled, is performed. */
+- (void)presentation:(id<TBAlertPresentation>)presentation didSelectButtonAtIndex:(NSUInteger)buttonIndex;
+/** Notifies the alert controller that the user edited the text field at \c index in \c presentation. */
+- (void)presentation:(id<TBAlertPresentation>)presentation textFieldDidChangeAtIndex:(NSUInteger)index;
 
 @end
+
+NS_ASSUME_NONNULL_END
@@ -7,106 +7,299 @@
 //
 
 #import "TBAlertController.h"
+#import "TBAlertCoalescer.h"
+#import "TBUIKitAlertPresenter.h"
+#import "TBHeadlessAlertPresenter.h"
+#import "TBPresentingViewControllerResolver.h"
+#import <stdatomic.h>
 
 #if ! __has_feature(objc_arc)
 #error This file requires ARC! Add "-fobjc-arc" in Build Phases -> Compile Sources -> Compiler Flags.
 #endif
 
-#pragma mark - TBAlertView - DO NOT USE
-#pragma mark Created to use itself as the delegate for iOS 7 and earlier.
+#pragma mark - TBAlertButtonStore
+
+/** What a button's handler slot holds, and whether the button is enabled. */
+typedef NS_OPTIONS(uint8_t, TBAlertButtonFlags) {
+    TBAlertButtonEnabled = 1 << 0,
+    /// The handler slot holds a \c TBAlertActionBlock
+    TBAlertButtonHasBlock = 1 << 1,
+    /// The handler slot holds the \c TBAlertAction the button was added as
+    TBAlertButtonHasAction = 1 << 2,
+};
+
+/** @return A string equal to \c title, shared with every other button title equal to it,
+ so that alerts built over and over with formatted titles don't each keep a copy. */
+static NSString *TBAlertInternTitle(NSString *title) {
+    static NSHashTable<NSString *> *titles = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        titles = [NSHashTable weakObjectsHashTable];
+    });
+    
+    @synchronized (titles) {
+        NSString *interned = [titles member:title];
+        if (!interned) {
+            interned = title.copy;
+            [titles addObject:interned];
+        }
+        
+        return interned;
+    }
+}
+
+/** The buttons added directly to an alert controller, as parallel arrays with one entry per button.
+ A \c TBAlertAction is only created for a button that wasn't added as one when it is asked for,
+ such as when the alert is presented; the alert controller keeps those by serial number. */
+@interface TBAlertButtonStore : NSObject <NSMutableCopying> {
+    @public
+    /// Interned; \c NSNull for buttons added as actions, whose titles may come from a provider
+    NSMutableArray *_titles;
+    /// One \c TBAlertButtonFlags per button
+    NSMutableData *_flags;
+    /// \c NSNull, a block, or an action, as each button's flags say
+    NSMutableArray *_handlers;
+    /// One \c uint32_t per button, which identifies it across copies of the store
+    NSMutableData *_serials;
+    uint32_t _lastSerial;
+}
 
+@property (nonatomic, readonly) NSUInteger count;
 
-@protocol TBPresentable <NSObject>
-@property (nonatomic) NSString *title;
-@optional
-@property (nonatomic) NSString *message;
 @end
 
-@protocol TBAlert <NSObject>
+@implementation TBAlertButtonStore
 
-- (NSMutableArray *)textFieldInputStrings;
-- (void)didDismissWithButtonIndex:(NSInteger)buttonIndex;
+- (instancetype)init {
+    return [self initWithCapacity:0];
+}
 
-@end
-// AlertView
-@interface TBAlertView : UIAlertView <UIAlertViewDelegate>
-@property (nonatomic) id<TBAlert> controller;
-- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(id<TBAlert>)controller;
-@end
-@implementation TBAlertView
-- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(id<TBAlert>)controller {
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
     self = [super init];
     if (self) {
-        self.controller = controller;
-        self.title      = title;
-        self.message    = message;
-        self.delegate   = self;
+        _titles = [NSMutableArray arrayWithCapacity:capacity];
+        _flags = [NSMutableData dataWithCapacity:capacity * sizeof(TBAlertButtonFlags)];
+        _handlers = [NSMutableArray arrayWithCapacity:capacity];
+        _serials = [NSMutableData dataWithCapacity:capacity * sizeof(uint32_t)];
     }
     
     return self;
 }
-- (void)alertView:(UIAlertView *)alertView clickedButtonAtIndex:(NSInteger)buttonIndex {
-    switch (self.alertViewStyle) {
-        case UIAlertViewStyleLoginAndPasswordInput:
-            [self.controller.textFieldInputStrings addObject:[self textFieldAtIndex:1].text];
-        case UIAlertViewStylePlainTextInput:
-        case UIAlertViewStyleSecureTextInput:
-            [self.controller.textFieldInputStrings addObject:[self textFieldAtIndex:0].text];
-            break;
-            
-        case UIAlertViewStyleDefault:
-            break;
-    }
-    
-    [self.controller didDismissWithButtonIndex:buttonIndex];
+
+- (id)mutableCopyWithZone:(NSZone *)zone {
+    return [self copyWithCapacity:self.count];
 }
 
-@end
+/** @return A copy with room for at least \c capacity buttons before it grows. */
+- (TBAlertButtonStore *)copyWithCapacity:(NSUInteger)capacity {
+    TBAlertButtonStore *copy = [[TBAlertButtonStore alloc] initWithCapacity:MAX(capacity, self.count)];
+    [copy->_titles addObjectsFromArray:_titles];
+    [copy->_flags appendData:_flags];
+    [copy->_handlers addObjectsFromArray:_handlers];
+    [copy->_serials appendData:_serials];
+    copy->_lastSerial = _lastSerial;
+    return copy;
+}
 
-#pragma mark - TBAlertView - DO NOT USE
-#pragma mark Created to use itself as the delegate for iOS 7 and earlier.
+- (NSUInteger)count {
+    return _flags.length / sizeof(TBAlertButtonFlags);
+}
 
-// ActionSheet
-@interface TBActionSheet : UIActionSheet <UIActionSheetDelegate>
-@property (nonatomic) id<TBAlert> controller;
-- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(id<TBAlert>)controller;
-@end
-@implementation TBActionSheet
-- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(id<TBAlert>)controller {
-    self = [super init];
-    if (self) {
-        self.controller = controller;
-        self.delegate   = self;
-        if (message)
-            self.title  = [NSString stringWithFormat:@"%@\n\n%@", title, message];
-        else
-            self.title  = title;
-    }
-    
-    return self;
+- (TBAlertButtonFlags)flagsAtIndex:(NSUInteger)index {
+    return ((const TBAlertButtonFlags *)_flags.bytes)[index];
+}
+
+- (uint32_t)serialAtIndex:(NSUInteger)index {
+    return ((const uint32_t *)_serials.bytes)[index];
+}
+
+/** @return The action the button at \c index was added as, or \c nil if it wasn't added as one. */
+- (TBAlertAction *)actionAtIndex:(NSUInteger)index {
+    return [self flagsAtIndex:index] & TBAlertButtonHasAction ? _handlers[index] : nil;
+}
+
+- (NSString *)titleAtIndex:(NSUInteger)index {
+    TBAlertAction *action = [self actionAtIndex:index];
+    return action ? action.title : _titles[index];
+}
+
+- (void)addTitle:(NSString *)title block:(TBAlertActionBlock)block enabled:(BOOL)enabled {
+    TBAlertButtonFlags flags = (enabled ? TBAlertButtonEnabled : 0) | (block ? TBAlertButtonHasBlock : 0);
+    [self appendTitle:TBAlertInternTitle(title) handler:[block copy] flags:flags];
+}
+
+- (void)addAction:(TBAlertAction *)action {
+    [self appendTitle:[NSNull null] handler:action flags:TBAlertButtonHasAction];
+}
+
+- (void)appendTitle:(id)title handler:(id)handler flags:(TBAlertButtonFlags)flags {
+    uint32_t serial = ++_lastSerial;
+    [_titles addObject:title];
+    [_flags appendBytes:&flags length:sizeof(flags)];
+    [_handlers addObject:handler ?: [NSNull null]];
+    [_serials appendBytes:&serial length:sizeof(serial)];
+}
+
+/** Only affects buttons that weren't added as actions. */
+- (void)setEnabled:(BOOL)enabled atIndex:(NSUInteger)index {
+    TBAlertButtonFlags *flags = (TBAlertButtonFlags *)_flags.mutableBytes + index;
+    *flags = enabled ? (*flags | TBAlertButtonEnabled) : (*flags & ~TBAlertButtonEnabled);
+}
+
+- (void)removeButtonAtIndex:(NSUInteger)index {
+    [_titles removeObjectAtIndex:index];
+    [_handlers removeObjectAtIndex:index];
+    [_flags replaceBytesInRange:NSMakeRange(index * sizeof(TBAlertButtonFlags), sizeof(TBAlertButtonFlags)) withBytes:NULL length:0];
+    [_serials replaceBytesInRange:NSMakeRange(index * sizeof(uint32_t), sizeof(uint32_t)) withBytes:NULL length:0];
 }
-- (void)actionSheet:(UIActionSheet *)actionSheet clickedButtonAtIndex:(NSInteger)buttonIndex {
-    [self.controller didDismissWithButtonIndex:buttonIndex];
+
+/** @return A new action for the button at \c index, which must not have been added as one. */
+- (TBAlertAction *)newActionForButtonAtIndex:(NSUInteger)index {
+    TBAlertButtonFlags flags = [self flagsAtIndex:index];
+    TBAlertAction *action = flags & TBAlertButtonHasBlock ?
+        [[TBAlertAction alloc] initWithTitle:_titles[index] block:_handlers[index]] :
+        [[TBAlertAction alloc] initWithTitle:_titles[index]];
+    action.enabled = (flags & TBAlertButtonEnabled) != 0;
+    return action;
 }
+
 @end
 
-#pragma mark - TBAlertController
+#pragma mark - TBAlertConfiguration
+
+/** Everything a presenter reads from a \c TBAlertController, except data source items, as it was at one moment.
+ The title and message aren't included: they may come from providers, which run only when they're read,
+ and changes to them are sent to the presentation directly instead of through a new configuration.
+ Its buttons and arrays are shared with the alert controller, which copies them before it changes them again. */
+@interface TBAlertConfiguration : NSObject {
+    @public
+    // Set once, by the alert controller while synchronized on itself
+    NSUInteger _version;
+    TBAlertButtonStore *_buttons;
+    TBAlertAction *_cancelAction;
+    NSInteger _destructiveButtonIndex;
+    UIAlertViewStyle _alertViewStyle;
+    NSArray *_textFieldHandlers;
+    NSArray *_addedTextFieldIdentifiers;
+}
+@end
+
+@implementation TBAlertConfiguration
+@end
 
-@interface TBAlertController () <TBAlert>
+#pragma mark - TBAlertController
 
-@property (nonatomic      ) id                inCaseOfManualDismissal;
-@property (nonatomic      ) TBAlertAction     *cancelAction;
-@property (nonatomic      ) NSMutableArray    *buttons;
-@property (nonatomic      ) NSMutableArray    *textFieldHandlers;
-@property (nonatomic, weak) id<TBPresentable> currentPresentation;
-@property (nonatomic, copy) void              (^completion)();
-/** An array of \c NSStrings containing the text in each of the alert controller's text views *after* it has been dismissed.
- This array is passed to each \c TBAlertActionBlock, so it is only necessary to access this property if you for some reason need to keep it around for later use. */
-@property (nonatomic) NSMutableArray *textFieldInputStrings;
+@interface TBAlertController ()
+
+@property (nonatomic, nullable) TBAlertAction *cancelAction;
+
+/** Indexes into the data source of the items matching \c filterText, or \c nil if there is no filter. */
+@property (nonatomic, nullable) NSData *filteredItems;
+/** Actions for data source items, created the first time each one is needed. */
+@property (nonatomic) NSMutableDictionary<NSNumber *, TBAlertAction *> *itemActions;
+/** Built the first time an item is looked up by identifier. */
+@property (nonatomic, nullable) NSDictionary<NSString *, NSNumber *> *itemIndexesByIdentifier;
+/** Retained until the alert controller is dismissed. */
+@property (nonatomic, nullable) id<TBAlertPresentation> currentPresentation;
+/** Built ahead of time by \c prepareForPresentation; discarded when the model changes. */
+@property (nonatomic, nullable) id<TBAlertPresentation> preparedPresentation;
+@property (nonatomic, weak, nullable) id<TBAlertPresenter> preparedPresenter;
+/** What \c preparedPresentation was built from; it's out of date once the configuration changes. */
+@property (nonatomic, nullable) TBAlertConfiguration *preparedConfiguration;
+/** Set by \c presentForResultFromViewController:cancellationToken:timeout:completion:
+ and released as soon as the alert is resolved. */
+@property (nonatomic, copy, nullable) void (^resultHandler)(TBAlertResult *result);
+@property (nonatomic, nullable) TBAlertCancellationToken *resultCancellationToken;
+@property (nonatomic, nullable) id<NSObject> resultCancellationRegistration;
+/** Used to present again when the current presentation cannot apply an update. */
+@property (nonatomic, weak, nullable) UIViewController *presentingViewController;
+
+/** The buttons as the current presentation shows them; used to compute updates,
+ and to map indexes from the presentation back to actions until it applies them.
+ @see \c keyForButtonAtIndex: */
+@property (nonatomic, nullable) NSArray *presentedButtons;
+@property (nonatomic, nullable) NSArray<NSString *> *presentedTitles;
+@property (nonatomic, nullable) NSArray<NSNumber *> *presentedStyles;
+@property (nonatomic, nullable) NSArray<NSNumber *> *presentedEnabledStates;
 
 @end
 
-@implementation TBAlertController
+NSString * const TBAlertControllerFilterTextFieldIdentifier = @"TBAlertControllerFilterTextField";
+NSString * const TBAlertControllerDidDismissNotification = @"TBAlertControllerDidDismissNotification";
+
+@implementation TBAlertController {
+    NSUInteger _numberOfItems;
+    /// Tokens from the shared deadline scheduler, or 0
+    NSUInteger _deadlineToken;
+    NSUInteger _resultTimeoutToken;
+    NSUInteger _presentedModelVersion;
+    BOOL _updateScheduled;
+    BOOL _presentingAgain;
+    /// Set while a presenter is presenting, and whether it answered for the user before it returned
+    BOOL _presenting;
+    BOOL _endedWhilePresenting;
+    
+    // The configuration. Synchronize on self to use any of it, from any thread.
+    /// Whether \c _title or \c _message holds the result of its provider
+    BOOL _titleProvided;
+    BOOL _messageProvided;
+    TBAlertButtonStore *_buttons;
+    /// Actions created for buttons that weren't added as actions, by serial number
+    NSMutableDictionary<NSNumber *, TBAlertAction *> *_buttonActions;
+    NSMutableArray *_textFieldHandlers;
+    /// Parallel to \c _textFieldHandlers, with \c NSNull for text fields without an identifier
+    NSMutableArray *_addedTextFieldIdentifiers;
+    /// Whether the buttons and arrays above are shared with \c _configuration and must be copied before they change
+    BOOL _buttonsShared;
+    BOOL _textFieldsShared;
+    /// Built on first access and discarded whenever the configuration changes
+    TBAlertConfiguration *_configuration;
+    NSArray<TBAlertAction *> *_cachedActions;
+    
+    /// Read instead of \c _configuration on the main thread while a presenter builds or updates a presentation
+    TBAlertConfiguration *_pinnedConfiguration;
+    /// Whether there is a current or prepared presentation to keep up to date; only changed on the main thread
+    _Atomic(BOOL) _hasPresentations;
+    
+    // Coalescing. Synchronize on self to use these, from any thread.
+    /// Alerts folded into this one, which get its decision; \c nil unless a coalescer may fold alerts into it
+    NSMutableArray<TBAlertController *> *_duplicates;
+    /// The alert this one was folded into, until that alert's decision is made or this one is dismissed
+    __weak TBAlertController *_foldedInto;
+}
+
+@synthesize title = _title, message = _message, modelVersion = _modelVersion;
+@synthesize destructiveButtonIndex = _destructiveButtonIndex, alertViewStyle = _alertViewStyle;
+@synthesize deadline = _deadline, deadlineButtonIndex = _deadlineButtonIndex, presenter = _presenter, identifier = _identifier;
+@synthesize titleProvider = _titleProvider, messageProvider = _messageProvider, cancelAction = _cancelAction;
+
+static id<TBAlertPresenter> _defaultPresenter = nil;
+
++ (id<TBAlertPresenter>)defaultPresenter {
+    if (!_defaultPresenter) {
+#if TB_HAS_UIKIT
+        _defaultPresenter = [TBUIKitAlertPresenter new];
+#else
+        _defaultPresenter = [TBHeadlessAlertPresenter new];
+#endif
+    }
+    
+    return _defaultPresenter;
+}
+
++ (void)setDefaultPresenter:(id<TBAlertPresenter>)defaultPresenter {
+    _defaultPresenter = defaultPresenter;
+}
+
+static TBAlertCoalescer *_coalescer = nil;
+
++ (TBAlertCoalescer *)coalescer {
+    return _coalescer;
+}
+
++ (void)setCoalescer:(TBAlertCoalescer *)coalescer {
+    _coalescer = coalescer;
+}
 
 + (instancetype)alertViewWithTitle:(NSString *)title message:(NSString *)message {
     return [[TBAlertController alloc] initWithTitle:title message:message style:TBAlertControllerStyleAlert];
@@ -133,13 +326,19 @@
 }
 
 - (instancetype)initWithStyle:(TBAlertControllerStyle)style {
+    // Alerts may be built off the main thread
+    static _Atomic(uint64_t) lastTraceIdentifier = 0;
+    
     self = [super init];
     if (self) {
+        _traceIdentifier = atomic_fetch_add_explicit(&lastTraceIdentifier, 1, memory_order_relaxed) + 1;
         _style = style;
-        _buttons = [NSMutableArray new];
+        _buttons = [TBAlertButtonStore new];
         _textFieldHandlers = [NSMutableArray new];
-        _textFieldInputStrings = [NSMutableArray new];
+        _addedTextFieldIdentifiers = [NSMutableArray new];
+        _itemActions = [NSMutableDictionary new];
         _destructiveButtonIndex = NSNotFound;
+        _deadlineButtonIndex = NSNotFound;
     }
     
     return self;
@@ -156,41 +355,335 @@
 }
 
 - (NSUInteger)numberOfButtons {
-    if (self.cancelAction)
-        return [self.buttons count] + 1;
-    
-    return [self.buttons count];
+    TBAlertConfiguration *configuration = self.configuration;
+    return configuration->_buttons.count + [self numberOfVisibleItems] + (configuration->_cancelAction ? 1 : 0);
+}
+
+/** Buttons added directly, then data source items; the cancel button comes after these. */
+- (NSUInteger)numberOfOtherButtons {
+    return self.configuration->_buttons.count + [self numberOfVisibleItems];
 }
 
 - (NSArray *)actions {
-    NSMutableArray *temp = [NSMutableArray arrayWithArray:self.buttons];
+    @synchronized (self) {
+        if (_cachedActions) {
+            return _cachedActions;
+        }
+    }
+    
+    // Built from one configuration, whatever other threads change meanwhile
+    TBAlertConfiguration *configuration = self.configuration;
+    NSUInteger items = [self numberOfVisibleItems];
+    TBAlertButtonStore *buttons = configuration->_buttons;
+    NSMutableArray *actions = [NSMutableArray arrayWithCapacity:buttons.count + items + 1];
+    @synchronized (self) {
+        for (NSUInteger i = 0; i < buttons.count; i++) {
+            [actions addObject:[self actionForButtonAtIndex:i ofStore:buttons]];
+        }
+    }
+    for (NSUInteger i = 0; i < items; i++) {
+        [actions addObject:[self actionForItemAtIndex:[self itemIndexAtPosition:i]]];
+    }
+    if (configuration->_cancelAction) {
+        [actions addObject:configuration->_cancelAction];
+    }
+    
+    @synchronized (self) {
+        if (configuration == _configuration) {
+            _cachedActions = actions;
+        }
+    }
+    
+    return actions;
+}
+
+- (id<TBAlertPresenter>)presenter {
+    @synchronized (self) {
+        return _presenter ?: [[self class] defaultPresenter];
+    }
+}
+
+- (void)setPresenter:(id<TBAlertPresenter>)presenter {
+    @synchronized (self) {
+        _presenter = presenter;
+    }
+    [self discardPreparedPresentation];
+}
+
+- (NSString *)identifier {
+    @synchronized (self) {
+        return _identifier;
+    }
+}
+
+- (void)setIdentifier:(NSString *)identifier {
+    identifier = identifier.copy;
+    @synchronized (self) {
+        _identifier = identifier;
+    }
+}
+
+- (NSTimeInterval)deadline {
+    @synchronized (self) {
+        return _deadline;
+    }
+}
+
+- (void)setDeadline:(NSTimeInterval)deadline {
+    @synchronized (self) {
+        _deadline = deadline;
+    }
+}
+
+- (NSUInteger)deadlineButtonIndex {
+    @synchronized (self) {
+        return _deadlineButtonIndex;
+    }
+}
+
+- (void)setDeadlineButtonIndex:(NSUInteger)deadlineButtonIndex {
+    @synchronized (self) {
+        _deadlineButtonIndex = deadlineButtonIndex;
+    }
+}
+
+- (NSUInteger)modelVersion {
+    @synchronized (self) {
+        return _modelVersion;
+    }
+}
+
+#pragma mark Configuration
+
+- (TBAlertConfiguration *)configuration {
+    if (NSThread.isMainThread && _pinnedConfiguration) {
+        return _pinnedConfiguration;
+    }
+    
+    @synchronized (self) {
+        if (!_configuration) {
+            TBAlertConfiguration *configuration = [TBAlertConfiguration new];
+            configuration->_version = _modelVersion;
+            configuration->_buttons = _buttons;
+            configuration->_cancelAction = _cancelAction;
+            configuration->_destructiveButtonIndex = _destructiveButtonIndex;
+            configuration->_alertViewStyle = _alertViewStyle;
+            configuration->_textFieldHandlers = _textFieldHandlers;
+            configuration->_addedTextFieldIdentifiers = _addedTextFieldIdentifiers;
+            _buttonsShared = YES;
+            _textFieldsShared = YES;
+            _configuration = configuration;
+        }
+        
+        return _configuration;
+    }
+}
+
+/** Call while synchronized on \c self, after changing any part of the configuration. */
+- (void)configurationDidChange {
+    _modelVersion++;
+    _configuration = nil;
+    _cachedActions = nil;
+    
+    // The main thread sees its own changes right away, even while a configuration is pinned
+    if (NSThread.isMainThread) {
+        _pinnedConfiguration = nil;
+    }
+}
+
+/** @return \c _buttons, copied first if a configuration shares it. Call while synchronized on \c self. */
+- (TBAlertButtonStore *)writableButtons {
+    if (_buttonsShared) {
+        _buttons = _buttons.mutableCopy;
+        _buttonsShared = NO;
+    }
+    
+    return _buttons;
+}
+
+/** @return The action for the button at \c index of \c buttons, created the first time it's needed.
+ Call while synchronized on \c self. */
+- (TBAlertAction *)actionForButtonAtIndex:(NSUInteger)index ofStore:(TBAlertButtonStore *)buttons {
+    TBAlertAction *action = [self existingActionForButtonAtIndex:index ofStore:buttons];
+    if (!action) {
+        action = [buttons newActionForButtonAtIndex:index];
+        if (!_buttonActions) {
+            _buttonActions = [NSMutableDictionary new];
+        }
+        _buttonActions[@([buttons serialAtIndex:index])] = action;
+    }
+    
+    return action;
+}
+
+/** @return The action for the button at \c index of \c buttons, or \c nil if one hasn't been created yet.
+ Call while synchronized on \c self. */
+- (TBAlertAction *)existingActionForButtonAtIndex:(NSUInteger)index ofStore:(TBAlertButtonStore *)buttons {
+    TBAlertAction *action = [buttons actionAtIndex:index];
+    if (action || !_buttonActions) {
+        return action;
+    }
     
-    if (self.cancelAction)
-        [temp addObject:self.cancelAction];
+    return _buttonActions[@([buttons serialAtIndex:index])];
+}
+
+/** Copies the text field arrays if a configuration shares them. Call while synchronized on \c self. */
+- (void)makeTextFieldsWritable {
+    if (_textFieldsShared) {
+        _textFieldHandlers = _textFieldHandlers.mutableCopy;
+        _addedTextFieldIdentifiers = _addedTextFieldIdentifiers.mutableCopy;
+        _textFieldsShared = NO;
+    }
+}
+
+/** Has everything on the main thread read \c configuration while \c block runs, so that a presenter
+ sees the alert as it was when it started, whatever other threads change meanwhile. */
+- (void)pinConfiguration:(TBAlertConfiguration *)configuration during:(TBVoidBlock)block {
+    TBAlertConfiguration *previous = _pinnedConfiguration;
+    _pinnedConfiguration = configuration;
+    block();
     
-    return [temp copy];
+    // Unless the main thread changed the configuration itself, which unpins it
+    if (_pinnedConfiguration == configuration) {
+        _pinnedConfiguration = previous;
+    }
 }
 
 #pragma mark Updatable properties
 
+/** @return \c *string, or the result of \c *provider if there is one, which is kept.
+ The provider is called without holding the lock, since it may well use the alert too. */
+static NSString *TBAlertResolveString(TBAlertController *alert, NSString * __strong *string,
+                                      TBAlertStringProvider __strong *provider, BOOL *provided) {
+    for (;;) {
+        TBAlertStringProvider pending = nil;
+        @synchronized (alert) {
+            if (!*provider || *provided) {
+                return *string;
+            }
+            pending = *provider;
+        }
+        
+        NSString *result = [pending() copy];
+        @synchronized (alert) {
+            // Unless another thread replaced the provider meanwhile
+            if (pending == *provider && !*provided) {
+                *string = result;
+                *provided = YES;
+            }
+        }
+    }
+}
+
+- (NSString *)title {
+    return TBAlertResolveString(self, &_title, &_titleProvider, &_titleProvided);
+}
+
+- (NSString *)message {
+    return TBAlertResolveString(self, &_message, &_messageProvider, &_messageProvided);
+}
+
 - (void)setTitle:(NSString *)title {
-    _title = title;
-    if (self.currentPresentation) {
-        self.currentPresentation.title = title;
+    @synchronized (self) {
+        _titleProvider = nil;
+        _title = title.copy;
+        _modelVersion++;
     }
+    [self titleDidChange];
 }
 
 - (void)setMessage:(NSString *)message {
-    _message = message;
-    if (self.currentPresentation) {
-        if ([self.currentPresentation respondsToSelector:@selector(setMessage:)]) {
-            self.currentPresentation.message = message;
+    @synchronized (self) {
+        _messageProvider = nil;
+        _message = message.copy;
+        _modelVersion++;
+    }
+    [self messageDidChange];
+}
+
+- (TBAlertStringProvider)titleProvider {
+    @synchronized (self) {
+        return _titleProvider;
+    }
+}
+
+- (TBAlertStringProvider)messageProvider {
+    @synchronized (self) {
+        return _messageProvider;
+    }
+}
+
+- (void)setTitleProvider:(TBAlertStringProvider)titleProvider {
+    @synchronized (self) {
+        _titleProvider = [titleProvider copy];
+        _titleProvided = NO;
+        _modelVersion++;
+    }
+    [self titleDidChange];
+}
+
+- (void)setMessageProvider:(TBAlertStringProvider)messageProvider {
+    @synchronized (self) {
+        _messageProvider = [messageProvider copy];
+        _messageProvided = NO;
+        _modelVersion++;
+    }
+    [self messageDidChange];
+}
+
+/** Brings presentations up to date with \c title, which is only resolved if there is one. */
+- (void)titleDidChange {
+    [self updatePresentations:^{
+        if (self.currentPresentation) {
+            self.currentPresentation.title = self.title;
+        }
+        if (self.preparedPresentation) {
+            self.preparedPresentation.title = self.title;
+        }
+    }];
+}
+
+/** Brings presentations up to date with \c message, which is only resolved if there is one. */
+- (void)messageDidChange {
+    [self updatePresentations:^{
+        if (self.currentPresentation) {
+            if ([self.currentPresentation respondsToSelector:@selector(setMessage:)]) {
+                self.currentPresentation.message = self.message;
+            }
         }
+        if (self.preparedPresentation) {
+            if ([self.preparedPresentation respondsToSelector:@selector(setMessage:)]) {
+                self.preparedPresentation.message = self.message;
+            } else {
+                // Can't be brought up to date, so it's no good anymore
+                self.preparedPresentation = nil;
+            }
+        }
+    }];
+}
+
+- (void)setPopoverSourceView:(UIView *)popoverSourceView {
+    @synchronized (self) {
+        _popoverSourceView = popoverSourceView;
+        [self configurationDidChange];
     }
+    [self discardPreparedPresentation];
 }
 
 #pragma mark Cancel button
 
+- (TBAlertAction *)cancelAction {
+    return self.configuration->_cancelAction;
+}
+
+- (void)setCancelAction:(TBAlertAction *)cancelAction {
+    @synchronized (self) {
+        _cancelAction = cancelAction;
+        [self configurationDidChange];
+    }
+    [self scheduleUpdate];
+}
+
 - (void)setCancelButton:(TBAlertAction *)button {
     self.cancelAction = button;
 }
@@ -213,9 +706,13 @@
 }
 
 - (void)setCancelButtonEnabled:(BOOL)enabled {
-    NSAssert([UIAlertController class], @"Buttons can only be disabled on iOS 8.");
-    NSAssert(self.cancelAction, @"Cancel button was never set, cannot enable or disable it.");
-    self.cancelAction.enabled = enabled;
+    NSAssert(TBAlertControllerIsAvailable(), @"Buttons can only be disabled on iOS 8.");
+    @synchronized (self) {
+        NSAssert(_cancelAction, @"Cancel button was never set, cannot enable or disable it.");
+        _cancelAction.enabled = enabled;
+        [self configurationDidChange];
+    }
+    [self scheduleUpdate];
 }
 
 - (void)removeCancelButton {
@@ -225,10 +722,18 @@
 #pragma mark Destructive button
 
 - (void)setDestructiveButtonIndex:(NSInteger)destructiveButtonIndex {
-    if (![UIAlertController class])
+    if (!TBAlertControllerIsAvailable())
         NSAssert(self.style == TBAlertControllerStyleActionSheet, @"Only alert contorllers of style TBAlertControllerStyleActionSheet can have destructive buttons on iOS 7.");
     
-    _destructiveButtonIndex = destructiveButtonIndex;
+    @synchronized (self) {
+        _destructiveButtonIndex = destructiveButtonIndex;
+        [self configurationDidChange];
+    }
+    [self scheduleUpdate];
+}
+
+- (NSInteger)destructiveButtonIndex {
+    return self.configuration->_destructiveButtonIndex;
 }
 
 #pragma mark Other buttons
@@ -238,421 +743,1199 @@
 }
 
 - (void)addOtherButton:(TBAlertAction *)button {
-    [self.buttons addObject:button];
+    NSParameterAssert(button);
+    
+    @synchronized (self) {
+        [self.writableButtons addAction:button];
+        [self configurationDidChange];
+    }
+    [self scheduleUpdate];
 }
 
 - (void)addOtherButtonWithTitle:(NSString *)title {
     NSParameterAssert(title);
     
-    TBAlertAction *button = [[TBAlertAction alloc] initWithTitle:title];
-    [self.buttons addObject:button];
+    [self addOtherButtonWithTitle:title enabled:YES buttonAction:nil];
 }
 
 - (void)addOtherButtonWithTitle:(NSString *)title target:(id)target action:(SEL)action {
     NSParameterAssert(title); NSParameterAssert(target); NSParameterAssert(action);
     
     TBAlertAction *button = [[TBAlertAction alloc] initWithTitle:title target:target action:action];
-    [self.buttons addObject:button];
+    [self addOtherButton:button];
 }
 
 - (void)addOtherButtonWithTitle:(NSString *)title target:(id)target action:(SEL)action withObject:(id)object {
     NSParameterAssert(title); NSParameterAssert(target); NSParameterAssert(action);
     
     TBAlertAction *button = [[TBAlertAction alloc] initWithTitle:title target:target action:action object:object];
-    [self.buttons addObject:button];
+    [self addOtherButton:button];
 }
 
 - (void)addOtherButtonWithTitle:(NSString *)title buttonAction:(void(^)(NSArray *textFieldStrings))buttonBlock {
     NSParameterAssert(title); NSParameterAssert(buttonBlock);
     
-    TBAlertAction *button = [[TBAlertAction alloc] initWithTitle:title block:buttonBlock];
-    [self.buttons addObject:button];
+    [self addOtherButtonWithTitle:title enabled:YES buttonAction:buttonBlock];
 }
 
-- (void)setButtonEnabled:(BOOL)enabled atIndex:(NSUInteger)buttonIndex {
-    NSAssert([UIAlertController class], @"Buttons can only be disabled on iOS 8.");
-    
-    // Cancel button
-    if (buttonIndex == [self.buttons count]) {
-        NSAssert(self.cancelAction, @"Invalid button index; out of bounds.");
-        self.cancelAction.enabled = enabled;
+/** Adds a button without creating an action for it. */
+- (uint32_t)addOtherButtonWithTitle:(NSString *)title enabled:(BOOL)enabled buttonAction:(TBAlertActionBlock)buttonBlock {
+    uint32_t serial;
+    @synchronized (self) {
+        TBAlertButtonStore *buttons = self.writableButtons;
+        [buttons addTitle:title block:buttonBlock enabled:enabled];
+        serial = [buttons serialAtIndex:buttons.count - 1];
+        [self configurationDidChange];
     }
-    else
-        [self.buttons[buttonIndex] setEnabled:enabled];
+    [self scheduleUpdate];
+    
+    return serial;
 }
 
-- (void)removeButtonAtIndex:(NSUInteger)buttonIndex {
-    if (buttonIndex == self.buttons.count) {
-        NSAssert(self.cancelAction, @"Invalid button index; out of bounds.");
-        [self removeCancelButton];
-    }
-    else {
-        [self.buttons removeObjectAtIndex:buttonIndex];
+- (TBAlertAction *)actionForButtonWithSerial:(uint32_t)serial {
+    @synchronized (self) {
+        TBAlertButtonStore *buttons = _buttons;
+        for (NSUInteger i = 0; i < buttons.count; i++) {
+            if ([buttons serialAtIndex:i] == serial) {
+                return [self actionForButtonAtIndex:i ofStore:buttons];
+            }
+        }
     }
-}
-
-#pragma mark Text fields
-
-- (void)addTextFieldWithConfigurationHandler:(void (^)(UITextField *textField))configurationHandler {
-    NSAssert([UIAlertController class], @"Adding individual text fields is only supported on iOS 8. Use alertViewStyle instead.");
-    NSParameterAssert(configurationHandler);
-    NSAssert(self.style == TBAlertControllerStyleAlert,
-             @"Text fields can only be added to alert controllers of style TBAlertControllerStyleAlert.");
     
-    [self.textFieldHandlers addObject:configurationHandler];
+    return nil;
 }
 
-- (void)setAlertViewStyle:(UIAlertViewStyle)alertViewStyle {
-    NSAssert(self.style == TBAlertControllerStyleAlert,
-             @"Text fields can only be added to alert controllers of style TBAlertControllerStyleAlert.");
-    
-    _alertViewStyle = alertViewStyle;
+- (void)addOtherButtonsWithTitles:(NSArray<NSString *> *)titles {
+    [self addOtherButtonsWithTitles:titles buttonActions:nil];
 }
 
-- (void)getTextFromTextFields:(NSArray *)textFields {
-    for (UITextField *textField in textFields)
-        [self.textFieldInputStrings addObject:textField.text];
+- (void)addOtherButtonsWithTitles:(NSArray<NSString *> *)titles buttonActions:(NSArray<TBAlertActionBlock> *)buttonBlocks {
+    NSParameterAssert(titles);
+    NSParameterAssert(!buttonBlocks || buttonBlocks.count == titles.count);
+    
+    @synchronized (self) {
+        [self reserveCapacityForOtherButtons:titles.count];
+        for (NSUInteger i = 0; i < titles.count; i++) {
+            [_buttons addTitle:titles[i] block:buttonBlocks[i] enabled:YES];
+        }
+        [self configurationDidChange];
+    }
+    [self scheduleUpdate];
 }
 
-#pragma mark Displaying (iOS 8)
-
-- (void)showFromViewController:(UIViewController *)viewController {
-    [self showFromViewController:viewController animated:YES completion:nil];
+- (void)reserveCapacityForOtherButtons:(NSUInteger)count {
+    // A copy made with room to spare is one nobody else shares
+    @synchronized (self) {
+        _buttons = [_buttons copyWithCapacity:_buttons.count + count];
+        _buttonsShared = NO;
+    }
 }
 
-- (void)showFromViewController:(UIViewController *)viewController animated:(BOOL)animated completion:(TBVoidBlock)completion {
-    // iOS 8+
-    if ([UIAlertController class]) {
-        NSUInteger i = 0;
-        NSMutableArray *actions = [NSMutableArray new];
-        UIAlertController *alertController = [UIAlertController
-            alertControllerWithTitle:self.title
-            message:self.message
-            preferredStyle:(UIAlertControllerStyle)self.style
-        ];
-        self.inCaseOfManualDismissal = alertController;
-        
-        // Add text fields
-        switch (self.alertViewStyle) {
-                
-            case UIAlertViewStyleLoginAndPasswordInput: { // Login
-                [alertController addTextFieldWithConfigurationHandler:^(UITextField *textField) {
-                    textField.placeholder = @"Login";
-                }];
-                [alertController addTextFieldWithConfigurationHandler:^(UITextField *textField) {
-                    textField.placeholder = @"Password";
-                    textField.secureTextEntry = YES;
-                }];
-                break;
-            }
-            case UIAlertViewStylePlainTextInput: { // Plaintext
-                [alertController addTextFieldWithConfigurationHandler:nil];
-                break;
-            }
-            case UIAlertViewStyleSecureTextInput: { // Secure text
-                [alertController addTextFieldWithConfigurationHandler:^(UITextField *textField) {
-                    textField.secureTextEntry = YES;
-                }];
-                break;
-            }
-            case UIAlertViewStyleDefault:;
-        }
-        
-        for (id handler in self.textFieldHandlers) {
-            [alertController addTextFieldWithConfigurationHandler:handler];
-        }
-        
-        
-        // "Other button" actions
-        for (TBAlertAction *button in self.buttons) {
-            UIAlertActionStyle style = (i == self.destructiveButtonIndex) ?
-                UIAlertActionStyleDestructive : UIAlertActionStyleDefault;
-            [actions addObject:[self actionFromAlertAction:button withStyle:style controller:alertController]];
-            i++;
-        }
-        
-        // Cancel action
-        if (self.cancelAction) {
-            [actions addObject:[self
-                actionFromAlertAction:self.cancelAction
-                withStyle:UIAlertActionStyleCancel
-                controller:alertController
-            ]];
-        }
-        
-        // Add actions to alert controller
-        for (UIAlertAction *action in actions) {
-            [alertController addAction:action];
-        }
-        
-        // Handle source view / bar item for action sheets
-        id viewOrBarItem = self.popoverSourceView;
-        
-        if ([viewOrBarItem isKindOfClass:[UIBarButtonItem class]]) {
-            alertController.popoverPresentationController.barButtonItem = viewOrBarItem;
-        } else if ([viewOrBarItem isKindOfClass:[UIView class]]) {
-            alertController.popoverPresentationController.sourceView = viewOrBarItem;
-            alertController.popoverPresentationController.sourceRect = [viewOrBarItem bounds];
-        } else if (viewOrBarItem) {
-            NSParameterAssert(
-                [viewOrBarItem isKindOfClass:[UIBarButtonItem class]] ||
-                [viewOrBarItem isKindOfClass:[UIView class]] ||
-                !viewOrBarItem
-            );
+- (void)setButtonEnabled:(BOOL)enabled atIndex:(NSUInteger)buttonIndex {
+    NSAssert(TBAlertControllerIsAvailable(), @"Buttons can only be disabled on iOS 8.");
+    
+    @synchronized (self) {
+        if (buttonIndex < _buttons.count) {
+            // Presenters read the action instead once there is one
+            [self existingActionForButtonAtIndex:buttonIndex ofStore:_buttons].enabled = enabled;
+            [self.writableButtons setEnabled:enabled atIndex:buttonIndex];
+        } else {
+            [self buttonAtIndex:buttonIndex].enabled = enabled;
         }
-        
-        self.currentPresentation = (id)alertController;
-        [viewController presentViewController:alertController animated:animated completion:completion];
-        
+        [self configurationDidChange];
     }
-    // iOS 7 or earlier
-    else {
-        self.completion = [completion copy];
-        
-        // Alert view
-        if (self.style == TBAlertControllerStyleAlert) {
-            [self show];
+    [self scheduleUpdate];
+}
+
+- (void)removeButtonAtIndex:(NSUInteger)buttonIndex {
+    @synchronized (self) {
+        if (buttonIndex < _buttons.count) {
+            [_buttonActions removeObjectForKey:@([_buttons serialAtIndex:buttonIndex])];
+            [self.writableButtons removeButtonAtIndex:buttonIndex];
         }
-        
-        // Action sheet
-        else if (self.style == TBAlertControllerStyleActionSheet) {
-            [self showInView:[viewController.view window]];
+        else {
+            NSAssert([self itemIndexForButtonAtIndex:buttonIndex] == NSNotFound,
+                     @"Data source items cannot be removed directly. Remove them from the data source and call reloadData.");
+            NSAssert(buttonIndex == [self numberOfOtherButtons] && _cancelAction, @"Invalid button index; out of bounds.");
+            _cancelAction = nil;
         }
+        [self configurationDidChange];
     }
+    [self scheduleUpdate];
 }
 
-#pragma mark Displaying (iOS 7)
-
-- (void)show {
-    NSAssert(
-        self.style == TBAlertControllerStyleAlert,
-        @"You can only call \"show\" on an alert controller of style "
-        "TBAlertControllerStyleAlert. \"show\" is also depricated on iOS 8."
-    );
-    
-    TBAlertView *alert = [[TBAlertView alloc]
-        initWithTitle:self.title
-        message:self.message
-        controller:self
-    ];
-    self.inCaseOfManualDismissal = alert;
+- (TBAlertAction *)buttonWithIdentifier:(NSString *)identifier {
+    NSParameterAssert(identifier);
     
-    // Add buttons
-    for (TBAlertAction *button in self.buttons) {
-        NSString *title = button.title;
-        [alert addButtonWithTitle:title];
+    // Only actions that exist can have been given an identifier
+    TBAlertConfiguration *configuration = self.configuration;
+    TBAlertButtonStore *buttons = configuration->_buttons;
+    @synchronized (self) {
+        for (NSUInteger i = 0; i < buttons.count; i++) {
+            TBAlertAction *button = [self existingActionForButtonAtIndex:i ofStore:buttons];
+            if ([button.identifier isEqualToString:identifier]) {
+                return button;
+            }
+        }
     }
-    
-    // Add cancel button
-    if (self.cancelAction) {
-        [alert addButtonWithTitle:self.cancelAction.title];
-        [alert setCancelButtonIndex:alert.numberOfButtons-1];
+    if ([configuration->_cancelAction.identifier isEqualToString:identifier]) {
+        return configuration->_cancelAction;
     }
     
-    // Text views
-    alert.alertViewStyle = self.alertViewStyle;
-    
-    self.currentPresentation = (id)alert;
-    [alert show];
-    
-    // Completion block
-    if (self.completion)
-        self.completion();
+    NSNumber *item = self.itemIndexesByIdentifier[identifier];
+    return item ? [self actionForItemAtIndex:item.unsignedIntegerValue] : nil;
 }
 
-- (void)showInView:(UIView *)view {
-    NSAssert(
-        self.style == TBAlertControllerStyleActionSheet,
-        @"You can only call \"showInView:\" on an alert controller of style "
-        "TBAlertControllerStyleActionSheet. \"showInView:\" is also depricated on iOS 8."
-    );
+#pragma mark Data source
+
+- (void)setDataSource:(id<TBAlertControllerDataSource>)dataSource {
+    _dataSource = dataSource;
+    [self reloadData];
+}
+
+- (void)reloadData {
+    id<TBAlertControllerDataSource> dataSource = self.dataSource;
+    _numberOfItems = dataSource ? [dataSource numberOfItemsInAlertController:self] : 0;
     
-    TBActionSheet *actionSheet = [[TBActionSheet alloc]
-        initWithTitle:self.title
-        message:self.message
-        controller:self
-    ];
-    self.inCaseOfManualDismissal = actionSheet;
+    [self.itemActions removeAllObjects];
+    self.itemIndexesByIdentifier = nil;
+    [self filterItemsNarrowing:NO];
+    [self setNeedsUpdate];
+}
+
+- (void)setFilterText:(NSString *)filterText {
+    NSString *previous = _filterText;
+    _filterText = filterText.length ? filterText.copy : nil;
     
-    // Add buttons
-    for (TBAlertAction *button in self.buttons) {
-        NSString *title = button.title;
-        [actionSheet addButtonWithTitle:title];
+    // Typing more only ever narrows the list, so only the items still shown need another look
+    BOOL narrowing = previous && _filterText && [_filterText
+        rangeOfString:previous
+        options:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSAnchoredSearch
+    ].location != NSNotFound;
+    
+    [self filterItemsNarrowing:narrowing];
+    [self setNeedsUpdate];
+}
+
+- (void)addFilterTextFieldWithPlaceholder:(NSString *)placeholder {
+    __weak TBAlertController *weakSelf = self;
+    [self addTextFieldWithIdentifier:TBAlertControllerFilterTextFieldIdentifier configurationHandler:^(UITextField *textField) {
+        textField.placeholder = placeholder;
+        // Presenting again after a change in the filter shouldn't clear it
+        textField.text = weakSelf.filterText;
+    }];
+}
+
+- (void)filterItemsNarrowing:(BOOL)narrowing {
+    NSString *filter = self.filterText;
+    if (!filter || !_numberOfItems) {
+        self.filteredItems = nil;
+        return;
     }
-    // Cancel button
-    if (self.cancelAction) {
-        [actionSheet addButtonWithTitle:self.cancelAction.title];
-        actionSheet.cancelButtonIndex = actionSheet.numberOfButtons-1;
+    
+    NSData *candidates = narrowing ? self.filteredItems : nil;
+    const NSUInteger *candidateItems = candidates.bytes;
+    NSUInteger count = candidates ? candidates.length / sizeof(NSUInteger) : _numberOfItems;
+    NSMutableData *matches = [NSMutableData dataWithCapacity:count * sizeof(NSUInteger)];
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NSUInteger item = candidateItems ? candidateItems[i] : i;
+        if ([self itemAtIndex:item matchesFilter:filter]) {
+            [matches appendBytes:&item length:sizeof(NSUInteger)];
+        }
     }
-    // Destructive button index
-    if (self.destructiveButtonIndex > -1) {
-        actionSheet.destructiveButtonIndex = self.destructiveButtonIndex;
+    
+    self.filteredItems = matches;
+}
+
+- (BOOL)itemAtIndex:(NSUInteger)item matchesFilter:(NSString *)filter {
+    id<TBAlertControllerDataSource> dataSource = self.dataSource;
+    if ([dataSource respondsToSelector:@selector(alertController:itemAtIndex:matchesFilter:)]) {
+        return [dataSource alertController:self itemAtIndex:item matchesFilter:filter];
     }
     
-    // show
-    self.currentPresentation = (id)actionSheet;
-    [actionSheet showInView:view];
+    return [[self titleForItemAtIndex:item]
+        rangeOfString:filter options:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch
+    ].location != NSNotFound;
+}
+
+- (NSUInteger)numberOfVisibleItems {
+    return self.filteredItems ? self.filteredItems.length / sizeof(NSUInteger) : _numberOfItems;
+}
+
+/** @return The index into the data source of the item shown at \c buttonIndex, or \c NSNotFound if it isn't an item. */
+- (NSUInteger)itemIndexForButtonAtIndex:(NSUInteger)buttonIndex {
+    NSUInteger offset = self.configuration->_buttons.count;
+    if (buttonIndex < offset || buttonIndex - offset >= [self numberOfVisibleItems]) {
+        return NSNotFound;
+    }
     
-    // Completion block
-    if (self.completion) {
-        self.completion();
+    return [self itemIndexAtPosition:buttonIndex - offset];
+}
+
+/** @return The index into the data source of the visible item at \c position. */
+- (NSUInteger)itemIndexAtPosition:(NSUInteger)position {
+    return self.filteredItems ? ((const NSUInteger *)self.filteredItems.bytes)[position] : position;
+}
+
+- (NSString *)titleForItemAtIndex:(NSUInteger)item {
+    return self.itemActions[@(item)].title ?: [self.dataSource alertController:self titleForItemAtIndex:item];
+}
+
+- (NSString *)identifierForItemAtIndex:(NSUInteger)item {
+    id<TBAlertControllerDataSource> dataSource = self.dataSource;
+    if ([dataSource respondsToSelector:@selector(alertController:identifierForItemAtIndex:)]) {
+        return [dataSource alertController:self identifierForItemAtIndex:item];
     }
+    
+    return nil;
 }
 
-#pragma mark Dismissing
+- (NSDictionary<NSString *, NSNumber *> *)itemIndexesByIdentifier {
+    if (!_itemIndexesByIdentifier) {
+        NSMutableDictionary *indexes = [NSMutableDictionary new];
+        if ([self.dataSource respondsToSelector:@selector(alertController:identifierForItemAtIndex:)]) {
+            for (NSUInteger i = 0; i < _numberOfItems; i++) {
+                NSString *identifier = [self identifierForItemAtIndex:i];
+                if (identifier) {
+                    indexes[identifier] = @(i);
+                }
+            }
+        }
+        
+        _itemIndexesByIdentifier = indexes.copy;
+    }
+    
+    return _itemIndexesByIdentifier;
+}
 
-- (void)dismiss {
-    self.currentPresentation = nil;
+- (TBAlertAction *)actionForItemAtIndex:(NSUInteger)item {
+    NSNumber *key = @(item);
+    TBAlertAction *action = self.itemActions[key];
+    
+    if (!action) {
+        __weak TBAlertController *weakSelf = self;
+        action = [[TBAlertAction alloc] initWithTitle:[self titleForItemAtIndex:item] block:^(NSArray *strings) {
+            TBAlertController *alert = weakSelf;
+            [alert.dataSource alertController:alert didSelectItemAtIndex:item];
+        }];
+        action.identifier = [self identifierForItemAtIndex:item];
+        self.itemActions[key] = action;
+    }
+    
+    return action;
+}
+
+#pragma mark Text fields
+
+- (void)addTextFieldWithConfigurationHandler:(void (^)(UITextField *textField))configurationHandler {
+    [self addTextFieldWithIdentifier:nil configurationHandler:configurationHandler];
+}
+
+- (void)addTextFieldWithIdentifier:(NSString *)identifier configurationHandler:(void (^)(UITextField *textField))configurationHandler {
+    NSAssert(TBAlertControllerIsAvailable(), @"Adding individual text fields is only supported on iOS 8. Use alertViewStyle instead.");
+    NSParameterAssert(configurationHandler);
+    NSAssert(self.style == TBAlertControllerStyleAlert,
+             @"Text fields can only be added to alert controllers of style TBAlertControllerStyleAlert.");
     
-    if ([UIAlertController class]) {
-        [self getTextFromTextFields:[(UIAlertController *)self.inCaseOfManualDismissal textFields]];
-        [(UIAlertController *)self.inCaseOfManualDismissal dismissViewControllerAnimated:YES completion:nil];
+    @synchronized (self) {
+        [self makeTextFieldsWritable];
+        [_textFieldHandlers addObject:configurationHandler];
+        [_addedTextFieldIdentifiers addObject:identifier ?: (id)[NSNull null]];
+        [self configurationDidChange];
     }
-    else {
-        [self dismissWithButtonIndex:0];
+    [self discardPreparedPresentation];
+}
+
+- (void)setAlertViewStyle:(UIAlertViewStyle)alertViewStyle {
+    NSAssert(self.style == TBAlertControllerStyleAlert,
+             @"Text fields can only be added to alert controllers of style TBAlertControllerStyleAlert.");
+    
+    @synchronized (self) {
+        _alertViewStyle = alertViewStyle;
+        [self configurationDidChange];
     }
+    [self discardPreparedPresentation];
 }
 
-- (void)dismissWithButtonIndex:(NSUInteger)index {
-    self.currentPresentation = nil;
+- (UIAlertViewStyle)alertViewStyle {
+    return self.configuration->_alertViewStyle;
+}
+
+- (TBAlertTextFieldValues *)textFieldValuesFromPresentation:(id<TBAlertPresentation>)presentation {
+    NSArray *textFields = presentation.textFields;
+    NSArray *identifiers = self.textFieldIdentifiers;
     
-    // Button 0 with no actions defaults to [self dismiss]
-    if (index == 0 && self.buttons.count == 0) {
-        [self dismiss];
+    // Fall back to index-only lookup if the presentation doesn't match our configuration
+    if (identifiers.count != textFields.count) {
+        identifiers = nil;
+    }
+    
+    return [[TBAlertTextFieldValues alloc] initWithTextFields:textFields identifiers:identifiers];
+}
+
+#pragma mark Displaying
+
+- (void)showFromViewController:(UIViewController *)viewController {
+    [self showFromViewController:viewController animated:YES completion:nil];
+}
+
+- (void)showFromAutomaticPresenter {
+    [self showFromAutomaticPresenterAnimated:YES completion:nil];
+}
+
+- (void)showFromAutomaticPresenterAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    // The hierarchy is only safe to walk on the main thread
+    if (!NSThread.isMainThread) {
+        [self performOnMainThread:^{
+            [self showFromAutomaticPresenterAnimated:animated completion:completion];
+        }];
         return;
     }
     
-    if ([UIAlertController class]) {
-        TBAlertAction *action = self.actions[index];
-        [self dismiss];
-        if (action.enabled) {
-            [action perform:self.textFieldInputStrings.copy];
+    id node = TBPresentingViewControllerResolver.sharedResolver.automaticPresentingNode;
+    UIViewController *viewController = [node isKindOfClass:[UIViewController class]] ? node : nil;
+    [self showFromViewController:viewController animated:animated completion:completion];
+}
+
+- (void)showFromViewController:(UIViewController *)viewController animated:(BOOL)animated completion:(TBVoidBlock)completion {
+    // Checked before hopping to the main thread, so that a storm of duplicates never gets there
+    if ([_coalescer coalesceAlert:self]) {
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), completion);
         }
+        return;
     }
-    else {
-        id toDismiss = self.inCaseOfManualDismissal;
-        switch (self.style) {
-            case TBAlertControllerStyleActionSheet: {
-                [(UIActionSheet *)toDismiss dismissWithClickedButtonIndex:index animated:YES];
-                break;
-            }
-            case TBAlertControllerStyleAlert: {
-                [(UIAlertView *)toDismiss dismissWithClickedButtonIndex:index animated:YES];
-                break;
-            }
+    
+    if (!NSThread.isMainThread) {
+        [self performOnMainThread:^{
+            [self showFromViewController:viewController animated:animated completion:completion];
+        }];
+        return;
+    }
+    
+    id<TBAlertPresenter> presenter = self.presenter;
+    id<TBAlertPresentation> prepared = self.isPreparedForPresentation ? self.preparedPresentation : nil;
+    self.preparedPresentation = nil;
+    
+    TBAlertConfiguration *configuration = self.configuration;
+    __block BOOL failed = NO;
+    [self pinConfiguration:configuration during:^{
+        // Snapshot the buttons first, in case the presenter calls back synchronously
+        [self recordPresentedButtons];
+        [self scheduleDeadline];
+        self.presentingViewController = viewController;
+        
+        uint64_t traceIdentifier = self.traceIdentifier;
+        TBVoidBlock presented = completion;
+        TBAlertTraceEmit(traceIdentifier, TBAlertTraceEventPresent, TBAlertTracePhaseBegin);
+        if (TBAlertTraceIsEnabled()) {
+            presented = ^{
+                TBAlertTraceEmit(traceIdentifier, TBAlertTraceEventVisible, TBAlertTracePhaseInstant);
+                if (completion) completion();
+            };
+        }
+        
+        // A presenter may answer for the user before it returns, such as a scripted one; a button's
+        // action may even show the alert again, which is why the outer state is put back afterwards
+        BOOL wasPresenting = self->_presenting, endedWhilePresenting = self->_endedWhilePresenting;
+        self->_presenting = YES;
+        self->_endedWhilePresenting = NO;
+        
+        id<TBAlertPresentation> presentation = nil;
+        if (prepared) {
+            presentation = [presenter
+                presentAlert:self
+                preparedPresentation:prepared
+                fromViewController:viewController
+                animated:animated
+                completion:presented
+            ];
+        } else {
+            presentation = [presenter
+                presentAlert:self
+                fromViewController:viewController
+                animated:animated
+                completion:presented
+            ];
+        }
+        
+        BOOL answered = self->_endedWhilePresenting;
+        self->_presenting = wasPresenting;
+        self->_endedWhilePresenting = endedWhilePresenting;
+        if (!answered) {
+            self.currentPresentation = presentation;
+            failed = !presentation;
         }
+        
+        TBAlertTraceEmit(traceIdentifier, TBAlertTraceEventPresent, TBAlertTracePhaseEnd);
+    }];
+    
+    // The presenter couldn't show it, such as with nothing to present from. Nothing will ever dismiss it,
+    // so do that now, or whatever waits on it, such as a scheduler or a pending result, would wait forever
+    if (failed) {
+        [self dismissAnimated:NO completion:nil];
+        return;
+    }
+    
+    // Other threads only send changes once there is a presentation; catch up on any made before then
+    if (self.currentPresentation && self.modelVersion != configuration->_version) {
+        [self scheduleUpdate];
     }
 }
 
-- (void)dismissAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
-    NSAssert([UIAlertController class], @"This method is only available on iOS 8.");
-    self.currentPresentation = nil;
-    [(UIAlertController *)self.inCaseOfManualDismissal
-        dismissViewControllerAnimated:animated completion:completion
-    ];
+- (void)prepareForPresentation {
+    if (!NSThread.isMainThread) {
+        [self performOnMainThread:^{
+            [self prepareForPresentation];
+        }];
+        return;
+    }
+    
+    if (self.isPreparedForPresentation) {
+        return;
+    }
+    
+    id<TBAlertPresenter> presenter = self.presenter;
+    self.preparedPresentation = nil;
+    
+    if ([presenter respondsToSelector:@selector(prepareAlert:)]) {
+        TBAlertConfiguration *configuration = self.configuration;
+        TBAlertTraceEmit(self.traceIdentifier, TBAlertTraceEventPrepare, TBAlertTracePhaseBegin);
+        [self pinConfiguration:configuration during:^{
+            self.preparedPresentation = [presenter prepareAlert:self];
+            self.preparedPresenter = presenter;
+        }];
+        TBAlertTraceEmit(self.traceIdentifier, TBAlertTraceEventPrepare, TBAlertTracePhaseEnd);
+        self.preparedConfiguration = configuration;
+    }
 }
 
-#pragma mark Button actions (iOS 7)
+- (BOOL)isPreparedForPresentation {
+    // Other threads' changes may not have discarded it yet, except to the title and message, which are sent to it
+    return self.preparedPresentation && self.preparedPresenter == self.presenter &&
+        self.preparedConfiguration == self.configuration;
+}
 
-- (void)didDismissWithButtonIndex:(NSInteger)buttonIndex {
-    self.currentPresentation = nil;
-    TBAlertAction *button = [self buttonAtIndex:buttonIndex];
-    [button perform:self.textFieldInputStrings.copy];
+#pragma mark Results
+
+- (void)presentForResultFromViewController:(UIViewController *)viewController
+                         cancellationToken:(TBAlertCancellationToken *)token
+                                   timeout:(NSTimeInterval)timeout
+                                completion:(void (^)(TBAlertResult *result))completion {
+    NSParameterAssert(completion);
+    
+    if (!NSThread.isMainThread) {
+        [self performOnMainThread:^{
+            [self presentForResultFromViewController:viewController
+                                   cancellationToken:token
+                                             timeout:timeout
+                                          completion:completion];
+        }];
+        return;
+    }
+    NSAssert(!self.resultHandler, @"This alert controller is already waiting for a result.");
+    
+    self.resultHandler = completion;
+    
+    if (token) {
+        // The token may outlive us; don't let it keep us around
+        __weak TBAlertController *weakSelf = self;
+        self.resultCancellationToken = token;
+        self.resultCancellationRegistration = [token addCancellationHandler:^{
+            [weakSelf resolveByDismissingWithReason:TBAlertResultReasonCancelled];
+        }];
+        
+        // Already cancelled; don't bother presenting
+        if (!self.resultHandler) {
+            return;
+        }
+    }
+    
+    if (timeout > 0) {
+        __weak TBAlertController *weakSelf = self;
+        _resultTimeoutToken = [TBAlertDeadlineScheduler.sharedScheduler scheduleAfter:timeout handler:^{
+            [weakSelf resolveByDismissingWithReason:TBAlertResultReasonTimedOut];
+        }];
+    }
+    
+    [self showFromViewController:viewController animated:YES completion:nil];
 }
 
-- (TBAlertAction *)buttonAtIndex:(NSUInteger)buttonIndex {
-    // Cancel button
-    if (buttonIndex == self.buttons.count) {
-        NSAssert(self.cancelAction, @"Invalid button index; out of bounds.");
-        return self.cancelAction;
+- (void)resolveByDismissingWithReason:(TBAlertResultReason)reason {
+    // Resolve first, so that dismissing doesn't count as a plain dismissal
+    [self resolveWithResult:[[TBAlertResult alloc]
+        initWithReason:reason buttonIndex:NSNotFound buttonIdentifier:nil textFieldValues:nil
+    ]];
+    [self resolveDuplicatesWithReason:reason buttonIndex:NSNotFound values:nil];
+    [self dismissAnimated:YES completion:nil];
+}
+
+- (void)resolveWithResult:(TBAlertResult *)result {
+    void (^handler)(TBAlertResult *) = self.resultHandler;
+    if (!handler) {
+        return;
     }
     
-    return self.buttons[buttonIndex];
+    self.resultHandler = nil;
+    [self.resultCancellationToken removeCancellationHandler:self.resultCancellationRegistration];
+    self.resultCancellationToken = nil;
+    self.resultCancellationRegistration = nil;
+    [TBAlertDeadlineScheduler.sharedScheduler cancelDeadline:_resultTimeoutToken];
+    _resultTimeoutToken = 0;
+    
+    handler(result);
 }
 
-#pragma mark UIAlertAction convenience (kinda wanna make this a category, can't because they call getTextFromTextFields)
+- (void)resolveWithButton:(TBAlertAction *)button atIndex:(NSUInteger)buttonIndex values:(TBAlertTextFieldValues *)values {
+    if (self.resultHandler) {
+        [self resolveWithResult:[[TBAlertResult alloc]
+            initWithReason:TBAlertResultReasonButton
+            buttonIndex:buttonIndex
+            buttonIdentifier:button.identifier
+            textFieldValues:values
+        ]];
+    }
+}
+
+#pragma mark Deadline
+
+/** Starts the clock on \c deadline, unless it's already running because we're being presented again. */
+- (void)scheduleDeadline {
+    if (self.deadline <= 0 || _deadlineToken) {
+        return;
+    }
+    
+    __weak TBAlertController *weakSelf = self;
+    _deadlineToken = [TBAlertDeadlineScheduler.sharedScheduler scheduleAfter:self.deadline handler:^{
+        [weakSelf deadlineDidPass];
+    }];
+}
+
+- (void)deadlineDidPass {
+    _deadlineToken = 0;
+    if (!self.currentPresentation) {
+        return;
+    }
+    
+    if (self.deadlineButtonIndex != NSNotFound) {
+        [self dismissWithButtonIndex:self.deadlineButtonIndex];
+    } else {
+        [self resolveByDismissingWithReason:TBAlertResultReasonTimedOut];
+    }
+}
+
+#pragma mark Coalescing
+
+// FNV-1a, which is plenty for telling apart a handful of distinct alerts
+static const uint64_t TBFingerprintSeed = 0xcbf29ce484222325;
+
+static uint64_t TBFingerprintBytes(uint64_t hash, const void *bytes, size_t length) {
+    const uint8_t *byte = bytes;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ byte[i]) * 0x100000001b3;
+    }
+    
+    return hash;
+}
+
+static uint64_t TBFingerprintInteger(uint64_t hash, NSInteger value) {
+    int64_t wide = value;
+    return TBFingerprintBytes(hash, &wide, sizeof(wide));
+}
+
+/** Tells \c nil apart from the empty string, and \c @"ab",@"c" from \c @"a",@"bc". */
+static uint64_t TBFingerprintString(uint64_t hash, NSString *string) {
+    if (!string) {
+        return TBFingerprintInteger(hash, -1);
+    }
+    
+    const char *utf8 = string.UTF8String;
+    size_t length = strlen(utf8);
+    hash = TBFingerprintInteger(hash, (NSInteger)length);
+    return TBFingerprintBytes(hash, utf8, length);
+}
 
-- (UIAlertAction *)actionWithTitle:(NSString *)title style:(UIAlertActionStyle)style target:(id)target selector:(SEL)selector controller:(UIAlertController *)controller {
-    __weak id weakTarget = target;
+/** @see \c +[TBAlertCoalescer fingerprintOfAlert:] */
+- (uint64_t)coalescingFingerprint {
+    // Data source items are for the main thread only, and pickers don't come in storms
+    if (self.dataSource) {
+        return 0;
+    }
+    
+    NSString *title = self.title, *message = self.message;
+    TBAlertConfiguration *configuration = self.configuration;
+    NSArray *identifiers = self.textFieldIdentifiers;
+    
+    uint64_t hash = TBFingerprintSeed;
+    hash = TBFingerprintInteger(hash, self.style);
+    hash = TBFingerprintString(hash, title);
+    hash = TBFingerprintString(hash, message);
+    
+    TBAlertButtonStore *buttons = configuration->_buttons;
+    hash = TBFingerprintInteger(hash, buttons.count);
+    for (NSUInteger i = 0; i < buttons.count; i++) {
+        hash = TBFingerprintString(hash, [buttons titleAtIndex:i]);
+        hash = TBFingerprintInteger(hash, (NSInteger)i == configuration->_destructiveButtonIndex);
+    }
+    
+    hash = TBFingerprintInteger(hash, configuration->_cancelAction != nil);
+    hash = TBFingerprintString(hash, configuration->_cancelAction.title);
     
-    IMP imp = [target methodForSelector:selector];
-    void (*func)(id, SEL) = (void *)imp;
+    hash = TBFingerprintInteger(hash, identifiers.count);
+    for (id identifier in identifiers) {
+        hash = TBFingerprintString(hash, identifier == [NSNull null] ? nil : identifier);
+    }
+    
+    // 0 means "not coalescable"
+    return hash ?: 1;
+}
+
+/** Lets a coalescer fold alerts into this one until its decision is made. */
+- (void)acceptDuplicates {
+    @synchronized (self) {
+        if (!_duplicates) {
+            _duplicates = [NSMutableArray new];
+        }
+    }
+}
+
+- (BOOL)isAcceptingDuplicates {
+    @synchronized (self) {
+        return _duplicates != nil;
+    }
+}
+
+- (BOOL)isFolded {
+    @synchronized (self) {
+        return _foldedInto != nil;
+    }
+}
+
+/** @return \c NO if this alert's decision has already been made, or it was never accepting duplicates. */
+- (BOOL)foldDuplicate:(TBAlertController *)duplicate {
+    @synchronized (self) {
+        if (!_duplicates) {
+            return NO;
+        }
+        
+        // Always in this order, this alert before its duplicate
+        @synchronized (duplicate) {
+            duplicate->_foldedInto = self;
+        }
+        [_duplicates addObject:duplicate];
+        return YES;
+    }
+}
+
+/** Call when this alert is dismissed on its own, so that it doesn't also get the decision of the alert it was folded into. */
+- (void)stopWaitingOnFoldedAlert {
+    @synchronized (self) {
+        _foldedInto = nil;
+    }
+}
+
+/** Makes the same decision for every alert folded into this one, once it has been made for this one. */
+- (void)resolveDuplicatesWithReason:(TBAlertResultReason)reason
+                        buttonIndex:(NSUInteger)buttonIndex
+                             values:(TBAlertTextFieldValues *)values {
+    NSArray<TBAlertController *> *duplicates = nil;
+    @synchronized (self) {
+        duplicates = _duplicates;
+        _duplicates = nil;
+    }
     
-    UIAlertAction *action = [UIAlertAction actionWithTitle:title style:style handler:^(UIAlertAction *action) {
-        if (controller.textFields.count > 0) {
-            [self getTextFromTextFields:controller.textFields];
+    for (TBAlertController *duplicate in duplicates) {
+        @synchronized (duplicate) {
+            if (duplicate->_foldedInto != self) {
+                continue;
+            }
+            duplicate->_foldedInto = nil;
         }
         
-        if ([weakTarget respondsToSelector:selector]) {
-            func(weakTarget, selector);
+        // Equivalent when it was folded, but it may have changed since
+        if (reason == TBAlertResultReasonButton && buttonIndex < duplicate.numberOfButtons) {
+            TBAlertAction *button = [duplicate buttonAtIndex:buttonIndex];
+            [duplicate performButton:button values:values];
+            [duplicate resolveWithButton:button atIndex:buttonIndex values:values];
+        } else {
+            TBAlertResultReason dismissal = reason == TBAlertResultReasonButton ? TBAlertResultReasonDismissed : reason;
+            [duplicate resolveWithResult:[[TBAlertResult alloc]
+                initWithReason:dismissal buttonIndex:NSNotFound buttonIdentifier:nil textFieldValues:nil
+            ]];
         }
+    }
+}
+
+#pragma mark Updating
+
+/** Presentations are only used on the main thread. This runs \c block right away on the main thread,
+ or later on it when called from another thread while there are presentations to keep up to date. */
+- (void)updatePresentations:(TBVoidBlock)block {
+    if (NSThread.isMainThread) {
+        block();
+    } else if (atomic_load(&_hasPresentations)) {
+        dispatch_async(dispatch_get_main_queue(), block);
+    }
+}
+
+/** Hops to the main thread once, after doing the work that doesn't need it here, such as calling providers. */
+- (void)performOnMainThread:(TBVoidBlock)block {
+    [self title];
+    [self message];
+    [self configuration];
+    dispatch_async(dispatch_get_main_queue(), block);
+}
+
+- (void)setCurrentPresentation:(id<TBAlertPresentation>)currentPresentation {
+    _currentPresentation = currentPresentation;
+    atomic_store(&_hasPresentations, _currentPresentation || _preparedPresentation);
+}
+
+- (void)setPreparedPresentation:(id<TBAlertPresentation>)preparedPresentation {
+    _preparedPresentation = preparedPresentation;
+    atomic_store(&_hasPresentations, _currentPresentation || _preparedPresentation);
+}
+
+/** Call after changing anything a presenter would have to rebuild the alert for, but which can't be updated in place. */
+- (void)discardPreparedPresentation {
+    [self updatePresentations:^{
+        self.preparedPresentation = nil;
     }];
+}
+
+/** Call after changing the buttons. */
+- (void)scheduleUpdate {
+    [self updatePresentations:^{
+        self.preparedPresentation = nil;
+        
+        // Coalesce every change made during this run loop turn into one update
+        if (self.currentPresentation && !self->_updateScheduled) {
+            self->_updateScheduled = YES;
+            [self performSelector:@selector(updateIfNeeded) withObject:nil afterDelay:0];
+        }
+    }];
+}
+
+- (void)setNeedsUpdate {
+    @synchronized (self) {
+        [self configurationDidChange];
+    }
+    [self scheduleUpdate];
+}
+
+- (void)invalidateProvidedStrings {
+    BOOL title = NO, message = NO;
+    @synchronized (self) {
+        title = _titleProvider != nil;
+        message = _messageProvider != nil;
+        _titleProvided = NO;
+        _messageProvided = NO;
+        _modelVersion++;
+    }
+    if (title) {
+        [self titleDidChange];
+    }
+    if (message) {
+        [self messageDidChange];
+    }
     
-    return action;
+    // Data source items are asked for their titles each time anyway
+    TBAlertConfiguration *configuration = self.configuration;
+    TBAlertButtonStore *buttons = configuration->_buttons;
+    NSMutableArray<TBAlertAction *> *provided = [NSMutableArray new];
+    @synchronized (self) {
+        for (NSUInteger i = 0; i < buttons.count; i++) {
+            TBAlertAction *button = [self existingActionForButtonAtIndex:i ofStore:buttons];
+            if (button.titleProvider) {
+                [provided addObject:button];
+            }
+        }
+    }
+    
+    BOOL buttonsChanged = provided.count > 0;
+    for (TBAlertAction *button in provided) {
+        [button invalidateTitle];
+    }
+    if (configuration->_cancelAction.titleProvider) {
+        [configuration->_cancelAction invalidateTitle];
+        buttonsChanged = YES;
+    }
+    
+    // The new titles are compared to the presented ones like any other change to the buttons
+    if (buttonsChanged) {
+        [self setNeedsUpdate];
+    }
 }
 
-- (UIAlertAction *)actionWithTitle:(NSString *)title style:(UIAlertActionStyle)style target:(id)target selector:(SEL)selector object:(id)object controller:(UIAlertController *)controller {
-    __weak id weakTarget = target;
-    __weak id weakObject = object;
+- (void)updateIfNeeded {
+    [self cancelScheduledUpdate];
+    
+    id<TBAlertPresentation> presentation = self.currentPresentation;
+    TBAlertConfiguration *configuration = self.configuration;
+    if (!presentation || _presentedModelVersion == configuration->_version) {
+        return;
+    }
     
-    IMP imp = [target methodForSelector:selector];
-    void (*func)(id, SEL, id) = (void *)imp;
+    NSArray *buttons = nil, *titles = nil, *styles = nil, *enabledStates = nil;
+    [self snapshotButtonsOfConfiguration:configuration
+        buttons:&buttons titles:&titles styles:&styles enabledStates:&enabledStates
+    ];
+    TBAlertUpdate *update = [[TBAlertUpdate alloc]
+        initWithOldButtons:self.presentedButtons
+        oldTitles:self.presentedTitles
+        oldStyles:self.presentedStyles
+        oldEnabledStates:self.presentedEnabledStates
+        buttons:buttons
+        titles:titles
+        styles:styles
+        enabledStates:enabledStates
+    ];
     
-    UIAlertAction *action = [UIAlertAction actionWithTitle:title style:style handler:^(UIAlertAction *aciton) {
-        if (controller.textFields.count > 0) {
-            [self getTextFromTextFields:controller.textFields];
+    if (update.isEmpty || ([presentation respondsToSelector:@selector(applyUpdate:)] && [presentation applyUpdate:update])) {
+        self.presentedButtons = buttons;
+        self.presentedTitles = titles;
+        self.presentedStyles = styles;
+        self.presentedEnabledStates = enabledStates;
+        _presentedModelVersion = configuration->_version;
+    } else {
+        [self presentAgain];
+    }
+}
+
+- (void)cancelScheduledUpdate {
+    if (_updateScheduled) {
+        _updateScheduled = NO;
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateIfNeeded) object:nil];
+    }
+}
+
+/** Replaces the current presentation with a new one, for changes it could not apply in place. */
+- (void)presentAgain {
+    id<TBAlertPresentation> presentation = self.currentPresentation;
+    self.currentPresentation = nil;
+    _presentingAgain = YES;
+    
+    [presentation dismissAnimated:NO completion:^{
+        // Don't come back if we were dismissed in the meantime
+        if (self->_presentingAgain) {
+            self->_presentingAgain = NO;
+            [self showFromViewController:self.presentingViewController animated:NO completion:nil];
         }
-        
-        if ([weakTarget respondsToSelector:selector]) {
-            func(weakTarget, selector, weakObject);
+    }];
+}
+
+- (void)recordPresentedButtons {
+    TBAlertConfiguration *configuration = self.configuration;
+    NSArray *buttons = nil, *titles = nil, *styles = nil, *enabledStates = nil;
+    [self snapshotButtonsOfConfiguration:configuration
+        buttons:&buttons titles:&titles styles:&styles enabledStates:&enabledStates
+    ];
+    self.presentedButtons = buttons;
+    self.presentedTitles = titles;
+    self.presentedStyles = styles;
+    self.presentedEnabledStates = enabledStates;
+    _presentedModelVersion = configuration->_version;
+}
+
+- (void)presentationDidEnd {
+    [self cancelScheduledUpdate];
+    [TBAlertDeadlineScheduler.sharedScheduler cancelDeadline:_deadlineToken];
+    _deadlineToken = 0;
+    _presentingAgain = NO;
+    self.currentPresentation = nil;
+    self.presentedButtons = nil;
+    self.presentedTitles = nil;
+    self.presentedStyles = nil;
+    self.presentedEnabledStates = nil;
+}
+
+/** Describes every button in \c configuration without materializing actions for data source items. */
+- (void)snapshotButtonsOfConfiguration:(TBAlertConfiguration *)configuration
+                               buttons:(NSArray * __autoreleasing *)buttons
+                                titles:(NSArray * __autoreleasing *)titles
+                                styles:(NSArray * __autoreleasing *)styles
+                         enabledStates:(NSArray * __autoreleasing *)enabledStates {
+    NSMutableArray *keys = [NSMutableArray new];
+    NSMutableArray *buttonTitles = [NSMutableArray new];
+    NSMutableArray *buttonStyles = [NSMutableArray new];
+    NSMutableArray *states = [NSMutableArray new];
+    
+    [self pinConfiguration:configuration during:^{
+        NSUInteger count = self.numberOfButtons;
+        for (NSUInteger i = 0; i < count; i++) {
+            [keys addObject:[self keyForButtonAtIndex:i]];
+            [buttonTitles addObject:[self titleForButtonAtIndex:i]];
+            [buttonStyles addObject:@([self actionStyleForButtonAtIndex:i])];
+            [states addObject:@([self isButtonEnabledAtIndex:i])];
         }
     }];
     
-    return action;
+    *buttons = keys;
+    *titles = buttonTitles;
+    *styles = buttonStyles;
+    *enabledStates = states;
+}
+
+/** The action itself for buttons that were added directly, and the item's
+ identifier or index for data source items, so that reloading doesn't look like a change. */
+- (id)keyForButtonAtIndex:(NSUInteger)buttonIndex {
+    NSUInteger item = [self itemIndexForButtonAtIndex:buttonIndex];
+    if (item == NSNotFound) {
+        return [self buttonAtIndex:buttonIndex];
+    }
+    
+    return [self identifierForItemAtIndex:item] ?: @(item);
 }
 
-- (UIAlertAction *)actionFromAlertAction:(TBAlertAction *)button withStyle:(UIAlertActionStyle)style controller:(UIAlertController *)controller {
-    UIAlertAction *action;
+- (TBAlertAction *)buttonForKey:(id)key {
+    if ([key isKindOfClass:[NSNumber class]]) {
+        return [self actionForItemAtIndex:[key unsignedIntegerValue]];
+    }
+    if ([key isKindOfClass:[NSString class]]) {
+        NSNumber *item = self.itemIndexesByIdentifier[key];
+        return item ? [self actionForItemAtIndex:item.unsignedIntegerValue] : nil;
+    }
     
-    switch (button.style) {
-        case TBAlertActionStyleNoAction:
-        case TBAlertActionStyleBlock: {
-            action = [UIAlertAction actionWithTitle:button.title style:style handler:^(UIAlertAction *alertAction) {
-                [self getTextFromTextFields:controller.textFields];
-                [button perform:[self.textFieldInputStrings copy]];
+    return key;
+}
+
+#pragma mark Dismissing
+
+- (void)dismiss {
+    [self dismissAnimated:YES completion:nil];
+}
+
+- (void)dismissWithButtonIndex:(NSUInteger)index {
+    // Button 0 with no actions defaults to [self dismiss]
+    if (index == 0 && [self numberOfOtherButtons] == 0) {
+        [self dismiss];
+        return;
+    }
+    
+    TBAlertTraceEmit(self.traceIdentifier, TBAlertTraceEventDecision, TBAlertTracePhaseInstant);
+    
+    TBAlertAction *action = [self buttonAtIndex:index];
+    TBAlertTextFieldValues *values = [self textFieldValuesFromPresentation:self.currentPresentation];
+    [self dismissPresentationAnimated:YES completion:nil];
+    [self stopWaitingOnFoldedAlert];
+    [self performButton:action values:values];
+    [self resolveWithButton:action atIndex:index values:values];
+    [self resolveDuplicatesWithReason:TBAlertResultReasonButton buttonIndex:index values:values];
+}
+
+/** Performs the action of a chosen button, unless it was disabled. */
+- (void)performButton:(TBAlertAction *)button values:(TBAlertTextFieldValues *)values {
+    if (button.enabled) {
+        TBAlertTraceEmit(self.traceIdentifier, TBAlertTraceEventHandler, TBAlertTracePhaseBegin);
+        [button perform:values];
+        TBAlertTraceEmit(self.traceIdentifier, TBAlertTraceEventHandler, TBAlertTracePhaseEnd);
+    }
+}
+
+- (void)dismissAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    [self stopWaitingOnFoldedAlert];
+    [self resolveWithResult:[[TBAlertResult alloc]
+        initWithReason:TBAlertResultReasonDismissed buttonIndex:NSNotFound buttonIdentifier:nil textFieldValues:nil
+    ]];
+    [self resolveDuplicatesWithReason:TBAlertResultReasonDismissed buttonIndex:NSNotFound values:nil];
+    [self dismissPresentationAnimated:animated completion:completion];
+}
+
+/** Dismisses without resolving a pending result. */
+- (void)dismissPresentationAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    [self withdrawPresentationAnimated:animated completion:^{
+        if (completion) completion();
+        [self postDidDismiss];
+    }];
+}
+
+/** Takes the alert off screen without resolving it or posting \c TBAlertControllerDidDismissNotification,
+ so that it can be shown again later. */
+- (void)withdrawPresentationAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    id<TBAlertPresentation> presentation = self.currentPresentation;
+    [self presentationDidEnd];
+    
+    if (presentation) {
+        [presentation dismissAnimated:animated completion:completion];
+    } else if (completion) {
+        completion();
+    }
+}
+
+- (void)postDidDismiss {
+    [NSNotificationCenter.defaultCenter postNotificationName:TBAlertControllerDidDismissNotification object:self];
+}
+
+- (TBAlertAction *)buttonAtIndex:(NSUInteger)buttonIndex {
+    // Everything from one configuration, whatever other threads change meanwhile
+    TBAlertConfiguration *configuration = self.configuration;
+    NSUInteger offset = configuration->_buttons.count;
+    if (buttonIndex < offset) {
+        @synchronized (self) {
+            return [self actionForButtonAtIndex:buttonIndex ofStore:configuration->_buttons];
+        }
+    }
+    
+    NSUInteger items = [self numberOfVisibleItems];
+    if (buttonIndex - offset < items) {
+        return [self actionForItemAtIndex:[self itemIndexAtPosition:buttonIndex - offset]];
+    }
+    
+    // Cancel button
+    NSAssert(buttonIndex == offset + items && configuration->_cancelAction, @"Invalid button index; out of bounds.");
+    return configuration->_cancelAction;
+}
+
+@end
+
+#pragma mark - Presenter support
+
+@implementation TBAlertController (TBAlertPresenter)
+
+- (NSArray *)textFieldConfigurationHandlers {
+    TBAlertConfiguration *configuration = self.configuration;
+    NSMutableArray *handlers = [NSMutableArray new];
+    
+    // Text fields for alertViewStyle always come first
+    switch (configuration->_alertViewStyle) {
+        case UIAlertViewStyleLoginAndPasswordInput: {
+            [handlers addObject:^(UITextField *textField) {
+                textField.placeholder = @"Login";
+            }];
+            [handlers addObject:^(UITextField *textField) {
+                textField.placeholder = @"Password";
+                textField.secureTextEntry = YES;
             }];
             break;
         }
-            
-        case TBAlertActionStyleTargetObject:
-        case TBAlertActionStyleTarget: {
-            
-            // With object
-            if (button.object) {
-                action = [self actionWithTitle:button.title
-                                         style:style
-                                        target:button.target
-                                      selector:button.action
-                                        object:button.object
-                                    controller:controller];
-            }
-            // Without object
-            else {
-                action = [self actionWithTitle:button.title
-                                         style:style
-                                        target:button.target
-                                      selector:button.action
-                                    controller:controller];
-            }
-            
+        case UIAlertViewStylePlainTextInput: {
+            [handlers addObject:^(UITextField *textField) { }];
             break;
         }
+        case UIAlertViewStyleSecureTextInput: {
+            [handlers addObject:^(UITextField *textField) {
+                textField.secureTextEntry = YES;
+            }];
+            break;
+        }
+        case UIAlertViewStyleDefault:;
     }
     
-    action.enabled = button.enabled;
-    return action;
+    [handlers addObjectsFromArray:configuration->_textFieldHandlers];
+    return handlers;
 }
 
-@end
+- (NSArray *)textFieldIdentifiers {
+    TBAlertConfiguration *configuration = self.configuration;
+    NSMutableArray *identifiers = [NSMutableArray new];
+    
+    switch (configuration->_alertViewStyle) {
+        case UIAlertViewStyleLoginAndPasswordInput:
+            [identifiers addObject:@"login"];
+            [identifiers addObject:@"password"];
+            break;
+        case UIAlertViewStylePlainTextInput:
+            [identifiers addObject:[NSNull null]];
+            break;
+        case UIAlertViewStyleSecureTextInput:
+            [identifiers addObject:@"password"];
+            break;
+        case UIAlertViewStyleDefault:;
+    }
+    
+    [identifiers addObjectsFromArray:configuration->_addedTextFieldIdentifiers];
+    return identifiers;
+}
+
+- (NSString *)titleForButtonAtIndex:(NSUInteger)buttonIndex {
+    NSUInteger item = [self itemIndexForButtonAtIndex:buttonIndex];
+    if (item != NSNotFound) {
+        return [self titleForItemAtIndex:item];
+    }
+    
+    // Without creating an action for the button
+    TBAlertButtonStore *buttons = self.configuration->_buttons;
+    if (buttonIndex < buttons.count) {
+        TBAlertAction *button = nil;
+        @synchronized (self) {
+            button = [self existingActionForButtonAtIndex:buttonIndex ofStore:buttons];
+        }
+        return button ? button.title : [buttons titleAtIndex:buttonIndex];
+    }
+    
+    return [self buttonAtIndex:buttonIndex].title;
+}
+
+- (BOOL)isButtonEnabledAtIndex:(NSUInteger)buttonIndex {
+    NSUInteger item = [self itemIndexForButtonAtIndex:buttonIndex];
+    if (item != NSNotFound) {
+        TBAlertAction *action = self.itemActions[@(item)];
+        return action ? action.enabled : YES;
+    }
+    
+    // Changed while synchronized, by setButtonEnabled:atIndex:
+    TBAlertButtonStore *buttons = self.configuration->_buttons;
+    if (buttonIndex < buttons.count) {
+        @synchronized (self) {
+            TBAlertAction *button = [self existingActionForButtonAtIndex:buttonIndex ofStore:buttons];
+            return button ? button.enabled : ([buttons flagsAtIndex:buttonIndex] & TBAlertButtonEnabled) != 0;
+        }
+    }
+    
+    TBAlertAction *button = [self buttonAtIndex:buttonIndex];
+    @synchronized (self) {
+        return button.enabled;
+    }
+}
+
+- (UIAlertActionStyle)actionStyleForButtonAtIndex:(NSUInteger)buttonIndex {
+    if (self.cancelAction && buttonIndex == [self numberOfOtherButtons]) {
+        return UIAlertActionStyleCancel;
+    }
+    
+    return (buttonIndex == self.destructiveButtonIndex) ?
+        UIAlertActionStyleDestructive : UIAlertActionStyleDefault;
+}
+
+- (void)presentation:(id<TBAlertPresentation>)presentation didSelectButtonAtIndex:(NSUInteger)buttonIndex {
+    TBAlertTraceEmit(self.traceIdentifier, TBAlertTraceEventDecision, TBAlertTracePhaseInstant);
+    
+    // The presentation's indexes match our buttons as of its last update, not necessarily as they are now
+    NSArray *presentedButtons = nil;
+    // Or the one being presented, if the presenter answered before returning it
+    BOOL current = presentation == self.currentPresentation || _presenting;
+    if (current) {
+        presentedButtons = self.presentedButtons;
+        [self presentationDidEnd];
+        _endedWhilePresenting = _presenting;
+    }
+    
+    // Captured once per dismissal and released once the action is done with it
+    TBAlertTextFieldValues *values = [self textFieldValuesFromPresentation:presentation];
+    
+    TBAlertAction *button = buttonIndex < presentedButtons.count ?
+        [self buttonForKey:presentedButtons[buttonIndex]] : [self buttonAtIndex:buttonIndex];
+    [self performButton:button values:values];
+    
+    [self resolveWithButton:button atIndex:buttonIndex values:values];
+    [self resolveDuplicatesWithReason:TBAlertResultReasonButton buttonIndex:buttonIndex values:values];
+    
+    // The presentation took itself off screen before telling us
+    if (current) {
+        [self postDidDismiss];
+    }
+}
 
+- (void)presentation:(id<TBAlertPresentation>)presentation textFieldDidChangeAtIndex:(NSUInteger)index {
+    if (presentation != self.currentPresentation) {
+        return;
+    }
+    
+    NSArray *identifiers = self.textFieldIdentifiers;
+    if (index < identifiers.count && [identifiers[index] isEqual:TBAlertControllerFilterTextFieldIdentifier]) {
+        self.filterText = presentation.textFields[index].text;
+    }
+}
 
+@end
@@ -0,0 +1,66 @@
+//
+//  TBAlertDeadlineScheduler.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertAction.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A source of time, and of wakeups at a given time, for a \c TBAlertDeadlineScheduler. */
+@protocol TBAlertClock <NSObject>
+
+/** The current time in seconds. Only differences between values are meaningful. */
+@property (nonatomic, readonly) NSTimeInterval now;
+
+/** Calls \c handler on the main thread at \c time, or up to \c leeway seconds later.
+ Replaces any wakeup requested before; pass a \c nil handler to cancel it. */
+- (void)wakeUpAt:(NSTimeInterval)time leeway:(NSTimeInterval)leeway handler:(nullable TBVoidBlock)handler;
+
+@end
+
+/** The default clock: system uptime, with wakeups from a single dispatch timer on the main queue. */
+@interface TBAlertSystemClock : NSObject <TBAlertClock>
+@end
+
+/** A clock which only moves when told to, for testing deadlines without waiting on them. */
+@interface TBAlertManualClock : NSObject <TBAlertClock>
+
+@property (nonatomic, readwrite) NSTimeInterval now;
+
+/** Moves the clock forward, synchronously calling the pending wakeup if its time has come. */
+- (void)advanceBy:(NSTimeInterval)interval;
+
+@end
+
+/** Calls blocks at given times, using a single wakeup from its clock for all of them.
+ Deadlines closer together than \c tolerance are handled by the same wakeup.
+ All methods must be called on the main thread. */
+@interface TBAlertDeadlineScheduler : NSObject
+
+/** The scheduler used by alert controllers. Replace it with one using a
+ \c TBAlertManualClock to control time in tests, before presenting any alerts. */
+@property (nonatomic, class, null_resettable) TBAlertDeadlineScheduler *sharedScheduler;
+
+- (instancetype)initWithClock:(id<TBAlertClock>)clock NS_DESIGNATED_INITIALIZER;
+/** Uses a \c TBAlertSystemClock. */
+- (instancetype)init;
+
+@property (nonatomic, readonly) id<TBAlertClock> clock;
+/** How late a deadline may be handled so that it can share a wakeup with another. Defaults to 50ms. */
+@property (nonatomic) NSTimeInterval tolerance;
+/** The number of deadlines which have not yet passed or been cancelled. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** Calls \c handler once \c delay seconds have passed, unless cancelled first.
+ @return A token to pass to \c cancelDeadline:. Never \c 0. */
+- (NSUInteger)scheduleAfter:(NSTimeInterval)delay handler:(TBVoidBlock)handler;
+/** Forgets a deadline, releasing its handler. Does nothing for \c 0 or for deadlines which have already passed. */
+- (void)cancelDeadline:(NSUInteger)token;
+
+@end
+
+NS_ASSUME_NONNULL_END
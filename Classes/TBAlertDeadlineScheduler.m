@@ -0,0 +1,296 @@
+//
+//  TBAlertDeadlineScheduler.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertDeadlineScheduler.h"
+
+#pragma mark - TBAlertSystemClock
+
+@implementation TBAlertSystemClock {
+    dispatch_source_t _timer;
+    TBVoidBlock _handler;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+- (NSTimeInterval)now {
+    return [NSProcessInfo processInfo].systemUptime;
+}
+
+- (void)wakeUpAt:(NSTimeInterval)time leeway:(NSTimeInterval)leeway handler:(TBVoidBlock)handler {
+    _handler = [handler copy];
+
+    if (!_timer) {
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+        __weak TBAlertSystemClock *weakSelf = self;
+        dispatch_source_set_event_handler(_timer, ^{
+            [weakSelf timerDidFire];
+        });
+        dispatch_resume(_timer);
+    }
+
+    // The timer is kept around; a cancelled wakeup just moves it out to forever
+    dispatch_time_t start = DISPATCH_TIME_FOREVER;
+    if (handler) {
+        NSTimeInterval delay = MAX(time - self.now, 0);
+        start = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC));
+    }
+
+    dispatch_source_set_timer(_timer, start, DISPATCH_TIME_FOREVER, (uint64_t)(leeway * NSEC_PER_SEC));
+}
+
+- (void)timerDidFire {
+    TBVoidBlock handler = _handler;
+    _handler = nil;
+    if (handler) handler();
+}
+
+@end
+
+#pragma mark - TBAlertManualClock
+
+@implementation TBAlertManualClock {
+    NSTimeInterval _wakeUpTime;
+    TBVoidBlock _handler;
+}
+
+- (void)wakeUpAt:(NSTimeInterval)time leeway:(NSTimeInterval)leeway handler:(TBVoidBlock)handler {
+    _wakeUpTime = time;
+    _handler = [handler copy];
+}
+
+- (void)advanceBy:(NSTimeInterval)interval {
+    NSParameterAssert(interval >= 0);
+
+    self.now += interval;
+    if (_handler && self.now >= _wakeUpTime) {
+        TBVoidBlock handler = _handler;
+        _handler = nil;
+        handler();
+    }
+}
+
+@end
+
+#pragma mark - TBAlertDeadlineScheduler
+
+typedef struct {
+    NSTimeInterval deadline;
+    NSUInteger token;
+} TBDeadline;
+
+/** Earlier deadlines first, and deadlines at the same time in the order they were scheduled. */
+static inline BOOL TBDeadlineBefore(TBDeadline a, TBDeadline b) {
+    return a.deadline < b.deadline || (a.deadline == b.deadline && a.token < b.token);
+}
+
+/** Puts \c deadline at index \c i of the heap, or below it, to keep the heap ordered beneath \c i. */
+static void TBDeadlineSiftDown(TBDeadline *heap, NSUInteger count, NSUInteger i, TBDeadline deadline) {
+    while (YES) {
+        NSUInteger child = i * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && TBDeadlineBefore(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!TBDeadlineBefore(heap[child], deadline)) {
+            break;
+        }
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = deadline;
+}
+
+@implementation TBAlertDeadlineScheduler {
+    /// A binary min-heap of every deadline, including cancelled ones which haven't been popped or compacted away yet
+    TBDeadline *_heap;
+    NSUInteger _heapCount;
+    NSUInteger _heapCapacity;
+    NSUInteger _lastToken;
+    /// The deadline the clock will next wake us up for, or \c NSNotFound
+    NSUInteger _armedToken;
+    /// Handlers of deadlines which haven't passed or been cancelled, by token
+    NSMutableDictionary<NSNumber *, TBVoidBlock> *_handlers;
+}
+
+static TBAlertDeadlineScheduler *_sharedScheduler = nil;
+
++ (TBAlertDeadlineScheduler *)sharedScheduler {
+    if (!_sharedScheduler) {
+        _sharedScheduler = [self new];
+    }
+
+    return _sharedScheduler;
+}
+
++ (void)setSharedScheduler:(TBAlertDeadlineScheduler *)sharedScheduler {
+    _sharedScheduler = sharedScheduler;
+}
+
+- (instancetype)init {
+    return [self initWithClock:[TBAlertSystemClock new]];
+}
+
+- (instancetype)initWithClock:(id<TBAlertClock>)clock {
+    NSParameterAssert(clock);
+
+    self = [super init];
+    if (self) {
+        _clock = clock;
+        _tolerance = 0.05;
+        _armedToken = NSNotFound;
+        _handlers = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    free(_heap);
+}
+
+- (NSUInteger)count {
+    return _handlers.count;
+}
+
+#pragma mark Scheduling
+
+- (NSUInteger)scheduleAfter:(NSTimeInterval)delay handler:(TBVoidBlock)handler {
+    NSParameterAssert(handler);
+
+    NSUInteger token = ++_lastToken;
+    _handlers[@(token)] = [handler copy];
+    [self push:(TBDeadline){ self.clock.now + MAX(delay, 0), token }];
+    [self arm];
+
+    return token;
+}
+
+- (void)cancelDeadline:(NSUInteger)token {
+    if (!token || !_handlers[@(token)]) {
+        return;
+    }
+
+    // The heap entry stays until it reaches the top, where it's skipped,
+    // unless cancelled entries come to make up most of the heap
+    [_handlers removeObjectForKey:@(token)];
+    if (_handlers.count < _heapCount / 2) {
+        [self compact];
+    }
+    if (token == _armedToken) {
+        [self arm];
+    }
+}
+
+#pragma mark Firing
+
+- (void)wakeUp {
+    _armedToken = NSNotFound;
+    NSTimeInterval limit = self.clock.now + self.tolerance;
+
+    // Handlers may schedule or cancel other deadlines, so look at the top afresh each time
+    while (_heapCount && _heap[0].deadline <= limit) {
+        NSNumber *token = @([self pop].token);
+        TBVoidBlock handler = _handlers[token];
+        if (handler) {
+            [_handlers removeObjectForKey:token];
+            handler();
+        }
+    }
+
+    [self arm];
+}
+
+/** Asks the clock to wake us up for the earliest deadline which is still wanted. */
+- (void)arm {
+    while (_heapCount && !_handlers[@(_heap[0].token)]) {
+        [self pop];
+    }
+
+    if (!_heapCount) {
+        if (_armedToken != NSNotFound) {
+            _armedToken = NSNotFound;
+            [self.clock wakeUpAt:0 leeway:0 handler:nil];
+        }
+        return;
+    }
+
+    TBDeadline next = _heap[0];
+    if (next.token == _armedToken) {
+        return;
+    }
+
+    _armedToken = next.token;
+    __weak TBAlertDeadlineScheduler *weakSelf = self;
+    [self.clock wakeUpAt:next.deadline leeway:self.tolerance handler:^{
+        [weakSelf wakeUp];
+    }];
+}
+
+#pragma mark Heap
+
+- (void)push:(TBDeadline)deadline {
+    if (_heapCount == _heapCapacity) {
+        _heapCapacity = MAX(_heapCapacity * 2, 16);
+        _heap = realloc(_heap, sizeof(TBDeadline) * _heapCapacity);
+    }
+
+    NSUInteger i = _heapCount++;
+    while (i > 0) {
+        NSUInteger parent = (i - 1) / 2;
+        if (!TBDeadlineBefore(deadline, _heap[parent])) {
+            break;
+        }
+
+        _heap[i] = _heap[parent];
+        i = parent;
+    }
+
+    _heap[i] = deadline;
+}
+
+- (TBDeadline)pop {
+    TBDeadline top = _heap[0];
+    TBDeadline last = _heap[--_heapCount];
+    if (_heapCount) {
+        TBDeadlineSiftDown(_heap, _heapCount, 0, last);
+    }
+
+    return top;
+}
+
+/** Drops cancelled deadlines and rebuilds the heap from the rest, so that a scheduler whose deadlines
+ are mostly cancelled, such as alert timeouts, doesn't grow without bound. Linear in the heap's size. */
+- (void)compact {
+    NSUInteger count = 0;
+    for (NSUInteger i = 0; i < _heapCount; i++) {
+        if (_handlers[@(_heap[i].token)]) {
+            _heap[count++] = _heap[i];
+        }
+    }
+
+    _heapCount = count;
+    for (NSUInteger i = count / 2; i-- > 0;) {
+        TBDeadlineSiftDown(_heap, count, i, _heap[i]);
+    }
+
+    // Give back memory after a burst
+    if (_heapCapacity > 64 && count < _heapCapacity / 4) {
+        _heapCapacity /= 2;
+        _heap = realloc(_heap, sizeof(TBDeadline) * _heapCapacity);
+    }
+}
+
+@end
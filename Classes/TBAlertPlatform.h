@@ -0,0 +1,74 @@
+//
+//  TBAlertPlatform.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#if __has_include(<UIKit/UIKit.h>)
+#import <UIKit/UIKit.h>
+#define TB_HAS_UIKIT 1
+#else
+#import <Foundation/Foundation.h>
+#import <dispatch/dispatch.h>
+#define TB_HAS_UIKIT 0
+#endif
+
+#ifndef NS_AVAILABLE_IOS
+#define NS_AVAILABLE_IOS(_ios)
+#endif
+
+#if !TB_HAS_UIKIT
+
+// A minimal stand-in for the parts of UIKit the core classes touch,
+// so that they can be built against GNUstep Foundation and driven
+// by a headless presenter. None of these classes draw anything.
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, UIAlertViewStyle) {
+    UIAlertViewStyleDefault = 0,
+    UIAlertViewStyleSecureTextInput,
+    UIAlertViewStylePlainTextInput,
+    UIAlertViewStyleLoginAndPasswordInput
+};
+
+typedef NS_ENUM(NSInteger, UIAlertControllerStyle) {
+    UIAlertControllerStyleActionSheet = 0,
+    UIAlertControllerStyleAlert
+};
+
+typedef NS_ENUM(NSInteger, UIAlertActionStyle) {
+    UIAlertActionStyleDefault = 0,
+    UIAlertActionStyleCancel,
+    UIAlertActionStyleDestructive
+};
+
+@interface UIView : NSObject
+@end
+
+@interface UIBarButtonItem : NSObject
+@end
+
+@interface UIViewController : NSObject
+@end
+
+@interface UITextField : NSObject
+@property (nonatomic, copy, nullable) NSString *text;
+@property (nonatomic, copy, nullable) NSString *placeholder;
+@property (nonatomic, getter=isSecureTextEntry) BOOL secureTextEntry;
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
+
+/** @return \c YES if \c UIAlertController is available, which is always the case without UIKit. */
+static inline BOOL TBAlertControllerIsAvailable(void) {
+#if TB_HAS_UIKIT
+    return [UIAlertController class] != nil;
+#else
+    return YES;
+#endif
+}
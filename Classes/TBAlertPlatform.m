@@ -0,0 +1,25 @@
+//
+//  TBAlertPlatform.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPlatform.h"
+
+#if !TB_HAS_UIKIT
+
+@implementation UIView
+@end
+
+@implementation UIBarButtonItem
+@end
+
+@implementation UIViewController
+@end
+
+@implementation UITextField
+@end
+
+#endif
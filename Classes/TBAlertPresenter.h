@@ -0,0 +1,128 @@
+//
+//  TBAlertPresenter.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertAction.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TBAlertController;
+
+/** Describes how the buttons of a presented alert changed since they were last shown,
+ as the minimal set of removals and insertions plus any buttons whose state changed in place.
+
+ Removals are applied first, in descending order, then insertions in ascending order.
+ A button that moved is removed from its old index and inserted at its new one. */
+@interface TBAlertUpdate : NSObject
+
+/** Computes the difference between two lists of buttons.
+ @param buttons Objects identifying each button, compared with \c isEqual:.
+ @param titles Parallel to \c buttons; the title of each button.
+ @param styles Parallel to \c buttons; the \c UIAlertActionStyle of each button as an \c NSNumber.
+ @param enabledStates Parallel to \c buttons; whether each button is enabled as an \c NSNumber. */
+- (instancetype)initWithOldButtons:(NSArray *)oldButtons
+                         oldTitles:(NSArray<NSString *> *)oldTitles
+                         oldStyles:(NSArray<NSNumber *> *)oldStyles
+                  oldEnabledStates:(NSArray<NSNumber *> *)oldEnabledStates
+                           buttons:(NSArray *)buttons
+                            titles:(NSArray<NSString *> *)titles
+                            styles:(NSArray<NSNumber *> *)styles
+                     enabledStates:(NSArray<NSNumber *> *)enabledStates;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Indexes into the old list of buttons which should be removed. */
+@property (nonatomic, readonly) NSIndexSet *removedIndexes;
+/** Indexes into the new list of buttons which should be inserted. */
+@property (nonatomic, readonly) NSIndexSet *insertedIndexes;
+/** Indexes into the new list of buttons which stayed put but whose style or enabled state changed.
+ A button whose title changed is removed and inserted again instead. */
+@property (nonatomic, readonly) NSIndexSet *reconfiguredIndexes;
+
+/** Opaque objects identifying each button in the new list. The cancel button, if any, is last. */
+@property (nonatomic, readonly) NSArray *buttons;
+/** Parallel to \c buttons; the title of each button. */
+@property (nonatomic, readonly) NSArray<NSString *> *titles;
+/** Parallel to \c buttons; the \c UIAlertActionStyle of each button. */
+@property (nonatomic, readonly) NSArray<NSNumber *> *styles;
+/** Parallel to \c buttons; whether each button is enabled. */
+@property (nonatomic, readonly) NSArray<NSNumber *> *enabledStates;
+
+/** Whether or not any buttons were added, removed, or moved. */
+@property (nonatomic, readonly) BOOL changesStructure;
+/** Whether or not there is nothing to update. */
+@property (nonatomic, readonly, getter=isEmpty) BOOL empty;
+
+@end
+
+/** A single, live presentation of a \c TBAlertController, as created by a \c TBAlertPresenter.
+ The alert controller holds on to its current presentation until it is dismissed. */
+@protocol TBAlertPresentation <NSObject>
+
+/** Updated by the alert controller when its own \c title changes while presented. */
+@property (nonatomic, copy, nullable) NSString *title;
+/** The text fields of the presented alert, in display order. */
+@property (nonatomic, readonly) NSArray<UITextField *> *textFields;
+
+/** Dismisses the presentation without triggering any action. */
+- (void)dismissAnimated:(BOOL)animated completion:(nullable TBVoidBlock)completion;
+
+@optional
+
+/** Updated by the alert controller when its own \c message changes while presented. */
+@property (nonatomic, copy, nullable) NSString *message;
+
+/** Applies changes to the presented buttons in place. Called at most once per run loop
+ turn, no matter how many times the alert controller's buttons changed during it.
+ @return \c NO if the presentation cannot apply the update, in which case the alert
+ controller dismisses it and presents itself again without animation. Presentations
+ which do not implement this method are always presented again. */
+- (BOOL)applyUpdate:(TBAlertUpdate *)update;
+
+@end
+
+/** An object responsible for turning a \c TBAlertController into something on screen (or not).
+
+ Presenters call back into the alert controller with
+ \c -[TBAlertController presentation:didSelectButtonAtIndex:] when a button is chosen.
+ @see \c TBAlertController(TBAlertPresenter) */
+@protocol TBAlertPresenter <NSObject>
+
+/** Present the given alert.
+
+ @param alert The alert controller to present. Use the methods in \c TBAlertController(TBAlertPresenter) to inspect it.
+ @param viewController The view controller to present from. Presenters that don't need one may ignore it.
+ @param animated Whether or not to animate the presentation.
+ @param completion An optional block to execute once the alert has been presented.
+ @return The new presentation, or \c nil if the alert couldn't be presented, such as with no view controller
+ to present from; \c completion isn't called then. The alert controller treats this as being dismissed. */
+- (nullable id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                              fromViewController:(nullable UIViewController *)viewController
+                                        animated:(BOOL)animated
+                                      completion:(nullable TBVoidBlock)completion;
+
+@optional
+
+/** Does as much of the work of presenting \c alert as possible ahead of time, without showing anything.
+ Presenters which implement this must also implement \c presentAlert:preparedPresentation:fromViewController:animated:completion:.
+
+ The alert controller discards the result if its buttons, text fields, or popover source change.
+ Changes to its title or message are applied to the prepared presentation directly.
+ @return A presentation which is not yet visible, or \c nil if there is nothing worth preparing. */
+- (nullable id<TBAlertPresentation>)prepareAlert:(TBAlertController *)alert;
+
+/** Shows a presentation returned by \c prepareAlert:.
+ @return The presentation, now live, or \c nil if it couldn't be presented. */
+- (nullable id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                            preparedPresentation:(id<TBAlertPresentation>)preparedPresentation
+                              fromViewController:(nullable UIViewController *)viewController
+                                        animated:(BOOL)animated
+                                      completion:(nullable TBVoidBlock)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
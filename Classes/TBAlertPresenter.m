@@ -0,0 +1,141 @@
+//
+//  TBAlertPresenter.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPresenter.h"
+
+/** Finds the longest increasing subsequence of \c values.
+ @return Positions into \c values of the members of that subsequence. */
+static NSIndexSet *TBLongestIncreasingSubsequence(const NSUInteger *values, NSUInteger count) {
+    NSMutableIndexSet *positions = [NSMutableIndexSet new];
+    if (!count) {
+        return positions;
+    }
+
+    // tails[k] is the position of the smallest value ending an increasing run of length k+1
+    NSUInteger *tails = malloc(sizeof(NSUInteger) * count);
+    NSUInteger *previous = malloc(sizeof(NSUInteger) * count);
+    NSUInteger length = 0;
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSUInteger low = 0, high = length;
+        while (low < high) {
+            NSUInteger mid = (low + high) / 2;
+            if (values[tails[mid]] < values[i]) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        previous[i] = low > 0 ? tails[low - 1] : NSNotFound;
+        tails[low] = i;
+        if (low == length) {
+            length++;
+        }
+    }
+
+    for (NSUInteger i = tails[length - 1]; i != NSNotFound; i = previous[i]) {
+        [positions addIndex:i];
+    }
+
+    free(tails);
+    free(previous);
+    return positions;
+}
+
+@implementation TBAlertUpdate
+
+- (instancetype)initWithOldButtons:(NSArray *)oldButtons
+                         oldTitles:(NSArray<NSString *> *)oldTitles
+                         oldStyles:(NSArray<NSNumber *> *)oldStyles
+                  oldEnabledStates:(NSArray<NSNumber *> *)oldEnabledStates
+                           buttons:(NSArray *)buttons
+                            titles:(NSArray<NSString *> *)titles
+                            styles:(NSArray<NSNumber *> *)styles
+                     enabledStates:(NSArray<NSNumber *> *)enabledStates {
+    NSParameterAssert(oldButtons.count == oldTitles.count && oldButtons.count == oldStyles.count && oldButtons.count == oldEnabledStates.count);
+    NSParameterAssert(buttons.count == titles.count && buttons.count == styles.count && buttons.count == enabledStates.count);
+
+    self = [super init];
+    if (self) {
+        _buttons = buttons.copy;
+        _titles = titles.copy;
+        _styles = styles.copy;
+        _enabledStates = enabledStates.copy;
+
+        // Map each old button to its index; buttons aren't necessarily copyable
+        NSMapTable<id, NSNumber *> *oldIndexes = [NSMapTable strongToStrongObjectsMapTable];
+        [oldButtons enumerateObjectsUsingBlock:^(id button, NSUInteger i, BOOL *stop) {
+            [oldIndexes setObject:@(i) forKey:button];
+        }];
+
+        // Buttons present in both lists, in new order, and where they used to be
+        NSUInteger count = buttons.count;
+        NSUInteger *keptNewIndexes = malloc(sizeof(NSUInteger) * (count ?: 1));
+        NSUInteger *keptOldIndexes = malloc(sizeof(NSUInteger) * (count ?: 1));
+        NSUInteger kept = 0;
+
+        NSMutableIndexSet *inserted = [NSMutableIndexSet new];
+        NSMutableIndexSet *removed = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, oldButtons.count)];
+
+        for (NSUInteger i = 0; i < count; i++) {
+            NSNumber *oldIndex = [oldIndexes objectForKey:buttons[i]];
+            if (oldIndex && [removed containsIndex:oldIndex.unsignedIntegerValue] &&
+                [titles[i] isEqualToString:oldTitles[oldIndex.unsignedIntegerValue]]) {
+                keptNewIndexes[kept] = i;
+                keptOldIndexes[kept] = oldIndex.unsignedIntegerValue;
+                [removed removeIndex:oldIndex.unsignedIntegerValue];
+                kept++;
+            } else {
+                [inserted addIndex:i];
+            }
+        }
+
+        // The buttons which can stay put are the longest run still in their
+        // original order; everything else that was kept has to move
+        NSIndexSet *stable = TBLongestIncreasingSubsequence(keptOldIndexes, kept);
+        NSMutableIndexSet *reconfigured = [NSMutableIndexSet new];
+
+        for (NSUInteger k = 0; k < kept; k++) {
+            NSUInteger i = keptNewIndexes[k], old = keptOldIndexes[k];
+            if (![stable containsIndex:k]) {
+                [removed addIndex:old];
+                [inserted addIndex:i];
+            } else if (![styles[i] isEqualToNumber:oldStyles[old]] ||
+                       ![enabledStates[i] isEqualToNumber:oldEnabledStates[old]]) {
+                [reconfigured addIndex:i];
+            }
+        }
+
+        free(keptNewIndexes);
+        free(keptOldIndexes);
+
+        _removedIndexes = removed.copy;
+        _insertedIndexes = inserted.copy;
+        _reconfiguredIndexes = reconfigured.copy;
+    }
+
+    return self;
+}
+
+- (BOOL)changesStructure {
+    return self.removedIndexes.count || self.insertedIndexes.count;
+}
+
+- (BOOL)isEmpty {
+    return !self.changesStructure && !self.reconfiguredIndexes.count;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p removed=%@ inserted=%@ reconfigured=%@>",
+        NSStringFromClass([self class]), self,
+        self.removedIndexes, self.insertedIndexes, self.reconfiguredIndexes
+    ];
+}
+
+@end
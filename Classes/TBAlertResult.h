@@ -0,0 +1,68 @@
+//
+//  TBAlertResult.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertAction.h"
+#import "TBAlertTextFieldValues.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** How an alert presented for a result was resolved. */
+typedef NS_ENUM(NSInteger, TBAlertResultReason) {
+    /** A button was chosen, by the user or with \c dismissWithButtonIndex:. */
+    TBAlertResultReasonButton = 0,
+    /** The alert was dismissed without choosing a button. */
+    TBAlertResultReasonDismissed,
+    /** The cancellation token was cancelled. */
+    TBAlertResultReasonCancelled,
+    /** The timeout passed before a button was chosen. */
+    TBAlertResultReasonTimedOut
+};
+
+/** The outcome of \c -[TBAlertController presentForResultFromViewController:cancellationToken:timeout:completion:]. */
+@interface TBAlertResult : NSObject
+
+- (instancetype)initWithReason:(TBAlertResultReason)reason
+                   buttonIndex:(NSUInteger)buttonIndex
+              buttonIdentifier:(nullable NSString *)buttonIdentifier
+               textFieldValues:(nullable TBAlertTextFieldValues *)textFieldValues NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly) TBAlertResultReason reason;
+/** The index of the chosen button, or \c NSNotFound if no button was chosen. */
+@property (nonatomic, readonly) NSUInteger buttonIndex;
+/** The \c identifier of the chosen button's action, if it has one. */
+@property (nonatomic, readonly, nullable) NSString *buttonIdentifier;
+/** The text in the alert's text fields when a button was chosen, or \c nil if no button was chosen. */
+@property (nonatomic, readonly, nullable) TBAlertTextFieldValues *textFieldValues;
+
+@end
+
+/** Cancels one or more pending alert results. Cancelling dismisses every alert still
+ waiting on the token, without performing any action. Tokens cannot be reset.
+
+ Tokens may be used from any thread. Handlers are always called on the main thread. */
+@interface TBAlertCancellationToken : NSObject
+
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/** Cancels the token and calls every registered handler, once. Handlers are called before
+ this returns when called on the main thread, and asynchronously on it otherwise. */
+- (void)cancel;
+
+/** Registers a block to call when the token is cancelled, or calls it right away if it already was;
+ asynchronously, if this isn't called on the main thread.
+ @return An object to pass to \c removeCancellationHandler: once the handler is no longer needed. */
+- (id<NSObject>)addCancellationHandler:(TBVoidBlock)handler;
+/** Releases a handler registered with \c addCancellationHandler: without calling it,
+ unless it has already been called. */
+- (void)removeCancellationHandler:(id<NSObject>)registration;
+
+@end
+
+NS_ASSUME_NONNULL_END
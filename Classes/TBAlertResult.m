@@ -0,0 +1,130 @@
+//
+//  TBAlertResult.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertResult.h"
+
+#pragma mark - TBAlertResult
+
+@implementation TBAlertResult
+
+- (instancetype)initWithReason:(TBAlertResultReason)reason
+                   buttonIndex:(NSUInteger)buttonIndex
+              buttonIdentifier:(NSString *)buttonIdentifier
+               textFieldValues:(TBAlertTextFieldValues *)textFieldValues {
+    self = [super init];
+    if (self) {
+        _reason = reason;
+        _buttonIndex = buttonIndex;
+        _buttonIdentifier = buttonIdentifier.copy;
+        _textFieldValues = textFieldValues;
+    }
+
+    return self;
+}
+
+- (NSString *)description {
+    static NSString * const reasons[] = { @"button", @"dismissed", @"cancelled", @"timed out" };
+    return [NSString stringWithFormat:@"<%@: %p %@ index=%ld identifier=%@>",
+        NSStringFromClass([self class]), self, reasons[self.reason],
+        self.buttonIndex == NSNotFound ? -1L : (long)self.buttonIndex, self.buttonIdentifier
+    ];
+}
+
+@end
+
+#pragma mark - TBAlertCancellationToken
+
+@implementation TBAlertCancellationToken {
+    /// Keyed by registration, which isn't copyable and so can't be a dictionary key.
+    /// Only accessed while synchronized on \c self, as is \c _cancelled.
+    NSMapTable<id, TBVoidBlock> *_handlers;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _handlers = [NSMapTable strongToStrongObjectsMapTable];
+    }
+
+    return self;
+}
+
+- (BOOL)isCancelled {
+    @synchronized (self) {
+        return _cancelled;
+    }
+}
+
+- (void)cancel {
+    @synchronized (self) {
+        if (_cancelled) {
+            return;
+        }
+
+        _cancelled = YES;
+    }
+
+    [self callHandlersOnMainThread];
+}
+
+- (void)callHandlersOnMainThread {
+    if (NSThread.isMainThread) {
+        [self callHandlers];
+    } else {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self callHandlers];
+        });
+    }
+}
+
+/** Handlers may remove themselves or others while we call them, or be removed from other threads,
+ so take them out one at a time; one removed before its turn is never called. */
+- (void)callHandlers {
+    for (;;) {
+        TBVoidBlock handler = nil;
+        @synchronized (self) {
+            id registration = _handlers.keyEnumerator.nextObject;
+            if (!registration) {
+                return;
+            }
+
+            handler = [_handlers objectForKey:registration];
+            [_handlers removeObjectForKey:registration];
+        }
+
+        handler();
+    }
+}
+
+- (id<NSObject>)addCancellationHandler:(TBVoidBlock)handler {
+    NSParameterAssert(handler);
+
+    id<NSObject> registration = [NSObject new];
+    BOOL cancelled;
+    @synchronized (self) {
+        cancelled = _cancelled;
+        [_handlers setObject:[handler copy] forKey:registration];
+    }
+
+    // Call it the same way cancel would have, so that it can still be removed until then
+    if (cancelled) {
+        [self callHandlersOnMainThread];
+    }
+
+    return registration;
+}
+
+- (void)removeCancellationHandler:(id<NSObject>)registration {
+    if (registration) {
+        @synchronized (self) {
+            [_handlers removeObjectForKey:registration];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,75 @@
+//
+//  TBAlertScheduler.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertController.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** How urgent a scheduled alert is. Any value may be used; these are only landmarks. */
+typedef NS_ENUM(NSInteger, TBAlertPriority) {
+    TBAlertPriorityLow = 250,
+    TBAlertPriorityNormal = 500,
+    TBAlertPriorityHigh = 750,
+    /** The default \c preemptingPriority. */
+    TBAlertPriorityCritical = 1000
+};
+
+/** What to do with an alert scheduled at a priority which already has as many alerts waiting as its limit. */
+typedef NS_ENUM(NSInteger, TBAlertDropPolicy) {
+    /** The new alert is dropped. */
+    TBAlertDropPolicyNewest = 0,
+    /** The alert that has waited longest at that priority is dropped to make room. */
+    TBAlertDropPolicyOldest
+};
+
+/** Shows scheduled alerts one at a time, so that none are lost to a view controller that is already presenting.
+
+ The next alert is shown as soon as the current one is dismissed, by the user or otherwise: the one with
+ the highest priority, and of those the one scheduled first. Scheduling and choosing the next alert take
+ O(log n) time in the number of alerts waiting.
+
+ An alert of at least \c preemptingPriority interrupts a visible alert of lower priority. The interrupted
+ alert is taken off screen without being resolved and shown again, before any other alert of its priority,
+ once the interruption is over; its \c deadline starts over then. Dropped alerts are dismissed, as with
+ \c dismissAnimated:completion:. An alert dismissed while it waits is simply forgotten.
+
+ Alerts are shown with their own \c presenter, so a \c TBHeadlessAlertPresenter drives a scheduler without
+ UIKit. Schedulers may be used from any thread; everything but scheduling happens on the main thread. */
+@interface TBAlertScheduler : NSObject
+
+/** The scheduler used by \c -[TBAlertController scheduleWithPriority:fromViewController:].
+ May be read or replaced from any thread. */
+@property (nonatomic, class, null_resettable) TBAlertScheduler *sharedScheduler;
+
+/** Alerts of at least this priority interrupt visible alerts of lower priority. Defaults to \c TBAlertPriorityCritical. */
+@property (nonatomic) TBAlertPriority preemptingPriority;
+/** The alert shown by this scheduler which is currently visible, or about to be. */
+@property (nonatomic, readonly, nullable) TBAlertController *currentAlert;
+/** The number of alerts waiting to be shown, not counting \c currentAlert. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** Limits how many alerts of a given priority may wait at once. A limit of \c 0, the default, means no limit.
+ Alerts already waiting beyond a new limit are kept. Must be called on the main thread. */
+- (void)setLimit:(NSUInteger)limit dropPolicy:(TBAlertDropPolicy)policy forPriority:(TBAlertPriority)priority;
+
+/** Shows \c alert from \c viewController once every alert ahead of it has been dismissed, or right away
+ if there are none. Does nothing if \c alert is already scheduled or current. */
+- (void)scheduleAlert:(TBAlertController *)alert
+             priority:(TBAlertPriority)priority
+   fromViewController:(nullable UIViewController *)viewController;
+
+@end
+
+@interface TBAlertController (TBAlertScheduler)
+
+/** Schedules the alert with \c TBAlertScheduler.sharedScheduler. */
+- (void)scheduleWithPriority:(TBAlertPriority)priority fromViewController:(nullable UIViewController *)viewController;
+
+@end
+
+NS_ASSUME_NONNULL_END
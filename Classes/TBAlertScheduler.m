@@ -0,0 +1,321 @@
+//
+//  TBAlertScheduler.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertScheduler.h"
+
+/** Implemented in TBAlertController.m */
+@interface TBAlertController (TBAlertScheduling)
+- (nullable id<TBAlertPresentation>)currentPresentation;
+- (void)withdrawPresentationAnimated:(BOOL)animated completion:(nullable TBVoidBlock)completion;
+@end
+
+#pragma mark - TBAlertSchedulerEntry
+
+@interface TBAlertSchedulerEntry : NSObject {
+    @public
+    TBAlertController *_alert;
+    __weak UIViewController *_viewController;
+    TBAlertPriority _priority;
+    NSUInteger _sequence;
+}
+@end
+
+@implementation TBAlertSchedulerEntry
+@end
+
+#pragma mark - TBAlertScheduler
+
+typedef struct {
+    TBAlertPriority priority;
+    NSUInteger sequence;
+} TBScheduledAlert;
+
+/** Higher priorities first, and alerts of the same priority in the order they were scheduled. */
+static inline BOOL TBScheduledAlertBefore(TBScheduledAlert a, TBScheduledAlert b) {
+    return a.priority > b.priority || (a.priority == b.priority && a.sequence < b.sequence);
+}
+
+@implementation TBAlertScheduler {
+    /// A binary heap of every waiting alert, including dropped ones which haven't been popped yet
+    TBScheduledAlert *_heap;
+    NSUInteger _heapCount;
+    NSUInteger _heapCapacity;
+    NSUInteger _lastSequence;
+    /// Alerts which are still waiting, by sequence
+    NSMutableDictionary<NSNumber *, TBAlertSchedulerEntry *> *_entries;
+    /// The sequences of waiting alerts, by alert
+    NSMapTable<TBAlertController *, NSNumber *> *_sequences;
+    /// The sequences of waiting alerts of each priority; the first is the oldest
+    NSMutableDictionary<NSNumber *, NSMutableIndexSet *> *_sequencesByPriority;
+    NSMutableDictionary<NSNumber *, NSNumber *> *_limits;
+    NSMutableDictionary<NSNumber *, NSNumber *> *_dropPolicies;
+    TBAlertSchedulerEntry *_current;
+}
+
+/// Only accessed while synchronized on the \c TBAlertScheduler class, since alerts may be scheduled from any thread
+static TBAlertScheduler *_sharedScheduler = nil;
+
++ (TBAlertScheduler *)sharedScheduler {
+    @synchronized ([TBAlertScheduler class]) {
+        if (!_sharedScheduler) {
+            _sharedScheduler = [self new];
+        }
+
+        return _sharedScheduler;
+    }
+}
+
++ (void)setSharedScheduler:(TBAlertScheduler *)sharedScheduler {
+    @synchronized ([TBAlertScheduler class]) {
+        _sharedScheduler = sharedScheduler;
+    }
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _preemptingPriority = TBAlertPriorityCritical;
+        _entries = [NSMutableDictionary new];
+        _sequences = [NSMapTable strongToStrongObjectsMapTable];
+        _sequencesByPriority = [NSMutableDictionary new];
+        _limits = [NSMutableDictionary new];
+        _dropPolicies = [NSMutableDictionary new];
+
+        [NSNotificationCenter.defaultCenter addObserver:self
+            selector:@selector(alertDidDismiss:)
+            name:TBAlertControllerDidDismissNotification
+            object:nil
+        ];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    [NSNotificationCenter.defaultCenter removeObserver:self];
+    free(_heap);
+}
+
+- (TBAlertController *)currentAlert {
+    return _current ? _current->_alert : nil;
+}
+
+- (NSUInteger)count {
+    return _entries.count;
+}
+
+- (void)setLimit:(NSUInteger)limit dropPolicy:(TBAlertDropPolicy)policy forPriority:(TBAlertPriority)priority {
+    _limits[@(priority)] = limit ? @(limit) : nil;
+    _dropPolicies[@(priority)] = @(policy);
+}
+
+#pragma mark Scheduling
+
+- (void)scheduleAlert:(TBAlertController *)alert priority:(TBAlertPriority)priority fromViewController:(UIViewController *)viewController {
+    NSParameterAssert(alert);
+
+    if (!NSThread.isMainThread) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self scheduleAlert:alert priority:priority fromViewController:viewController];
+        });
+        return;
+    }
+
+    if (alert == self.currentAlert || [_sequences objectForKey:alert]) {
+        return;
+    }
+
+    TBAlertSchedulerEntry *entry = [TBAlertSchedulerEntry new];
+    entry->_alert = alert;
+    entry->_viewController = viewController;
+    entry->_priority = priority;
+    entry->_sequence = ++_lastSequence;
+
+    if (!_current) {
+        [self presentEntry:entry];
+        return;
+    }
+
+    if (priority >= self.preemptingPriority && priority > _current->_priority) {
+        [self preemptWithEntry:entry];
+        return;
+    }
+
+    if ([self makeRoomForEntry:entry]) {
+        [self enqueueEntry:entry];
+    }
+}
+
+/** Drops an alert if the new alert's priority is at its limit.
+ @return \c NO if the new alert is the one to drop, which has been dismissed. */
+- (BOOL)makeRoomForEntry:(TBAlertSchedulerEntry *)entry {
+    NSUInteger limit = _limits[@(entry->_priority)].unsignedIntegerValue;
+    NSMutableIndexSet *waiting = _sequencesByPriority[@(entry->_priority)];
+    if (!limit || waiting.count < limit) {
+        return YES;
+    }
+
+    if ((TBAlertDropPolicy)_dropPolicies[@(entry->_priority)].integerValue == TBAlertDropPolicyNewest) {
+        [entry->_alert dismissAnimated:NO completion:nil];
+        return NO;
+    }
+
+    TBAlertSchedulerEntry *oldest = [self dequeueEntryWithSequence:waiting.firstIndex];
+    [oldest->_alert dismissAnimated:NO completion:nil];
+    return YES;
+}
+
+/** Takes the current alert off screen and puts it back at the front of its priority, then shows \c entry. */
+- (void)preemptWithEntry:(TBAlertSchedulerEntry *)entry {
+    TBAlertSchedulerEntry *preempted = _current;
+    [self enqueueEntry:preempted];
+
+    // Claim the screen now, so that alerts scheduled meanwhile wait their turn
+    _current = entry;
+    [preempted->_alert withdrawPresentationAnimated:YES completion:^{
+        if (self->_current == entry) {
+            [self showEntry:entry];
+        }
+    }];
+}
+
+#pragma mark Presenting
+
+- (void)presentEntry:(TBAlertSchedulerEntry *)entry {
+    _current = entry;
+    [self showEntry:entry];
+}
+
+- (void)showEntry:(TBAlertSchedulerEntry *)entry {
+    TBAlertController *alert = entry->_alert;
+    [alert showFromViewController:entry->_viewController animated:YES completion:nil];
+
+    // Folded into another alert by a coalescer, or already dismissed, such as when it couldn't be
+    // presented; either way, it's not waiting on us
+    if (_current == entry && ![alert currentPresentation]) {
+        _current = nil;
+        [self presentNext];
+    }
+}
+
+- (void)presentNext {
+    while (_heapCount && !_current) {
+        TBAlertSchedulerEntry *entry = [self dequeueEntryWithSequence:[self pop].sequence];
+        if (entry) {
+            [self presentEntry:entry];
+        }
+    }
+}
+
+- (void)alertDidDismiss:(NSNotification *)notification {
+    TBAlertController *alert = notification.object;
+    if (alert == self.currentAlert) {
+        _current = nil;
+        [self presentNext];
+        return;
+    }
+
+    // Dismissed while it was waiting, such as by a cancellation token
+    NSNumber *sequence = [_sequences objectForKey:alert];
+    if (sequence) {
+        [self dequeueEntryWithSequence:sequence.unsignedIntegerValue];
+    }
+}
+
+#pragma mark Queue
+
+- (void)enqueueEntry:(TBAlertSchedulerEntry *)entry {
+    NSNumber *sequence = @(entry->_sequence);
+    _entries[sequence] = entry;
+    [_sequences setObject:sequence forKey:entry->_alert];
+
+    NSMutableIndexSet *waiting = _sequencesByPriority[@(entry->_priority)];
+    if (!waiting) {
+        waiting = [NSMutableIndexSet new];
+        _sequencesByPriority[@(entry->_priority)] = waiting;
+    }
+    [waiting addIndex:entry->_sequence];
+
+    [self push:(TBScheduledAlert){ entry->_priority, entry->_sequence }];
+}
+
+/** Forgets a waiting alert. Its heap entry stays until it reaches the top; it's skipped then.
+ @return The alert's entry, or \c nil if it is no longer waiting. */
+- (TBAlertSchedulerEntry *)dequeueEntryWithSequence:(NSUInteger)sequence {
+    TBAlertSchedulerEntry *entry = _entries[@(sequence)];
+    if (!entry) {
+        return nil;
+    }
+
+    [_entries removeObjectForKey:@(sequence)];
+    [_sequences removeObjectForKey:entry->_alert];
+    [_sequencesByPriority[@(entry->_priority)] removeIndex:sequence];
+    return entry;
+}
+
+#pragma mark Heap
+
+- (void)push:(TBScheduledAlert)alert {
+    if (_heapCount == _heapCapacity) {
+        _heapCapacity = MAX(_heapCapacity * 2, 16);
+        _heap = realloc(_heap, sizeof(TBScheduledAlert) * _heapCapacity);
+    }
+
+    NSUInteger i = _heapCount++;
+    while (i > 0) {
+        NSUInteger parent = (i - 1) / 2;
+        if (!TBScheduledAlertBefore(alert, _heap[parent])) {
+            break;
+        }
+
+        _heap[i] = _heap[parent];
+        i = parent;
+    }
+
+    _heap[i] = alert;
+}
+
+- (TBScheduledAlert)pop {
+    TBScheduledAlert top = _heap[0];
+    TBScheduledAlert last = _heap[--_heapCount];
+
+    NSUInteger i = 0;
+    while (YES) {
+        NSUInteger child = i * 2 + 1;
+        if (child >= _heapCount) {
+            break;
+        }
+        if (child + 1 < _heapCount && TBScheduledAlertBefore(_heap[child + 1], _heap[child])) {
+            child++;
+        }
+        if (!TBScheduledAlertBefore(_heap[child], last)) {
+            break;
+        }
+
+        _heap[i] = _heap[child];
+        i = child;
+    }
+
+    if (_heapCount) {
+        _heap[i] = last;
+    }
+
+    return top;
+}
+
+@end
+
+#pragma mark - TBAlertController (TBAlertScheduler)
+
+@implementation TBAlertController (TBAlertScheduler)
+
+- (void)scheduleWithPriority:(TBAlertPriority)priority fromViewController:(UIViewController *)viewController {
+    [TBAlertScheduler.sharedScheduler scheduleAlert:self priority:priority fromViewController:viewController];
+}
+
+@end
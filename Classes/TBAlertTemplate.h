@@ -0,0 +1,65 @@
+//
+//  TBAlertTemplate.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertController.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** An immutable description of an alert, compiled once and used to cheaply create
+ any number of identical (or nearly identical) \c TBAlertControllers.
+
+ The title, message, and button titles may contain placeholders such as \c {count},
+ which are replaced with the matching parameter when an alert controller is created.
+ Placeholders without a matching parameter are left as-is.
+
+ Templates are safe to share between threads. Text field configuration handlers and
+ button actions are shared by every alert controller created from a template. Buttons keep
+ their identifiers.
+
+ Title providers, on the alert or its buttons, are not called when the template is compiled.
+ Each alert controller gets its own provider, which calls the original the first time the string is
+ read and replaces placeholders in the result. Their placeholders are not in \c placeholderNames. */
+@interface TBAlertTemplate : NSObject <NSCopying>
+
+/** Compile an alert-style template from a builder block. The block is run exactly once. */
++ (instancetype)alertTemplate:(TBAlertBuilder)block;
+/** Compile an action sheet-style template from a builder block. The block is run exactly once. */
++ (instancetype)sheetTemplate:(TBAlertBuilder)block;
+
+/** Compile a template from an existing alert controller, such as one built with the
+ \c addOtherButtonWithTitle: family of methods. Later changes to \c alert do not affect the template. */
+- (instancetype)initWithAlertController:(TBAlertController *)alert;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** The style of alert controllers created from this template. */
+@property (nonatomic, readonly) TBAlertControllerStyle style;
+/** The title, with placeholders intact, or \c nil if it comes from a provider. */
+@property (nonatomic, readonly, nullable) NSString *title;
+/** The message, with placeholders intact, or \c nil if it comes from a provider. */
+@property (nonatomic, readonly, nullable) NSString *message;
+/** The button titles, with placeholders intact, and an empty string for each title that comes
+ from a provider. The cancel button, if any, is last. */
+@property (nonatomic, readonly) NSArray<NSString *> *buttonTitles;
+/** The names of every placeholder used in the title, message, and button titles. */
+@property (nonatomic, readonly) NSSet<NSString *> *placeholderNames;
+
+/** @return A new alert controller, with placeholders left as-is. */
+- (TBAlertController *)alertController;
+/** @return A new alert controller, with placeholders replaced by the \c description of the matching parameter. */
+- (TBAlertController *)alertControllerWithParameters:(nullable NSDictionary<NSString *, id> *)parameters;
+/** @return A new alert controller, with placeholders replaced by the \c description of the matching parameter.
+ @param handlers Blocks to use in place of the template's button actions, keyed by the button's title
+ as it appears in \c buttonTitles, or by its identifier if its title comes from a provider.
+ Buttons without an entry keep the template's action. */
+- (TBAlertController *)alertControllerWithParameters:(nullable NSDictionary<NSString *, id> *)parameters
+                                            handlers:(nullable NSDictionary<NSString *, TBAlertActionBlock> *)handlers;
+
+@end
+
+NS_ASSUME_NONNULL_END
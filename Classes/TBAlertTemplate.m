@@ -0,0 +1,336 @@
+//
+//  TBAlertTemplate.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertTemplate.h"
+
+#pragma mark - TBAlertTemplateString
+
+/// A string split into literal text and {placeholder} names, so that
+/// substituting parameters is a single pass with no searching.
+@interface TBAlertTemplateString : NSObject
+/// @return \c nil if \c format is \c nil
++ (instancetype)stringWithTemplate:(NSString *)format;
+@property (nonatomic, readonly) NSString *format;
+/// Literal text surrounding each placeholder; always one more than \c names
+@property (nonatomic, readonly) NSArray<NSString *> *literals;
+@property (nonatomic, readonly) NSArray<NSString *> *names;
+- (NSString *)stringWithParameters:(NSDictionary<NSString *, id> *)parameters;
+@end
+
+@implementation TBAlertTemplateString
+
++ (instancetype)stringWithTemplate:(NSString *)format {
+    if (!format) {
+        return nil;
+    }
+
+    TBAlertTemplateString *string = [self new];
+    string->_format = format.copy;
+
+    NSMutableArray *literals = [NSMutableArray new];
+    NSMutableArray *names = [NSMutableArray new];
+    NSMutableString *literal = [NSMutableString new];
+    NSUInteger length = format.length, location = 0;
+
+    while (location < length) {
+        NSRange open = [format rangeOfString:@"{" options:0 range:NSMakeRange(location, length - location)];
+        if (open.location == NSNotFound) {
+            break;
+        }
+
+        NSUInteger nameStart = NSMaxRange(open);
+        NSRange close = [format rangeOfString:@"}" options:0 range:NSMakeRange(nameStart, length - nameStart)];
+        if (close.location == NSNotFound) {
+            break;
+        }
+
+        NSString *name = [format substringWithRange:NSMakeRange(nameStart, close.location - nameStart)];
+
+        // "{}" and "{ {name}" aren't placeholders; keep the brace and move on
+        if (!name.length || [name rangeOfString:@"{"].location != NSNotFound) {
+            [literal appendString:[format substringWithRange:NSMakeRange(location, nameStart - location)]];
+            location = nameStart;
+            continue;
+        }
+
+        [literal appendString:[format substringWithRange:NSMakeRange(location, open.location - location)]];
+        [literals addObject:literal.copy];
+        [names addObject:name];
+        [literal setString:@""];
+        location = NSMaxRange(close);
+    }
+
+    [literal appendString:[format substringFromIndex:location]];
+    [literals addObject:literal.copy];
+
+    string->_literals = literals.copy;
+    string->_names = names.copy;
+    return string;
+}
+
+- (NSString *)stringWithParameters:(NSDictionary<NSString *, id> *)parameters {
+    // Nothing to substitute; share the original string
+    if (!self.names.count || !parameters.count) {
+        return self.format;
+    }
+
+    NSMutableString *result = [NSMutableString stringWithString:self.literals[0]];
+    NSUInteger i = 0;
+    for (NSString *name in self.names) {
+        id value = parameters[name];
+        if (value) {
+            [result appendString:[value description]];
+        } else {
+            [result appendFormat:@"{%@}", name];
+        }
+
+        [result appendString:self.literals[++i]];
+    }
+
+    return result.copy;
+}
+
+@end
+
+#pragma mark - TBAlertTemplate
+
+static NSUInteger TBNumberOfTextFieldsForAlertViewStyle(UIAlertViewStyle style) {
+    switch (style) {
+        case UIAlertViewStyleLoginAndPasswordInput:
+            return 2;
+        case UIAlertViewStylePlainTextInput:
+        case UIAlertViewStyleSecureTextInput:
+            return 1;
+        case UIAlertViewStyleDefault:
+            return 0;
+    }
+
+    return 0;
+}
+
+/// @return A new action with the given title which does the same thing as \c prototype, or runs \c block if given.
+/// It keeps the prototype's identifier, and its title provider, if any, which takes precedence over \c title.
+static TBAlertAction *TBAlertActionFromPrototype(TBAlertAction *prototype, NSString *title, TBAlertActionBlock block) {
+    TBAlertAction *action = nil;
+
+    if (block) {
+        action = [[TBAlertAction alloc] initWithTitle:title block:block];
+    } else {
+        switch (prototype.style) {
+            case TBAlertActionStyleNoAction:
+                action = [[TBAlertAction alloc] initWithTitle:title];
+                break;
+            case TBAlertActionStyleBlock:
+                action = [[TBAlertAction alloc] initWithTitle:title block:prototype.block];
+                break;
+            case TBAlertActionStyleTarget:
+                action = [[TBAlertAction alloc] initWithTitle:title target:prototype.target action:prototype.action];
+                break;
+            case TBAlertActionStyleTargetObject:
+                action = [[TBAlertAction alloc]
+                    initWithTitle:title target:prototype.target action:prototype.action object:prototype.object
+                ];
+                break;
+            case TBAlertActionStyleTargetArguments:
+                action = [[TBAlertAction alloc]
+                    initWithTitle:title target:prototype.target action:prototype.action arguments:prototype.arguments
+                ];
+                break;
+        }
+    }
+
+    action.enabled = prototype.enabled;
+    action.identifier = prototype.identifier;
+    action.titleProvider = prototype.titleProvider;
+    return action;
+}
+
+/// @return A provider whose result has placeholders replaced with \c parameters, or \c nil without a \c provider
+static TBAlertStringProvider TBAlertTemplateProvider(TBAlertStringProvider provider, NSDictionary<NSString *, id> *parameters) {
+    if (!provider || !parameters.count) {
+        return provider;
+    }
+
+    parameters = parameters.copy;
+    return ^NSString *{
+        return [[TBAlertTemplateString stringWithTemplate:provider()] stringWithParameters:parameters];
+    };
+}
+
+@interface TBAlertTemplate ()
+@property (nonatomic, readonly, nullable) TBAlertTemplateString *templateTitle;
+@property (nonatomic, readonly, nullable) TBAlertTemplateString *templateMessage;
+/// Called by each alert controller instead, if set; never called by the template
+@property (nonatomic, readonly, nullable) TBAlertStringProvider titleProvider;
+@property (nonatomic, readonly, nullable) TBAlertStringProvider messageProvider;
+/// \c NSNull for buttons whose title comes from a provider
+@property (nonatomic, readonly) NSArray *templateButtonTitles;
+/// Not shared with created alert controllers; copied from instead
+@property (nonatomic, readonly) NSArray<TBAlertAction *> *prototypes;
+@property (nonatomic, readonly) BOOL hasCancelButton;
+@property (nonatomic, readonly) NSInteger destructiveButtonIndex;
+@property (nonatomic, readonly) UIAlertViewStyle alertViewStyle;
+@property (nonatomic, readonly) NSArray *textFieldHandlers;
+@property (nonatomic, readonly) NSArray *textFieldIdentifiers;
+@end
+
+@implementation TBAlertTemplate
+
++ (instancetype)alertTemplate:(TBAlertBuilder)block {
+    return [[self alloc] initWithAlertController:[TBAlert makeAlert:block]];
+}
+
++ (instancetype)sheetTemplate:(TBAlertBuilder)block {
+    return [[self alloc] initWithAlertController:[TBAlert makeSheet:block]];
+}
+
+- (instancetype)initWithAlertController:(TBAlertController *)alert {
+    NSParameterAssert(alert);
+
+    self = [super init];
+    if (self) {
+        _style = alert.style;
+
+        // Providers are kept for each alert controller to call when it's shown, not called now
+        _titleProvider = alert.titleProvider;
+        _messageProvider = alert.messageProvider;
+        if (!_titleProvider) {
+            _templateTitle = [TBAlertTemplateString stringWithTemplate:alert.title];
+        }
+        if (!_messageProvider) {
+            _templateMessage = [TBAlertTemplateString stringWithTemplate:alert.message];
+        }
+        _destructiveButtonIndex = alert.destructiveButtonIndex;
+        _alertViewStyle = alert.alertViewStyle;
+
+        // Skip the text fields implied by alertViewStyle; we set that directly
+        NSArray *handlers = alert.textFieldConfigurationHandlers;
+        NSUInteger implied = TBNumberOfTextFieldsForAlertViewStyle(alert.alertViewStyle);
+        NSRange added = NSMakeRange(implied, handlers.count - implied);
+        _textFieldHandlers = [handlers subarrayWithRange:added];
+        _textFieldIdentifiers = [alert.textFieldIdentifiers subarrayWithRange:added];
+
+        NSArray<TBAlertAction *> *actions = alert.actions;
+        NSMutableArray *titles = [NSMutableArray arrayWithCapacity:actions.count];
+        NSMutableArray *prototypes = [NSMutableArray arrayWithCapacity:actions.count];
+        for (TBAlertAction *action in actions) {
+            if (action.titleProvider) {
+                [titles addObject:[NSNull null]];
+                [prototypes addObject:TBAlertActionFromPrototype(action, @"", nil)];
+            } else {
+                NSString *title = action.title;
+                [titles addObject:[TBAlertTemplateString stringWithTemplate:title]];
+                [prototypes addObject:TBAlertActionFromPrototype(action, title, nil)];
+            }
+        }
+
+        _templateButtonTitles = titles.copy;
+        _prototypes = prototypes.copy;
+        _hasCancelButton = actions.count &&
+            [alert actionStyleForButtonAtIndex:actions.count - 1] == UIAlertActionStyleCancel;
+
+        NSMutableSet *names = [NSMutableSet new];
+        for (TBAlertTemplateString *string in titles) {
+            if (string != (id)[NSNull null]) {
+                [names addObjectsFromArray:string.names];
+            }
+        }
+        [names addObjectsFromArray:_templateTitle.names ?: @[]];
+        [names addObjectsFromArray:_templateMessage.names ?: @[]];
+        _placeholderNames = names.copy;
+    }
+
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+#pragma mark Properties
+
+- (NSString *)title {
+    return self.templateTitle.format;
+}
+
+- (NSString *)message {
+    return self.templateMessage.format;
+}
+
+- (NSArray<NSString *> *)buttonTitles {
+    NSMutableArray *titles = [NSMutableArray arrayWithCapacity:self.templateButtonTitles.count];
+    for (TBAlertTemplateString *title in self.templateButtonTitles) {
+        [titles addObject:title == (id)[NSNull null] ? @"" : title.format];
+    }
+
+    return titles;
+}
+
+#pragma mark Creating alert controllers
+
+- (TBAlertController *)alertController {
+    return [self alertControllerWithParameters:nil handlers:nil];
+}
+
+- (TBAlertController *)alertControllerWithParameters:(NSDictionary<NSString *, id> *)parameters {
+    return [self alertControllerWithParameters:parameters handlers:nil];
+}
+
+- (TBAlertController *)alertControllerWithParameters:(NSDictionary<NSString *, id> *)parameters
+                                            handlers:(NSDictionary<NSString *, TBAlertActionBlock> *)handlers {
+    TBAlertController *alert = [[TBAlertController alloc] initWithStyle:self.style];
+    if (self.titleProvider) {
+        alert.titleProvider = TBAlertTemplateProvider(self.titleProvider, parameters);
+    } else {
+        alert.title = [self.templateTitle stringWithParameters:parameters];
+    }
+    if (self.messageProvider) {
+        alert.messageProvider = TBAlertTemplateProvider(self.messageProvider, parameters);
+    } else {
+        alert.message = [self.templateMessage stringWithParameters:parameters];
+    }
+
+    if (self.alertViewStyle != UIAlertViewStyleDefault) {
+        alert.alertViewStyle = self.alertViewStyle;
+    }
+    [self.textFieldHandlers enumerateObjectsUsingBlock:^(id handler, NSUInteger i, BOOL *stop) {
+        id identifier = self.textFieldIdentifiers[i];
+        [alert addTextFieldWithIdentifier:identifier == [NSNull null] ? nil : identifier configurationHandler:handler];
+    }];
+
+    NSUInteger count = self.prototypes.count;
+    NSUInteger otherButtons = self.hasCancelButton ? count - 1 : count;
+    for (NSUInteger i = 0; i < count; i++) {
+        TBAlertAction *prototype = self.prototypes[i];
+        TBAlertTemplateString *title = self.templateButtonTitles[i];
+        TBAlertAction *action = nil;
+        if (title == (id)[NSNull null]) {
+            TBAlertActionBlock handler = prototype.identifier ? handlers[prototype.identifier] : nil;
+            action = TBAlertActionFromPrototype(prototype, @"", handler);
+            action.titleProvider = TBAlertTemplateProvider(prototype.titleProvider, parameters);
+        } else {
+            action = TBAlertActionFromPrototype(
+                prototype, [title stringWithParameters:parameters], handlers[title.format]
+            );
+        }
+
+        if (i < otherButtons) {
+            [alert addAction:action];
+        } else {
+            [alert setCancelButton:action];
+        }
+    }
+
+    if (self.destructiveButtonIndex != NSNotFound) {
+        alert.destructiveButtonIndex = self.destructiveButtonIndex;
+    }
+
+    return alert;
+}
+
+@end
@@ -0,0 +1,32 @@
+//
+//  TBAlertTextFieldValues.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPlatform.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** An immutable snapshot of the text in each of an alert's text fields, taken once when
+ the alert is dismissed by a button. This is the array passed to every \c TBAlertActionBlock.
+
+ Values can be looked up by index like any other array, or by the identifier given to
+ \c addTextFieldWithIdentifier:configurationHandler:. Text fields added by \c alertViewStyle
+ are identified by \c "login" and \c "password" where applicable. */
+@interface TBAlertTextFieldValues : NSArray<NSString *>
+
+/** Captures the text of each text field. Text fields with no text are captured as empty strings.
+ @param identifiers An array parallel to \c textFields, with \c NSNull for unidentified text fields. */
+- (instancetype)initWithTextFields:(NSArray<UITextField *> *)textFields identifiers:(nullable NSArray *)identifiers;
+
+/** @return The text of the text field with the given identifier, or \c nil if there is no such text field. */
+- (nullable NSString *)stringForIdentifier:(NSString *)identifier;
+/** Same as \c stringForIdentifier: */
+- (nullable NSString *)objectForKeyedSubscript:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
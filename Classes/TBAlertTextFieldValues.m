@@ -0,0 +1,64 @@
+//
+//  TBAlertTextFieldValues.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertTextFieldValues.h"
+
+@interface TBAlertTextFieldValues ()
+@property (nonatomic, readonly) NSArray<NSString *> *strings;
+@property (nonatomic, readonly, nullable) NSArray *identifiers;
+@end
+
+@implementation TBAlertTextFieldValues
+
+- (instancetype)initWithTextFields:(NSArray<UITextField *> *)textFields identifiers:(NSArray *)identifiers {
+    NSParameterAssert(!identifiers || identifiers.count == textFields.count);
+
+    self = [super init];
+    if (self) {
+        NSMutableArray *strings = [NSMutableArray arrayWithCapacity:textFields.count];
+        for (UITextField *textField in textFields) {
+            [strings addObject:textField.text.copy ?: @""];
+        }
+
+        _strings = strings.copy;
+        _identifiers = identifiers.copy;
+    }
+
+    return self;
+}
+
+#pragma mark NSArray
+
+- (NSUInteger)count {
+    return self.strings.count;
+}
+
+- (NSString *)objectAtIndex:(NSUInteger)index {
+    return self.strings[index];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+#pragma mark Identifiers
+
+- (NSString *)stringForIdentifier:(NSString *)identifier {
+    NSUInteger index = [self.identifiers indexOfObject:identifier];
+    if (index == NSNotFound) {
+        return nil;
+    }
+
+    return self.strings[index];
+}
+
+- (NSString *)objectForKeyedSubscript:(NSString *)identifier {
+    return [self stringForIdentifier:identifier];
+}
+
+@end
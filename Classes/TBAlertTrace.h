@@ -0,0 +1,122 @@
+//
+//  TBAlertTrace.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPlatform.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** The stages of an alert's life that are traced. */
+typedef NS_ENUM(uint8_t, TBAlertTraceEvent) {
+    /// Building an alert with \c +[TBAlert make:withStyle:]
+    TBAlertTraceEventBuild = 0,
+    /// \c prepareForPresentation
+    TBAlertTraceEventPrepare,
+    /// Handing the alert to its presenter, up to the presenter returning
+    TBAlertTraceEventPresent,
+    /// The presenter's completion; the alert is on screen
+    TBAlertTraceEventVisible,
+    /// A button was chosen, by the user or by \c dismissWithButtonIndex:
+    TBAlertTraceEventDecision,
+    /// Performing the chosen button's action
+    TBAlertTraceEventHandler,
+};
+
+typedef NS_ENUM(uint8_t, TBAlertTracePhase) {
+    TBAlertTracePhaseBegin = 0,
+    TBAlertTracePhaseEnd,
+    /// For events which have no duration, like \c TBAlertTraceEventDecision
+    TBAlertTracePhaseInstant,
+};
+
+/** A single traced event. */
+typedef struct {
+    /// Nanoseconds of system uptime; only differences between values are meaningful
+    uint64_t timestamp;
+    /// The \c traceIdentifier of the alert controller
+    uint64_t alert;
+    TBAlertTraceEvent event;
+    TBAlertTracePhase phase;
+} TBAlertTraceRecord;
+
+/** @return A short, stable name for \c event, such as \c "decision". */
+extern NSString *TBAlertTraceEventName(TBAlertTraceEvent event);
+/** @return \c "begin", \c "end", or \c "instant". */
+extern NSString *TBAlertTracePhaseName(TBAlertTracePhase phase);
+
+/** Receives traced events. Events are recorded on whichever thread the alert is used from. */
+@protocol TBAlertTraceSink <NSObject>
+- (void)recordTraceEvent:(TBAlertTraceRecord)record;
+@end
+
+/** Where alert controllers send their lifecycle events. Tracing is disabled until a sink is installed,
+ and costs a single load and branch per event while disabled. */
+@interface TBAlertTrace : NSObject
+
+/** Installing a sink is safe from any thread, at any time. Remove or replace it only while no alerts
+ are being used from other threads, which may still be recording events with the old one. */
+@property (nonatomic, class, nullable) id<TBAlertTraceSink> sink;
+
+@end
+
+/** The default sink: a fixed-size ring buffer which keeps the most recent events.
+ Any number of threads may record events without locking; recording never allocates, and only
+ waits on a writer a full lap behind that is still writing the same slot. Once the buffer is full,
+ it overwrites the oldest events. Drain it periodically from one thread
+ at a time, such as a background queue that uploads the events. */
+@interface TBAlertTraceBuffer : NSObject <TBAlertTraceSink>
+
+/** @param capacity Rounded up to a power of two. */
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+/** Holds 4096 events. */
+- (instancetype)init;
+
+@property (nonatomic, readonly) NSUInteger capacity;
+/** The number of events overwritten before they could be drained. */
+@property (nonatomic, readonly) NSUInteger droppedCount;
+
+/** Removes every event recorded so far, in the order they were recorded.
+ @return The number of events passed to \c block. */
+- (NSUInteger)drainRecordsUsingBlock:(void (^)(TBAlertTraceRecord record))block;
+/** Removes every event recorded so far and encodes them as a JSON array of objects
+ with \c "alert", \c "event", \c "phase", and \c "timestamp" keys. */
+- (NSData *)drainJSON;
+
+@end
+
+#if __has_include(<os/signpost.h>)
+/** Forwards events to \c os_signpost, as intervals per alert, for viewing in Instruments. */
+API_AVAILABLE(ios(12.0), macos(10.14))
+@interface TBAlertSignpostTraceSink : NSObject <TBAlertTraceSink>
+/** Uses the subsystem \c "TBAlertController" and the category \c "Lifecycle". */
+- (instancetype)init;
+@end
+#endif
+
+#pragma mark - Recording events
+
+/** Non-zero while a sink is installed. Only access it atomically, such as through \c TBAlertTraceIsEnabled;
+ it's a plain \c BOOL rather than \c _Atomic so that this header can be imported from Objective-C++. */
+extern BOOL TBAlertTraceEnabled;
+
+/** Whether a sink is installed. The flag is set with release ordering after the sink is,
+ so once this returns \c YES, the sink is visible to the calling thread too. */
+static inline BOOL TBAlertTraceIsEnabled(void) {
+    return __atomic_load_n(&TBAlertTraceEnabled, __ATOMIC_ACQUIRE);
+}
+
+/** Stamps and records an event with the installed sink. Prefer \c TBAlertTraceEmit. */
+extern void TBAlertTraceRecordEvent(uint64_t alert, TBAlertTraceEvent event, TBAlertTracePhase phase);
+
+/** Records an event if tracing is enabled. */
+static inline void TBAlertTraceEmit(uint64_t alert, TBAlertTraceEvent event, TBAlertTracePhase phase) {
+    if (__builtin_expect(TBAlertTraceIsEnabled(), NO)) {
+        TBAlertTraceRecordEvent(alert, event, phase);
+    }
+}
+
+NS_ASSUME_NONNULL_END
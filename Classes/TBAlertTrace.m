@@ -0,0 +1,280 @@
+//
+//  TBAlertTrace.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertTrace.h"
+#import <stdatomic.h>
+#if __APPLE__
+#import <mach/mach_time.h>
+#endif
+#if __has_include(<os/signpost.h>)
+#import <os/signpost.h>
+#endif
+
+NSString *TBAlertTraceEventName(TBAlertTraceEvent event) {
+    switch (event) {
+        case TBAlertTraceEventBuild: return @"build";
+        case TBAlertTraceEventPrepare: return @"prepare";
+        case TBAlertTraceEventPresent: return @"present";
+        case TBAlertTraceEventVisible: return @"visible";
+        case TBAlertTraceEventDecision: return @"decision";
+        case TBAlertTraceEventHandler: return @"handler";
+    }
+
+    return @"unknown";
+}
+
+NSString *TBAlertTracePhaseName(TBAlertTracePhase phase) {
+    switch (phase) {
+        case TBAlertTracePhaseBegin: return @"begin";
+        case TBAlertTracePhaseEnd: return @"end";
+        case TBAlertTracePhaseInstant: return @"instant";
+    }
+
+    return @"unknown";
+}
+
+/** Nanoseconds of uptime, from the cheapest clock that doesn't jump. */
+static uint64_t TBAlertTraceNow(void) {
+#if __APPLE__
+    static mach_timebase_info_data_t timebase;
+    if (!timebase.denom) {
+        mach_timebase_info(&timebase);
+    }
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
+#endif
+}
+
+#pragma mark - Recording
+
+BOOL TBAlertTraceEnabled = NO;
+/// The installed sink, retained; ARC can't manage an \c _Atomic object pointer
+static _Atomic(void *) TBAlertTraceCurrentSink = NULL;
+
+void TBAlertTraceRecordEvent(uint64_t alert, TBAlertTraceEvent event, TBAlertTracePhase phase) {
+    id<TBAlertTraceSink> sink = (__bridge id)atomic_load_explicit(&TBAlertTraceCurrentSink, memory_order_acquire);
+    [sink recordTraceEvent:(TBAlertTraceRecord){ TBAlertTraceNow(), alert, event, phase }];
+}
+
+@implementation TBAlertTrace
+
++ (id<TBAlertTraceSink>)sink {
+    return (__bridge id)atomic_load_explicit(&TBAlertTraceCurrentSink, memory_order_acquire);
+}
+
++ (void)setSink:(id<TBAlertTraceSink>)sink {
+    // Turn tracing off before the old sink goes away, and on only once the new one is visible
+    if (!sink) {
+        __atomic_store_n(&TBAlertTraceEnabled, NO, __ATOMIC_RELEASE);
+    }
+
+    // Released at the end of this scope
+    __unused id old = (__bridge_transfer id)atomic_exchange_explicit(
+        &TBAlertTraceCurrentSink, (__bridge_retained void *)sink, memory_order_acq_rel
+    );
+
+    if (sink) {
+        __atomic_store_n(&TBAlertTraceEnabled, YES, __ATOMIC_RELEASE);
+    }
+}
+
+@end
+
+#pragma mark - TBAlertTraceBuffer
+
+typedef struct {
+    /// The position of the record plus one, with \c TBAlertTraceSlotWriting set while it is being written
+    _Atomic(uint64_t) sequence;
+    TBAlertTraceRecord record;
+} TBAlertTraceSlot;
+
+static const uint64_t TBAlertTraceSlotWriting = 1ull << 63;
+
+@implementation TBAlertTraceBuffer {
+    TBAlertTraceSlot *_slots;
+    NSUInteger _mask;
+    /// The position of the next record to be written; only ever increases
+    _Atomic(uint64_t) _head;
+    /// The position of the next record to be drained; only touched by the draining thread
+    uint64_t _tail;
+    _Atomic(uint64_t) _dropped;
+}
+
+- (instancetype)init {
+    return [self initWithCapacity:4096];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    NSParameterAssert(capacity > 0);
+
+    self = [super init];
+    if (self) {
+        NSUInteger size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        _capacity = size;
+        _mask = size - 1;
+        _slots = calloc(size, sizeof(TBAlertTraceSlot));
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    free(_slots);
+}
+
+- (NSUInteger)droppedCount {
+    return (NSUInteger)atomic_load_explicit(&_dropped, memory_order_relaxed);
+}
+
+- (void)recordTraceEvent:(TBAlertTraceRecord)record {
+    uint64_t position = atomic_fetch_add_explicit(&_head, 1, memory_order_relaxed);
+    TBAlertTraceSlot *slot = &_slots[position & _mask];
+
+    // Claim the slot, so that no other writer can write it at the same time,
+    // and a concurrent drain can't mistake a torn record for a whole one
+    uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    for (;;) {
+        // A writer a lap ahead got here first; the drain counts this record as dropped
+        if ((sequence & ~TBAlertTraceSlotWriting) > position + 1) {
+            return;
+        }
+        // A writer a lap behind is still writing; it's only ever a few stores from done
+        if (sequence & TBAlertTraceSlotWriting) {
+            sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(
+                &slot->sequence, &sequence, (position + 1) | TBAlertTraceSlotWriting,
+                memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    atomic_thread_fence(memory_order_release);
+    slot->record = record;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+}
+
+- (NSUInteger)drainRecordsUsingBlock:(void (^)(TBAlertTraceRecord))block {
+    NSParameterAssert(block);
+
+    uint64_t head = atomic_load_explicit(&_head, memory_order_acquire);
+    uint64_t dropped = 0;
+    NSUInteger drained = 0;
+
+    // Anything older than one lap behind the head has been overwritten
+    if (head - _tail > _capacity) {
+        dropped += head - _capacity - _tail;
+        _tail = head - _capacity;
+    }
+
+    for (; _tail < head; _tail++) {
+        TBAlertTraceSlot *slot = &_slots[_tail & _mask];
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+        uint64_t position = sequence & ~TBAlertTraceSlotWriting;
+
+        // Not written yet, or still being written; pick up from here next time
+        if (position < _tail + 1 || sequence == ((_tail + 1) | TBAlertTraceSlotWriting)) {
+            break;
+        }
+        // Overwritten by a writer a lap ahead
+        if (position != _tail + 1) {
+            dropped++;
+            continue;
+        }
+
+        TBAlertTraceRecord record = slot->record;
+        atomic_thread_fence(memory_order_acquire);
+
+        // Overwritten while we read it
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != sequence) {
+            dropped++;
+            continue;
+        }
+
+        block(record);
+        drained++;
+    }
+
+    if (dropped) {
+        atomic_fetch_add_explicit(&_dropped, dropped, memory_order_relaxed);
+    }
+
+    return drained;
+}
+
+- (NSData *)drainJSON {
+    NSMutableArray *events = [NSMutableArray new];
+    [self drainRecordsUsingBlock:^(TBAlertTraceRecord record) {
+        [events addObject:@{
+            @"alert": @(record.alert),
+            @"event": TBAlertTraceEventName(record.event),
+            @"phase": TBAlertTracePhaseName(record.phase),
+            @"timestamp": @(record.timestamp),
+        }];
+    }];
+
+    return [NSJSONSerialization dataWithJSONObject:events options:0 error:nil];
+}
+
+@end
+
+#pragma mark - TBAlertSignpostTraceSink
+
+#if __has_include(<os/signpost.h>)
+
+// Signpost names must be string literals
+#define TBSignpostCase(event, name) \
+    case event: \
+        switch (record.phase) { \
+            case TBAlertTracePhaseBegin: os_signpost_interval_begin(_log, signpost, name); break; \
+            case TBAlertTracePhaseEnd: os_signpost_interval_end(_log, signpost, name); break; \
+            case TBAlertTracePhaseInstant: os_signpost_event_emit(_log, signpost, name); break; \
+        } \
+        break;
+
+@implementation TBAlertSignpostTraceSink {
+    os_log_t _log;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _log = os_log_create("TBAlertController", "Lifecycle");
+    }
+
+    return self;
+}
+
+- (void)recordTraceEvent:(TBAlertTraceRecord)record {
+    // Alert identifiers start at 1 and are unique, so they make valid signpost IDs
+    os_signpost_id_t signpost = (os_signpost_id_t)record.alert;
+
+    switch (record.event) {
+        TBSignpostCase(TBAlertTraceEventBuild, "Build")
+        TBSignpostCase(TBAlertTraceEventPrepare, "Prepare")
+        TBSignpostCase(TBAlertTraceEventPresent, "Present")
+        TBSignpostCase(TBAlertTraceEventVisible, "Visible")
+        TBSignpostCase(TBAlertTraceEventDecision, "Decision")
+        TBSignpostCase(TBAlertTraceEventHandler, "Handler")
+    }
+}
+
+@end
+
+#undef TBSignpostCase
+
+#endif
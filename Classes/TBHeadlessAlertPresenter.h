@@ -0,0 +1,66 @@
+//
+//  TBHeadlessAlertPresenter.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPresenter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TBHeadlessAlertPresenter;
+
+/** An in-memory presentation of a \c TBAlertController. Nothing is drawn;
+ instead, buttons are "tapped" and text fields are filled programmatically. */
+@interface TBHeadlessAlertPresentation : NSObject <TBAlertPresentation>
+
+/** The alert being presented. \c nil until the presentation is presented, and once it has been dismissed. */
+@property (nonatomic, readonly, nullable) TBAlertController *alert;
+/** The presenter which created this presentation. */
+@property (nonatomic, readonly, weak) TBHeadlessAlertPresenter *presenter;
+
+@property (nonatomic, copy, nullable) NSString *title;
+@property (nonatomic, copy, nullable) NSString *message;
+@property (nonatomic, readonly) NSArray<UITextField *> *textFields;
+/** The titles of the buttons as of the last update applied. The cancel button, if any, is last. */
+@property (nonatomic, readonly) NSArray<NSString *> *buttonTitles;
+/** The number of button updates this presentation has applied since it was presented. */
+@property (nonatomic, readonly) NSUInteger updateCount;
+/** Whether or not the presentation has been dismissed, either by tapping a button or programmatically. */
+@property (nonatomic, readonly, getter=isDismissed) BOOL dismissed;
+
+/** @return Whether or not the button at \c buttonIndex can currently be tapped. */
+- (BOOL)isButtonEnabledAtIndex:(NSUInteger)buttonIndex;
+/** @return The style the button at \c buttonIndex would be displayed with. */
+- (UIAlertActionStyle)styleForButtonAtIndex:(NSUInteger)buttonIndex;
+/** Sets the text of the text field at \c index, as if the user had typed it. */
+- (void)setText:(nullable NSString *)text forTextFieldAtIndex:(NSUInteger)index;
+/** Sets the text of the text field with the given identifier, as if the user had typed it.
+ @return \c NO if there is no such text field. */
+- (BOOL)setText:(nullable NSString *)text forTextFieldWithIdentifier:(NSString *)identifier;
+
+/** Taps the button at \c buttonIndex, dismissing the presentation and performing the button's action.
+ @return \c NO if the presentation was already dismissed or the button is disabled. */
+- (BOOL)tapButtonAtIndex:(NSUInteger)buttonIndex;
+/** Taps the first button with the given title.
+ @return \c NO if there is no such button, or if \c tapButtonAtIndex: would return \c NO. */
+- (BOOL)tapButtonWithTitle:(NSString *)title;
+
+@end
+
+/** A presenter which keeps alerts in memory instead of displaying them, for use
+ in tests, benchmarks, and anywhere UIKit is not available. */
+@interface TBHeadlessAlertPresenter : NSObject <TBAlertPresenter>
+
+/** All presentations which have not yet been dismissed, in the order they were presented. */
+@property (nonatomic, readonly) NSArray<TBHeadlessAlertPresentation *> *presentations;
+/** The most recent presentation which has not yet been dismissed. */
+@property (nonatomic, readonly, nullable) TBHeadlessAlertPresentation *topPresentation;
+/** The total number of alerts this presenter has presented. */
+@property (nonatomic, readonly) NSUInteger presentationCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,205 @@
+//
+//  TBHeadlessAlertPresenter.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBHeadlessAlertPresenter.h"
+#import "TBAlertController.h"
+
+@interface TBHeadlessAlertPresenter ()
+@property (nonatomic, readonly) NSMutableArray<TBHeadlessAlertPresentation *> *visible;
+- (void)presentationDidEnd:(TBHeadlessAlertPresentation *)presentation;
+@end
+
+#pragma mark - TBHeadlessAlertPresentation
+
+@interface TBHeadlessAlertPresentation ()
+@property (nonatomic, nullable) TBAlertController *alert;
+@property (nonatomic, readonly) NSMutableArray<NSString *> *titles;
+@property (nonatomic, readonly) NSMutableArray<NSNumber *> *styles;
+@property (nonatomic, readonly) NSMutableArray<NSNumber *> *enabledStates;
+@property (nonatomic, readonly) NSArray *textFieldIdentifiers;
+@property (nonatomic, getter=isDismissed) BOOL dismissed;
+@end
+
+@implementation TBHeadlessAlertPresentation
+
+- (instancetype)initWithAlert:(TBAlertController *)alert presenter:(TBHeadlessAlertPresenter *)presenter {
+    self = [super init];
+    if (self) {
+        // The alert is only retained once presented
+        _presenter = presenter;
+        _title = alert.title;
+        _message = alert.message;
+        NSUInteger count = alert.numberOfButtons;
+        _titles = [NSMutableArray arrayWithCapacity:count];
+        _styles = [NSMutableArray arrayWithCapacity:count];
+        _enabledStates = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger i = 0; i < count; i++) {
+            [_titles addObject:[alert titleForButtonAtIndex:i]];
+            [_styles addObject:@([alert actionStyleForButtonAtIndex:i])];
+            [_enabledStates addObject:@([alert isButtonEnabledAtIndex:i])];
+        }
+        _textFieldIdentifiers = alert.textFieldIdentifiers;
+
+        NSMutableArray *textFields = [NSMutableArray new];
+        for (void (^handler)(UITextField *) in alert.textFieldConfigurationHandlers) {
+            UITextField *textField = [UITextField new];
+            handler(textField);
+            [textFields addObject:textField];
+        }
+        _textFields = textFields.copy;
+    }
+
+    return self;
+}
+
+- (NSArray<NSString *> *)buttonTitles {
+    return self.titles.copy;
+}
+
+- (BOOL)isButtonEnabledAtIndex:(NSUInteger)buttonIndex {
+    return !self.dismissed && self.enabledStates[buttonIndex].boolValue;
+}
+
+- (UIAlertActionStyle)styleForButtonAtIndex:(NSUInteger)buttonIndex {
+    return self.styles[buttonIndex].integerValue;
+}
+
+- (BOOL)applyUpdate:(TBAlertUpdate *)update {
+    if (self.dismissed) {
+        return NO;
+    }
+
+    [self.titles removeObjectsAtIndexes:update.removedIndexes];
+    [self.styles removeObjectsAtIndexes:update.removedIndexes];
+    [self.enabledStates removeObjectsAtIndexes:update.removedIndexes];
+
+    NSIndexSet *inserted = update.insertedIndexes;
+    [self.titles insertObjects:[update.titles objectsAtIndexes:inserted] atIndexes:inserted];
+    [self.styles insertObjects:[update.styles objectsAtIndexes:inserted] atIndexes:inserted];
+    [self.enabledStates insertObjects:[update.enabledStates objectsAtIndexes:inserted] atIndexes:inserted];
+
+    [update.reconfiguredIndexes enumerateIndexesUsingBlock:^(NSUInteger i, BOOL *stop) {
+        self.styles[i] = update.styles[i];
+        self.enabledStates[i] = update.enabledStates[i];
+    }];
+
+    NSAssert([self.titles isEqualToArray:update.titles], @"Update did not produce the expected buttons");
+    _updateCount++;
+    return YES;
+}
+
+- (void)setText:(NSString *)text forTextFieldAtIndex:(NSUInteger)index {
+    self.textFields[index].text = text;
+    [self.alert presentation:self textFieldDidChangeAtIndex:index];
+}
+
+- (BOOL)setText:(NSString *)text forTextFieldWithIdentifier:(NSString *)identifier {
+    NSUInteger index = [self.textFieldIdentifiers indexOfObject:identifier];
+    if (index == NSNotFound) {
+        return NO;
+    }
+
+    [self setText:text forTextFieldAtIndex:index];
+    return YES;
+}
+
+- (BOOL)tapButtonAtIndex:(NSUInteger)buttonIndex {
+    if (![self isButtonEnabledAtIndex:buttonIndex]) {
+        return NO;
+    }
+
+    TBAlertController *alert = self.alert;
+    [self end];
+    [alert presentation:self didSelectButtonAtIndex:buttonIndex];
+    return YES;
+}
+
+- (BOOL)tapButtonWithTitle:(NSString *)title {
+    NSUInteger buttonIndex = [self.buttonTitles indexOfObject:title];
+    if (buttonIndex == NSNotFound) {
+        return NO;
+    }
+
+    return [self tapButtonAtIndex:buttonIndex];
+}
+
+- (void)dismissAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    [self end];
+    if (completion) completion();
+}
+
+- (void)end {
+    self.dismissed = YES;
+    self.alert = nil;
+    [self.presenter presentationDidEnd:self];
+}
+
+@end
+
+#pragma mark - TBHeadlessAlertPresenter
+
+@implementation TBHeadlessAlertPresenter
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _visible = [NSMutableArray new];
+    }
+
+    return self;
+}
+
+- (NSArray<TBHeadlessAlertPresentation *> *)presentations {
+    return self.visible.copy;
+}
+
+- (TBHeadlessAlertPresentation *)topPresentation {
+    return self.visible.lastObject;
+}
+
+- (id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                     fromViewController:(UIViewController *)viewController
+                               animated:(BOOL)animated
+                             completion:(TBVoidBlock)completion {
+    return [self
+        presentAlert:alert
+        preparedPresentation:[self prepareAlert:alert]
+        fromViewController:viewController
+        animated:animated
+        completion:completion
+    ];
+}
+
+- (id<TBAlertPresentation>)prepareAlert:(TBAlertController *)alert {
+    return [[TBHeadlessAlertPresentation alloc] initWithAlert:alert presenter:self];
+}
+
+- (id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                   preparedPresentation:(TBHeadlessAlertPresentation *)presentation
+                     fromViewController:(UIViewController *)viewController
+                               animated:(BOOL)animated
+                             completion:(TBVoidBlock)completion {
+    NSParameterAssert([presentation isKindOfClass:[TBHeadlessAlertPresentation class]]);
+    NSAssert(!presentation.alert && !presentation.dismissed, @"A presentation can only be presented once");
+
+    presentation.alert = alert;
+    [self.visible addObject:presentation];
+    _presentationCount++;
+
+    if (completion) {
+        completion();
+    }
+
+    return presentation;
+}
+
+- (void)presentationDidEnd:(TBHeadlessAlertPresentation *)presentation {
+    [self.visible removeObjectIdenticalTo:presentation];
+}
+
+@end
@@ -0,0 +1,60 @@
+//
+//  TBPresentingViewControllerResolver.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPlatform.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A node in a hierarchy of view controllers, as far as finding the one to present from is concerned.
+ \c UIViewController conforms where UIKit is available; containers other than navigation, tab bar, and
+ split view controllers should override \c tb_visibleChildNode. */
+@protocol TBPresentableNode <NSObject>
+
+/** The node this one presents, if it can be presented from. */
+@property (nonatomic, readonly, nullable) id<TBPresentableNode> tb_presentedNode;
+/** The child shown in front, such as the top of a navigation stack or the selected tab. */
+@property (nonatomic, readonly, nullable) id<TBPresentableNode> tb_visibleChildNode;
+/** Whether the node is still part of the hierarchy it was found in, and not on its way out. */
+@property (nonatomic, readonly) BOOL tb_isAttached;
+
+@end
+
+/** Finds the view controller to present alerts from: the top-most one that a window's root view
+ controller presents or shows, following presented view controllers and the visible child of containers.
+
+ The result is cached per root until it is no longer on top, which is checked in constant time on each
+ use, or until the cache is invalidated. Any \c TBAlertController being dismissed invalidates it, as does
+ a window or scene becoming key or active. For use on the main thread only. */
+@interface TBPresentingViewControllerResolver : NSObject
+
+/** The resolver used by \c -[TBAlertController showFromAutomaticPresenter]. */
+@property (nonatomic, class, null_resettable) TBPresentingViewControllerResolver *sharedResolver;
+
+/** Returns the root to resolve from for \c automaticPresentingNode. Defaults to \c nil, which uses the
+ root view controller of the key window of the foreground scene, or no root where UIKit is unavailable. */
+@property (nonatomic, copy, nullable) id<TBPresentableNode> _Nullable (^rootNodeProvider)(void);
+
+/** The number of times the hierarchy has been walked, rather than answered from the cache. */
+@property (nonatomic, readonly) NSUInteger resolutionCount;
+
+/** @return The top-most node \c root presents or shows, or \c root itself. */
+- (id<TBPresentableNode>)topNodeFromRoot:(id<TBPresentableNode>)root;
+/** @return The top-most node of the root given by \c rootNodeProvider, or of the key window. */
+- (nullable id<TBPresentableNode>)automaticPresentingNode;
+
+/** Forgets every cached node, such as after changing a hierarchy in a way the resolver can't see. */
+- (void)invalidate;
+
+#if TB_HAS_UIKIT
+/** @return The top-most view controller of \c window, or \c nil if it has no root view controller. */
+- (nullable UIViewController *)topViewControllerInWindow:(UIWindow *)window;
+#endif
+
+@end
+
+NS_ASSUME_NONNULL_END
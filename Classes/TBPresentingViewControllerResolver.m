@@ -0,0 +1,216 @@
+//
+//  TBPresentingViewControllerResolver.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBPresentingViewControllerResolver.h"
+#import "TBAlertController.h"
+
+#if TB_HAS_UIKIT
+@interface UIViewController (TBPresentableNode) <TBPresentableNode>
+@end
+#endif
+
+#pragma mark - TBResolvedNode
+
+/** The top-most node of a root, as of one generation of the resolver. */
+@interface TBResolvedNode : NSObject {
+    @public
+    __weak id<TBPresentableNode> _node;
+    NSUInteger _generation;
+}
+@end
+
+@implementation TBResolvedNode
+@end
+
+#pragma mark - TBPresentingViewControllerResolver
+
+@implementation TBPresentingViewControllerResolver {
+    /// Weakly keyed by root
+    NSMapTable<id<TBPresentableNode>, TBResolvedNode *> *_resolved;
+    NSUInteger _generation;
+}
+
+static TBPresentingViewControllerResolver *_sharedResolver = nil;
+
++ (TBPresentingViewControllerResolver *)sharedResolver {
+    if (!_sharedResolver) {
+        _sharedResolver = [self new];
+    }
+
+    return _sharedResolver;
+}
+
++ (void)setSharedResolver:(TBPresentingViewControllerResolver *)sharedResolver {
+    _sharedResolver = sharedResolver;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _resolved = [NSMapTable
+            mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+            valueOptions:NSPointerFunctionsStrongMemory
+        ];
+
+        NSNotificationCenter *center = NSNotificationCenter.defaultCenter;
+        [center addObserver:self selector:@selector(invalidate) name:TBAlertControllerDidDismissNotification object:nil];
+#if TB_HAS_UIKIT
+        [center addObserver:self selector:@selector(invalidate) name:UIWindowDidBecomeKeyNotification object:nil];
+        [center addObserver:self selector:@selector(invalidate) name:UIWindowDidBecomeHiddenNotification object:nil];
+        if (@available(iOS 13.0, *)) {
+            [center addObserver:self selector:@selector(invalidate) name:UISceneDidActivateNotification object:nil];
+            [center addObserver:self selector:@selector(invalidate) name:UISceneDidDisconnectNotification object:nil];
+        }
+#endif
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    [NSNotificationCenter.defaultCenter removeObserver:self];
+}
+
+- (void)invalidate {
+    _generation++;
+}
+
+- (id<TBPresentableNode>)topNodeFromRoot:(id<TBPresentableNode>)root {
+    NSParameterAssert(root);
+
+    // Anything presented or pushed over it, or taking it away, shows on the node itself
+    TBResolvedNode *resolved = [_resolved objectForKey:root];
+    id<TBPresentableNode> top = resolved ? resolved->_node : nil;
+    if (top && resolved->_generation == _generation && top.tb_isAttached &&
+        !top.tb_presentedNode && !top.tb_visibleChildNode) {
+        return top;
+    }
+
+    _resolutionCount++;
+    top = root;
+    for (id<TBPresentableNode> next = root; next; next = next.tb_presentedNode ?: next.tb_visibleChildNode) {
+        top = next;
+    }
+
+    if (!resolved) {
+        resolved = [TBResolvedNode new];
+        [_resolved setObject:resolved forKey:root];
+    }
+    resolved->_node = top;
+    resolved->_generation = _generation;
+    return top;
+}
+
+- (id<TBPresentableNode>)automaticPresentingNode {
+    id<TBPresentableNode> root = nil;
+    if (self.rootNodeProvider) {
+        root = self.rootNodeProvider();
+    }
+#if TB_HAS_UIKIT
+    else {
+        root = [self keyWindow].rootViewController;
+    }
+#endif
+
+    return root ? [self topNodeFromRoot:root] : nil;
+}
+
+#if TB_HAS_UIKIT
+
+- (UIViewController *)topViewControllerInWindow:(UIWindow *)window {
+    UIViewController *root = window.rootViewController;
+    return root ? (UIViewController *)[self topNodeFromRoot:root] : nil;
+}
+
+/** The key window of the foreground scene, or failing that, a visible window of one. */
+- (UIWindow *)keyWindow {
+    if (@available(iOS 13.0, *)) {
+        UIWindow *fallback = nil;
+        for (UIScene *scene in UIApplication.sharedApplication.connectedScenes) {
+            if (scene.activationState != UISceneActivationStateForegroundActive ||
+                ![scene isKindOfClass:[UIWindowScene class]]) {
+                continue;
+            }
+
+            for (UIWindow *window in ((UIWindowScene *)scene).windows) {
+                if (window.isKeyWindow) {
+                    return window;
+                }
+                if (!fallback && !window.hidden && window.rootViewController) {
+                    fallback = window;
+                }
+            }
+        }
+
+        if (fallback) {
+            return fallback;
+        }
+    }
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    return UIApplication.sharedApplication.keyWindow;
+#pragma clang diagnostic pop
+}
+
+#endif
+
+@end
+
+#if TB_HAS_UIKIT
+
+#pragma mark - UIKit
+
+@implementation UIViewController (TBPresentableNode)
+
+- (id<TBPresentableNode>)tb_presentedNode {
+    // Alerts can't present, and a view controller on its way out is no place to present from
+    UIViewController *presented = self.presentedViewController;
+    if (presented.isBeingDismissed || [presented isKindOfClass:[UIAlertController class]]) {
+        return nil;
+    }
+
+    return presented;
+}
+
+- (id<TBPresentableNode>)tb_visibleChildNode {
+    return nil;
+}
+
+- (BOOL)tb_isAttached {
+    return self.isViewLoaded && self.view.window && !self.isBeingDismissed && !self.isMovingFromParentViewController;
+}
+
+@end
+
+@implementation UINavigationController (TBPresentableNode)
+
+- (id<TBPresentableNode>)tb_visibleChildNode {
+    return self.topViewController;
+}
+
+@end
+
+@implementation UITabBarController (TBPresentableNode)
+
+- (id<TBPresentableNode>)tb_visibleChildNode {
+    return self.selectedViewController;
+}
+
+@end
+
+@implementation UISplitViewController (TBPresentableNode)
+
+- (id<TBPresentableNode>)tb_visibleChildNode {
+    // The detail view controller when both are shown
+    return self.viewControllers.lastObject;
+}
+
+@end
+
+#endif
@@ -0,0 +1,97 @@
+//
+//  TBScriptedAlertPresenter.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBHeadlessAlertPresenter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Which alerts a \c TBScriptedAlertPresenter answers, and how. An alert matches if it matches
+ every criterion that is set; a rule with none set matches every alert. */
+@interface TBAlertResponseRule : NSObject
+
+/** A rule for alerts with the given \c -[TBAlertController identifier]. */
++ (instancetype)ruleWithIdentifier:(NSString *)identifier;
+/** A rule for alerts whose title contains a match for the regular expression \c pattern. */
++ (instancetype)ruleWithTitlePattern:(NSString *)pattern;
+/** A rule for alerts which have a button with each of the given titles, among others. */
++ (instancetype)ruleWithButtonTitles:(NSArray<NSString *> *)buttonTitles;
+
+#pragma mark Matching
+
+@property (nonatomic, copy, nullable) NSString *identifier;
+/** A regular expression. Alerts without a title are matched as if their title were empty. */
+@property (nonatomic, copy, nullable) NSString *titlePattern;
+@property (nonatomic, copy, nullable) NSArray<NSString *> *buttonTitles;
+/** How many alerts the rule answers before it is used up. Defaults to \c 0, which means any number. */
+@property (nonatomic) NSUInteger limit;
+
+#pragma mark Answering
+
+/** The title of the button to tap. Takes precedence over \c buttonIndex. */
+@property (nonatomic, copy, nullable) NSString *buttonTitle;
+/** The index of the button to tap. Defaults to \c NSNotFound, which taps the cancel button if there is one,
+ and otherwise the first button. */
+@property (nonatomic) NSUInteger buttonIndex;
+/** Text to type before tapping, by text field index (an \c NSNumber) or identifier (an \c NSString). */
+@property (nonatomic, copy, nullable) NSDictionary<id, NSString *> *textFieldValues;
+
+@end
+
+/** One alert shown to a \c TBScriptedAlertPresenter, and what was done with it. */
+@interface TBAlertTranscriptEntry : NSObject
+
+@property (nonatomic, readonly, nullable) NSString *identifier;
+@property (nonatomic, readonly, nullable) NSString *title;
+@property (nonatomic, readonly, nullable) NSString *message;
+@property (nonatomic, readonly) NSArray<NSString *> *buttonTitles;
+/** The rule which answered the alert, or \c nil if none matched. */
+@property (nonatomic, readonly, nullable) TBAlertResponseRule *rule;
+/** The text of each text field as the button was tapped; empty if no button was. */
+@property (nonatomic, readonly) NSArray<NSString *> *textFieldValues;
+/** The button tapped, or \c NSNotFound if the alert was left presented, such as because no rule matched,
+ the rule's button was disabled or missing, or the alert was dismissed before it could be answered. */
+@property (nonatomic, readonly) NSUInteger buttonIndex;
+
+@end
+
+/** Answers alerts for the user, for fast and deterministic UI and integration tests. Nothing is shown
+ and nothing is animated. Make it the \c TBAlertController.defaultPresenter to answer every alert that
+ wasn't given a presenter of its own:
+
+ \code
+ TBScriptedAlertPresenter *responder = [TBScriptedAlertPresenter new];
+ TBAlertResponseRule *rule = [TBAlertResponseRule ruleWithIdentifier:@"delete-confirmation"];
+ rule.buttonTitle = @"Delete";
+ [responder addRule:rule];
+ TBAlertController.defaultPresenter = responder;
+ \endcode
+
+ Each alert is answered by the first rule added that matches it: the rule's text is typed into the
+ alert's text fields, then its button is tapped, which runs the button's action as usual. Alerts no rule
+ matches stay presented, as with a \c TBHeadlessAlertPresenter, for the test to answer itself.
+ Every alert presented is recorded in the \c transcript. For use on the main thread only. */
+@interface TBScriptedAlertPresenter : TBHeadlessAlertPresenter
+
+/** Whether alerts are answered before \c showFromViewController: returns, or on the next turn of the
+ main run loop, as a user would at the earliest. Defaults to \c YES. */
+@property (nonatomic) BOOL respondsSynchronously;
+/** Called with each presentation that no rule matches, after it has been recorded. */
+@property (nonatomic, copy, nullable) void (^unmatchedAlertHandler)(TBHeadlessAlertPresentation *presentation);
+
+@property (nonatomic, readonly) NSArray<TBAlertResponseRule *> *rules;
+/** Every alert presented so far, in the order they were presented. */
+@property (nonatomic, readonly) NSArray<TBAlertTranscriptEntry *> *transcript;
+
+/** Rules are tried in the order they were added. */
+- (void)addRule:(TBAlertResponseRule *)rule;
+- (void)removeAllRules;
+- (void)clearTranscript;
+
+@end
+
+NS_ASSUME_NONNULL_END
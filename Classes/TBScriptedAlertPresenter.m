@@ -0,0 +1,270 @@
+//
+//  TBScriptedAlertPresenter.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBScriptedAlertPresenter.h"
+#import "TBAlertController.h"
+
+#pragma mark - TBAlertResponseRule
+
+@interface TBAlertResponseRule () {
+    @public
+    NSUInteger _uses;
+}
+@property (nonatomic, nullable) NSRegularExpression *titleExpression;
+@end
+
+@implementation TBAlertResponseRule
+
++ (instancetype)ruleWithIdentifier:(NSString *)identifier {
+    NSParameterAssert(identifier);
+
+    TBAlertResponseRule *rule = [self new];
+    rule.identifier = identifier;
+    return rule;
+}
+
++ (instancetype)ruleWithTitlePattern:(NSString *)pattern {
+    NSParameterAssert(pattern);
+
+    TBAlertResponseRule *rule = [self new];
+    rule.titlePattern = pattern;
+    return rule;
+}
+
++ (instancetype)ruleWithButtonTitles:(NSArray<NSString *> *)buttonTitles {
+    NSParameterAssert(buttonTitles);
+
+    TBAlertResponseRule *rule = [self new];
+    rule.buttonTitles = buttonTitles;
+    return rule;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _buttonIndex = NSNotFound;
+    }
+
+    return self;
+}
+
+- (void)setTitlePattern:(NSString *)titlePattern {
+    NSError *error = nil;
+    _titlePattern = titlePattern.copy;
+    _titleExpression = titlePattern ? [NSRegularExpression regularExpressionWithPattern:titlePattern options:0 error:&error] : nil;
+    NSAssert(!error, @"Invalid title pattern: %@", error.localizedDescription);
+}
+
+- (BOOL)isUsedUp {
+    return self.limit && _uses >= self.limit;
+}
+
+- (BOOL)matchesPresentation:(TBHeadlessAlertPresentation *)presentation alert:(TBAlertController *)alert {
+    if (self.identifier && ![alert.identifier isEqualToString:self.identifier]) {
+        return NO;
+    }
+
+    if (self.titleExpression) {
+        NSString *title = presentation.title ?: @"";
+        if (![self.titleExpression firstMatchInString:title options:0 range:NSMakeRange(0, title.length)]) {
+            return NO;
+        }
+    }
+
+    NSArray<NSString *> *buttonTitles = presentation.buttonTitles;
+    for (NSString *title in self.buttonTitles) {
+        if (![buttonTitles containsObject:title]) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+/** @return \c NSNotFound if the rule's button isn't there. */
+- (NSUInteger)buttonIndexInPresentation:(TBHeadlessAlertPresentation *)presentation {
+    NSArray<NSString *> *buttonTitles = presentation.buttonTitles;
+    if (self.buttonTitle) {
+        return [buttonTitles indexOfObject:self.buttonTitle];
+    }
+    if (self.buttonIndex != NSNotFound) {
+        return self.buttonIndex < buttonTitles.count ? self.buttonIndex : NSNotFound;
+    }
+    if (!buttonTitles.count) {
+        return NSNotFound;
+    }
+
+    // The cancel button is always last
+    NSUInteger last = buttonTitles.count - 1;
+    return [presentation styleForButtonAtIndex:last] == UIAlertActionStyleCancel ? last : 0;
+}
+
+@end
+
+#pragma mark - TBAlertTranscriptEntry
+
+@interface TBAlertTranscriptEntry ()
+@property (nonatomic) NSArray<NSString *> *textFieldValues;
+@property (nonatomic) NSUInteger buttonIndex;
+@end
+
+@implementation TBAlertTranscriptEntry
+
+- (instancetype)initWithPresentation:(TBHeadlessAlertPresentation *)presentation
+                               alert:(TBAlertController *)alert
+                                rule:(TBAlertResponseRule *)rule {
+    self = [super init];
+    if (self) {
+        _identifier = alert.identifier;
+        _title = presentation.title;
+        _message = presentation.message;
+        _buttonTitles = presentation.buttonTitles;
+        _rule = rule;
+        _textFieldValues = @[];
+        _buttonIndex = NSNotFound;
+    }
+
+    return self;
+}
+
+- (NSString *)description {
+    NSString *answer = self.buttonIndex != NSNotFound ?
+        [NSString stringWithFormat:@"tapped \"%@\"", self.buttonTitles[self.buttonIndex]] : @"unanswered";
+    return [NSString stringWithFormat:@"<%@ \"%@\" [%@]: %@>",
+        self.identifier ?: @"alert", self.title ?: @"", [self.buttonTitles componentsJoinedByString:@", "], answer
+    ];
+}
+
+@end
+
+#pragma mark - TBScriptedAlertPresenter
+
+@implementation TBScriptedAlertPresenter {
+    NSMutableArray<TBAlertResponseRule *> *_rules;
+    NSMutableArray<TBAlertTranscriptEntry *> *_transcript;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _respondsSynchronously = YES;
+        _rules = [NSMutableArray new];
+        _transcript = [NSMutableArray new];
+    }
+
+    return self;
+}
+
+- (NSArray<TBAlertResponseRule *> *)rules {
+    return _rules.copy;
+}
+
+- (NSArray<TBAlertTranscriptEntry *> *)transcript {
+    return _transcript.copy;
+}
+
+- (void)addRule:(TBAlertResponseRule *)rule {
+    NSParameterAssert(rule);
+    [_rules addObject:rule];
+}
+
+- (void)removeAllRules {
+    [_rules removeAllObjects];
+}
+
+- (void)clearTranscript {
+    [_transcript removeAllObjects];
+}
+
+- (id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                   preparedPresentation:(TBHeadlessAlertPresentation *)prepared
+                     fromViewController:(UIViewController *)viewController
+                               animated:(BOOL)animated
+                             completion:(TBVoidBlock)completion {
+    TBHeadlessAlertPresentation *presentation = (id)[super
+        presentAlert:alert
+        preparedPresentation:prepared
+        fromViewController:viewController
+        animated:animated
+        completion:completion
+    ];
+
+    TBAlertResponseRule *rule = [self ruleForPresentation:presentation alert:alert];
+    TBAlertTranscriptEntry *entry = [[TBAlertTranscriptEntry alloc] initWithPresentation:presentation alert:alert rule:rule];
+    [_transcript addObject:entry];
+
+    if (!rule) {
+        if (self.unmatchedAlertHandler) {
+            self.unmatchedAlertHandler(presentation);
+        }
+        return presentation;
+    }
+
+    // Used up now, so that alerts shown by its button's action don't match it again
+    rule->_uses++;
+    if (self.respondsSynchronously) {
+        [self answerPresentation:presentation withRule:rule entry:entry];
+    } else {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self answerPresentation:presentation withRule:rule entry:entry];
+        });
+    }
+
+    return presentation;
+}
+
+- (TBAlertResponseRule *)ruleForPresentation:(TBHeadlessAlertPresentation *)presentation alert:(TBAlertController *)alert {
+    for (TBAlertResponseRule *rule in _rules) {
+        if (![rule isUsedUp] && [rule matchesPresentation:presentation alert:alert]) {
+            return rule;
+        }
+    }
+
+    return nil;
+}
+
+- (void)answerPresentation:(TBHeadlessAlertPresentation *)presentation
+                  withRule:(TBAlertResponseRule *)rule
+                     entry:(TBAlertTranscriptEntry *)entry {
+    // Dismissed some other way while we waited for the run loop
+    if (presentation.isDismissed) {
+        return;
+    }
+
+    NSArray<UITextField *> *textFields = presentation.textFields;
+    [rule.textFieldValues enumerateKeysAndObjectsUsingBlock:^(id key, NSString *text, BOOL *stop) {
+        if ([key isKindOfClass:[NSNumber class]]) {
+            NSUInteger index = [key unsignedIntegerValue];
+            NSAssert(index < textFields.count, @"The alert has no text field at index %@", key);
+            if (index < textFields.count) {
+                [presentation setText:text forTextFieldAtIndex:index];
+            }
+        } else {
+            BOOL found = [presentation setText:text forTextFieldWithIdentifier:key];
+            NSAssert(found, @"The alert has no text field with identifier %@", key);
+            (void)found;
+        }
+    }];
+
+    NSUInteger buttonIndex = [rule buttonIndexInPresentation:presentation];
+    if (buttonIndex == NSNotFound || ![presentation isButtonEnabledAtIndex:buttonIndex]) {
+        return;
+    }
+
+    // Recorded first; the button's action may well show more alerts
+    NSMutableArray<NSString *> *values = [NSMutableArray new];
+    for (UITextField *textField in textFields) {
+        [values addObject:textField.text ?: @""];
+    }
+    entry.textFieldValues = values;
+    entry.buttonIndex = buttonIndex;
+
+    [presentation tapButtonAtIndex:buttonIndex];
+}
+
+@end
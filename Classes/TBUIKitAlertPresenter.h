@@ -0,0 +1,23 @@
+//
+//  TBUIKitAlertPresenter.h
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertPresenter.h"
+
+#if TB_HAS_UIKIT
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** The default presenter. Presents alerts with \c UIAlertController on iOS 8 and later,
+ and with \c UIAlertView or \c UIActionSheet on iOS 7. */
+@interface TBUIKitAlertPresenter : NSObject <TBAlertPresenter>
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
@@ -0,0 +1,387 @@
+//
+//  TBUIKitAlertPresenter.m
+//  TBAlertController
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBUIKitAlertPresenter.h"
+#import "TBAlertController.h"
+#import "TBPresentingViewControllerResolver.h"
+
+#if TB_HAS_UIKIT
+
+#pragma mark - TBAlertControllerPresentation
+
+/** Wraps a presented \c UIAlertController, which cannot conform to \c TBAlertPresentation directly. */
+@interface TBAlertControllerPresentation : NSObject <TBAlertPresentation>
+@property (nonatomic, readonly) UIAlertController *alertController;
+/** Set once presented, and released once dismissed. Prepared presentations
+ don't hold on to their alert so that it can hold on to them instead. */
+@property (nonatomic, nullable) TBAlertController *alert;
+/** The actions added to \c alertController, which does not let us remove or reorder them. */
+@property (nonatomic, copy) NSArray<UIAlertAction *> *actions;
+- (instancetype)initWithAlertController:(UIAlertController *)alertController;
+@end
+
+@implementation TBAlertControllerPresentation
+
+- (instancetype)initWithAlertController:(UIAlertController *)alertController {
+    self = [super init];
+    if (self) {
+        _alertController = alertController;
+    }
+
+    return self;
+}
+
+- (NSString *)title {
+    return self.alertController.title;
+}
+
+- (void)setTitle:(NSString *)title {
+    self.alertController.title = title;
+}
+
+- (NSString *)message {
+    return self.alertController.message;
+}
+
+- (void)setMessage:(NSString *)message {
+    self.alertController.message = message;
+}
+
+- (NSArray<UITextField *> *)textFields {
+    return self.alertController.textFields ?: @[];
+}
+
+- (void)dismissAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    // Keep the alert around until the animation is done
+    [self.alertController dismissViewControllerAnimated:animated completion:^{
+        self.alert = nil;
+        if (completion) completion();
+    }];
+}
+
+- (void)textFieldDidChange:(UITextField *)textField {
+    NSUInteger index = [self.alertController.textFields indexOfObjectIdenticalTo:textField];
+    if (index != NSNotFound) {
+        [self.alert presentation:self textFieldDidChangeAtIndex:index];
+    }
+}
+
+- (BOOL)applyUpdate:(TBAlertUpdate *)update {
+    // Actions can only be enabled or disabled after the fact; the rest needs a new alert controller
+    if (update.changesStructure) {
+        return NO;
+    }
+
+    __block BOOL applied = YES;
+    [update.reconfiguredIndexes enumerateIndexesUsingBlock:^(NSUInteger i, BOOL *stop) {
+        if (self.actions[i].style != update.styles[i].integerValue) {
+            applied = NO;
+            *stop = YES;
+        }
+    }];
+
+    if (applied) {
+        [update.reconfiguredIndexes enumerateIndexesUsingBlock:^(NSUInteger i, BOOL *stop) {
+            self.actions[i].enabled = update.enabledStates[i].boolValue;
+        }];
+    }
+
+    return applied;
+}
+
+@end
+
+#pragma mark - TBAlertView - DO NOT USE
+#pragma mark Created to use itself as the delegate for iOS 7 and earlier.
+
+// AlertView
+@interface TBAlertView : UIAlertView <UIAlertViewDelegate, TBAlertPresentation>
+@property (nonatomic) TBAlertController *controller;
+- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(TBAlertController *)controller;
+@end
+@implementation TBAlertView
+- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(TBAlertController *)controller {
+    self = [super init];
+    if (self) {
+        self.controller = controller;
+        self.title      = title;
+        self.message    = message;
+        self.delegate   = self;
+    }
+
+    return self;
+}
+- (NSArray<UITextField *> *)textFields {
+    switch (self.alertViewStyle) {
+        case UIAlertViewStyleLoginAndPasswordInput:
+            return @[[self textFieldAtIndex:0], [self textFieldAtIndex:1]];
+        case UIAlertViewStylePlainTextInput:
+        case UIAlertViewStyleSecureTextInput:
+            return @[[self textFieldAtIndex:0]];
+        case UIAlertViewStyleDefault:
+            return @[];
+    }
+}
+- (void)dismissAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    self.controller = nil;
+    [self dismissWithClickedButtonIndex:self.cancelButtonIndex animated:animated];
+    if (completion) completion();
+}
+- (void)alertView:(UIAlertView *)alertView clickedButtonAtIndex:(NSInteger)buttonIndex {
+    // UIKit keeps the alert view around for a while after this; don't keep the controller with it
+    TBAlertController *controller = self.controller;
+    self.controller = nil;
+    [controller presentation:self didSelectButtonAtIndex:buttonIndex];
+}
+
+@end
+
+#pragma mark - TBActionSheet - DO NOT USE
+#pragma mark Created to use itself as the delegate for iOS 7 and earlier.
+
+// ActionSheet
+@interface TBActionSheet : UIActionSheet <UIActionSheetDelegate, TBAlertPresentation>
+@property (nonatomic) TBAlertController *controller;
+- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(TBAlertController *)controller;
+@end
+@implementation TBActionSheet
+- (instancetype)initWithTitle:(NSString *)title message:(NSString *)message controller:(TBAlertController *)controller {
+    self = [super init];
+    if (self) {
+        self.controller = controller;
+        self.delegate   = self;
+        if (message)
+            self.title  = [NSString stringWithFormat:@"%@\n\n%@", title, message];
+        else
+            self.title  = title;
+    }
+
+    return self;
+}
+- (NSArray<UITextField *> *)textFields {
+    return @[];
+}
+- (void)dismissAnimated:(BOOL)animated completion:(TBVoidBlock)completion {
+    self.controller = nil;
+    [self dismissWithClickedButtonIndex:self.cancelButtonIndex animated:animated];
+    if (completion) completion();
+}
+- (void)actionSheet:(UIActionSheet *)actionSheet clickedButtonAtIndex:(NSInteger)buttonIndex {
+    TBAlertController *controller = self.controller;
+    self.controller = nil;
+    [controller presentation:self didSelectButtonAtIndex:buttonIndex];
+}
+@end
+
+#pragma mark - TBUIKitAlertPresenter
+
+@implementation TBUIKitAlertPresenter
+
+- (id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                     fromViewController:(UIViewController *)viewController
+                               animated:(BOOL)animated
+                             completion:(TBVoidBlock)completion {
+    // iOS 8+
+    if ([UIAlertController class]) {
+        return [self
+            presentAlert:alert
+            preparedPresentation:[self prepareAlert:alert]
+            fromViewController:viewController
+            animated:animated
+            completion:completion
+        ];
+    }
+    // iOS 7 or earlier
+    else {
+        id<TBAlertPresentation> presentation = nil;
+
+        // Alert view
+        if (alert.style == TBAlertControllerStyleAlert) {
+            presentation = [self showAlertView:alert];
+        }
+
+        // Action sheet
+        else if (alert.style == TBAlertControllerStyleActionSheet) {
+            presentation = [self showActionSheet:alert inView:[[self viewControllerToPresentFrom:viewController].view window]];
+        }
+
+        // Completion block
+        if (completion) {
+            completion();
+        }
+
+        return presentation;
+    }
+}
+
+#pragma mark Displaying (iOS 8)
+
+- (id<TBAlertPresentation>)prepareAlert:(TBAlertController *)alert {
+    // UIAlertView and UIActionSheet are cheap enough to build on demand
+    if (![UIAlertController class]) {
+        return nil;
+    }
+
+    UIAlertController *alertController = [UIAlertController
+        alertControllerWithTitle:alert.title
+        message:alert.message
+        preferredStyle:(UIAlertControllerStyle)alert.style
+    ];
+    TBAlertControllerPresentation *presentation = [[TBAlertControllerPresentation alloc]
+        initWithAlertController:alertController
+    ];
+
+    // Add text fields, which report edits back to the alert
+    for (id handler in alert.textFieldConfigurationHandlers) {
+        [alertController addTextFieldWithConfigurationHandler:handler];
+    }
+    for (UITextField *textField in alertController.textFields) {
+        [textField addTarget:presentation
+            action:@selector(textFieldDidChange:)
+            forControlEvents:UIControlEventEditingChanged
+        ];
+    }
+
+    // Add actions; the cancel action, if any, is last. Data source
+    // items are described by the alert without creating their actions
+    NSUInteger count = alert.numberOfButtons;
+    NSMutableArray *actions = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        UIAlertAction *action = [self actionForButtonAtIndex:i alert:alert presentation:presentation];
+        [alertController addAction:action];
+        [actions addObject:action];
+    }
+    presentation.actions = actions;
+
+    // Handle source view / bar item for action sheets
+    id viewOrBarItem = alert.popoverSourceView;
+
+    if ([viewOrBarItem isKindOfClass:[UIBarButtonItem class]]) {
+        alertController.popoverPresentationController.barButtonItem = viewOrBarItem;
+    } else if ([viewOrBarItem isKindOfClass:[UIView class]]) {
+        alertController.popoverPresentationController.sourceView = viewOrBarItem;
+        alertController.popoverPresentationController.sourceRect = [viewOrBarItem bounds];
+    } else if (viewOrBarItem) {
+        NSParameterAssert(
+            [viewOrBarItem isKindOfClass:[UIBarButtonItem class]] ||
+            [viewOrBarItem isKindOfClass:[UIView class]] ||
+            !viewOrBarItem
+        );
+    }
+
+    return presentation;
+}
+
+- (id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                   preparedPresentation:(TBAlertControllerPresentation *)presentation
+                     fromViewController:(UIViewController *)viewController
+                               animated:(BOOL)animated
+                             completion:(TBVoidBlock)completion {
+    NSParameterAssert([presentation isKindOfClass:[TBAlertControllerPresentation class]]);
+
+    presentation.alert = alert;
+    [[self viewControllerToPresentFrom:viewController]
+        presentViewController:presentation.alertController animated:animated completion:completion
+    ];
+
+    // UIKit only logs a warning when it can't present, such as from a view controller that has left its window
+    if (!presentation.alertController.presentingViewController) {
+        presentation.alert = nil;
+        return nil;
+    }
+
+    return presentation;
+}
+
+/** \c viewController, unless it is \c nil or already presenting something: then the top-most view
+ controller over it, or of the key window, as found by \c TBPresentingViewControllerResolver. */
+- (UIViewController *)viewControllerToPresentFrom:(UIViewController *)viewController {
+    if (viewController && !viewController.presentedViewController) {
+        return viewController;
+    }
+
+    TBPresentingViewControllerResolver *resolver = TBPresentingViewControllerResolver.sharedResolver;
+    id node = viewController ? [resolver topNodeFromRoot:viewController] : resolver.automaticPresentingNode;
+    return [node isKindOfClass:[UIViewController class]] ? node : nil;
+}
+
+- (UIAlertAction *)actionForButtonAtIndex:(NSUInteger)buttonIndex
+                                    alert:(TBAlertController *)alert
+                             presentation:(TBAlertControllerPresentation *)presentation {
+    // The alert controller retains its presentation, which retains the
+    // UIAlertController and thus this handler; don't retain either back
+    __weak TBAlertControllerPresentation *weakPresentation = presentation;
+    UIAlertAction *action = [UIAlertAction
+        actionWithTitle:[alert titleForButtonAtIndex:buttonIndex]
+        style:[alert actionStyleForButtonAtIndex:buttonIndex]
+        handler:^(UIAlertAction *alertAction) {
+            TBAlertControllerPresentation *presentation = weakPresentation;
+            TBAlertController *controller = presentation.alert;
+            presentation.alert = nil;
+            [controller presentation:presentation didSelectButtonAtIndex:buttonIndex];
+        }
+    ];
+
+    action.enabled = [alert isButtonEnabledAtIndex:buttonIndex];
+    return action;
+}
+
+#pragma mark Displaying (iOS 7)
+
+- (id<TBAlertPresentation>)showAlertView:(TBAlertController *)alert {
+    TBAlertView *alertView = [[TBAlertView alloc]
+        initWithTitle:alert.title
+        message:alert.message
+        controller:alert
+    ];
+
+    // Add buttons; the cancel button, if any, is last
+    for (NSUInteger i = 0; i < alert.numberOfButtons; i++) {
+        [alertView addButtonWithTitle:[alert titleForButtonAtIndex:i]];
+    }
+
+    if (alert.numberOfButtons > 0 &&
+        [alert actionStyleForButtonAtIndex:alert.numberOfButtons-1] == UIAlertActionStyleCancel) {
+        [alertView setCancelButtonIndex:alertView.numberOfButtons-1];
+    }
+
+    // Text views
+    alertView.alertViewStyle = alert.alertViewStyle;
+
+    [alertView show];
+    return alertView;
+}
+
+- (id<TBAlertPresentation>)showActionSheet:(TBAlertController *)alert inView:(UIView *)view {
+    TBActionSheet *actionSheet = [[TBActionSheet alloc]
+        initWithTitle:alert.title
+        message:alert.message
+        controller:alert
+    ];
+
+    // Add buttons; the cancel button, if any, is last
+    for (NSUInteger i = 0; i < alert.numberOfButtons; i++) {
+        [actionSheet addButtonWithTitle:[alert titleForButtonAtIndex:i]];
+    }
+
+    if (alert.numberOfButtons > 0 &&
+        [alert actionStyleForButtonAtIndex:alert.numberOfButtons-1] == UIAlertActionStyleCancel) {
+        actionSheet.cancelButtonIndex = actionSheet.numberOfButtons-1;
+    }
+    // Destructive button index
+    if (alert.destructiveButtonIndex > -1) {
+        actionSheet.destructiveButtonIndex = alert.destructiveButtonIndex;
+    }
+
+    [actionSheet showInView:view];
+    return actionSheet;
+}
+
+@end
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "FBImageCompare.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__has_include)
+#if __has_include(<dispatch/dispatch.h>)
+#include <dispatch/dispatch.h>
+#define FB_HAS_DISPATCH 1
+#endif
+#endif
+
+#if FB_HAS_DISPATCH
+/** Images with fewer pixels than this are compared on the calling thread. */
+static const size_t FBParallelPixelThreshold = 256 * 1024;
+#endif
+
+const FBImageCompareOptions FBImageCompareOptionsExact = { 0, 0, 0.0 };
+
+/** Rows per band when comparing in parallel; enough that each band is worth dispatching. */
+static const size_t FBRowsPerBand = 64;
+
+typedef uint8_t FBBytes __attribute__((vector_size(16)));
+typedef uint64_t FBHalves __attribute__((vector_size(16)));
+typedef uint32_t FBPixels __attribute__((vector_size(16)));
+
+typedef struct FBBandResult {
+  size_t differingPixelCount;
+  uint8_t maxChannelDelta;
+  size_t minX, minY, maxX, maxY;
+} FBBandResult;
+
+typedef struct FBCompareContext {
+  FBImageBuffer reference;
+  FBImageBuffer image;
+  uint8_t channelTolerance;
+  size_t budget;
+  bool stopEarly;
+  /** Differing pixels found by every band so far, for stopping early. */
+  _Atomic(size_t) differingPixelCount;
+  _Atomic(bool) stopped;
+  FBBandResult *bands;
+} FBCompareContext;
+
+static inline void FBBandAddPixel(FBBandResult *band, size_t x, size_t y)
+{
+  if (band->differingPixelCount++ == 0) {
+    band->minX = band->maxX = x;
+    band->minY = band->maxY = y;
+    return;
+  }
+  if (x < band->minX) band->minX = x;
+  if (x > band->maxX) band->maxX = x;
+  if (y > band->maxY) band->maxY = y;
+}
+
+/** Compares one row, returning the number of differing pixels in it. */
+static size_t FBCompareRow(const uint8_t *a, const uint8_t *b, size_t width, size_t y,
+                           uint8_t tolerance, FBBandResult *band)
+{
+  size_t before = band->differingPixelCount;
+  size_t bytes = width * 4;
+  size_t i = 0;
+
+  FBBytes limit = (FBBytes){ 0 } + tolerance;
+  FBBytes maxDelta = { 0 };
+
+  for (; i + 16 <= bytes; i += 16) {
+    FBBytes va, vb;
+    memcpy(&va, a + i, 16);
+    memcpy(&vb, b + i, 16);
+
+    // |a - b| per channel, without widening
+    FBBytes greater = (FBBytes)(va > vb);
+    FBBytes delta = ((va - vb) & greater) | ((vb - va) & ~greater);
+    FBBytes larger = (FBBytes)(delta > maxDelta);
+    maxDelta = (maxDelta & ~larger) | (delta & larger);
+
+    FBBytes over = (FBBytes)(delta > limit);
+    FBHalves halves = (FBHalves)over;
+    if (!(halves[0] | halves[1])) {
+      continue;
+    }
+
+    // A pixel differs if any of its four channels does
+    FBPixels pixels = (FBPixels)over;
+    for (size_t lane = 0; lane < 4; lane++) {
+      if (pixels[lane]) {
+        FBBandAddPixel(band, i / 4 + lane, y);
+      }
+    }
+  }
+
+  for (size_t lane = 0; lane < 16; lane++) {
+    if (maxDelta[lane] > band->maxChannelDelta) {
+      band->maxChannelDelta = maxDelta[lane];
+    }
+  }
+
+  // The last few pixels that don't fill a vector
+  for (; i < bytes; i += 4) {
+    bool differs = false;
+    for (size_t c = 0; c < 4; c++) {
+      uint8_t delta = a[i + c] > b[i + c] ? a[i + c] - b[i + c] : b[i + c] - a[i + c];
+      if (delta > band->maxChannelDelta) {
+        band->maxChannelDelta = delta;
+      }
+      differs |= delta > tolerance;
+    }
+    if (differs) {
+      FBBandAddPixel(band, i / 4, y);
+    }
+  }
+
+  return band->differingPixelCount - before;
+}
+
+static void FBCompareBand(void *context, size_t index)
+{
+  FBCompareContext *compare = context;
+  FBBandResult *band = &compare->bands[index];
+  size_t firstRow = index * FBRowsPerBand;
+  size_t lastRow = firstRow + FBRowsPerBand;
+  if (lastRow > compare->reference.height) {
+    lastRow = compare->reference.height;
+  }
+
+  for (size_t y = firstRow; y < lastRow; y++) {
+    if (compare->stopEarly && atomic_load_explicit(&compare->stopped, memory_order_relaxed)) {
+      return;
+    }
+
+    size_t differing = FBCompareRow(compare->reference.pixels + y * compare->reference.bytesPerRow,
+                                    compare->image.pixels + y * compare->image.bytesPerRow,
+                                    compare->reference.width,
+                                    y,
+                                    compare->channelTolerance,
+                                    band);
+    if (differing && compare->stopEarly) {
+      size_t total = atomic_fetch_add_explicit(&compare->differingPixelCount, differing, memory_order_relaxed) + differing;
+      if (total > compare->budget) {
+        atomic_store_explicit(&compare->stopped, true, memory_order_relaxed);
+        return;
+      }
+    }
+  }
+}
+
+FBImageCompareResult FBImageCompareBuffers(FBImageBuffer reference,
+                                           FBImageBuffer image,
+                                           FBImageCompareOptions options,
+                                           bool stopEarly)
+{
+  FBImageCompareResult result = { 0 };
+  if (reference.width != image.width || reference.height != image.height) {
+    return result;
+  }
+
+  size_t pixelCount = reference.width * reference.height;
+  size_t budget = options.maxDifferingPixels;
+  size_t fractionBudget = (size_t)(options.maxDifferingFraction * (double)pixelCount);
+  if (fractionBudget > budget) {
+    budget = fractionBudget;
+  }
+
+  size_t bandCount = (reference.height + FBRowsPerBand - 1) / FBRowsPerBand;
+  FBCompareContext context = {
+    .reference = reference,
+    .image = image,
+    .channelTolerance = options.channelTolerance,
+    .budget = budget,
+    .stopEarly = stopEarly,
+    .bands = calloc(bandCount > 0 ? bandCount : 1, sizeof(FBBandResult)),
+  };
+  if (!context.bands) {
+    return result;
+  }
+
+#if FB_HAS_DISPATCH
+  if (pixelCount >= FBParallelPixelThreshold && bandCount > 1) {
+    dispatch_apply_f(bandCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), &context, FBCompareBand);
+  } else
+#endif
+  {
+    for (size_t i = 0; i < bandCount; i++) {
+      FBCompareBand(&context, i);
+    }
+  }
+
+  size_t minX = SIZE_MAX, minY = SIZE_MAX, maxX = 0, maxY = 0;
+  for (size_t i = 0; i < bandCount; i++) {
+    FBBandResult *band = &context.bands[i];
+    if (band->maxChannelDelta > result.maxChannelDelta) {
+      result.maxChannelDelta = band->maxChannelDelta;
+    }
+    if (!band->differingPixelCount) {
+      continue;
+    }
+
+    result.differingPixelCount += band->differingPixelCount;
+    if (band->minX < minX) minX = band->minX;
+    if (band->minY < minY) minY = band->minY;
+    if (band->maxX > maxX) maxX = band->maxX;
+    if (band->maxY > maxY) maxY = band->maxY;
+  }
+
+  if (result.differingPixelCount) {
+    result.differingBounds = (FBPixelRect){ minX, minY, maxX - minX + 1, maxY - minY + 1 };
+  }
+
+  result.stoppedEarly = atomic_load(&context.stopped);
+  result.passed = !result.stoppedEarly && result.differingPixelCount <= budget;
+
+  free(context.bands);
+  return result;
+}
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef FBImageCompare_h
+#define FBImageCompare_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ A borrowed view of 8-bit RGBA pixels. Rows may be padded, but pixels within a row are packed.
+ */
+typedef struct FBImageBuffer {
+  const uint8_t *pixels;
+  size_t width;
+  size_t height;
+  size_t bytesPerRow;
+} FBImageBuffer;
+
+/**
+ A rectangle in pixels, with its origin at the first row of the buffer. Empty when nothing differs.
+ */
+typedef struct FBPixelRect {
+  size_t x;
+  size_t y;
+  size_t width;
+  size_t height;
+} FBPixelRect;
+
+typedef struct FBImageCompareOptions {
+  /**
+   The largest difference in any one channel for which two pixels still count as the same.
+   */
+  uint8_t channelTolerance;
+  /**
+   How many pixels may differ before the images count as different.
+   */
+  size_t maxDifferingPixels;
+  /**
+   The same budget as a fraction of all pixels. Whichever of the two allows more pixels is used.
+   */
+  double maxDifferingFraction;
+} FBImageCompareOptions;
+
+typedef struct FBImageCompareResult {
+  /**
+   Whether the number of differing pixels is within budget.
+   */
+  bool passed;
+  /**
+   Whether the comparison gave up as soon as the budget was exceeded. If so, the other fields only
+   describe the pixels compared up to that point.
+   */
+  bool stoppedEarly;
+  size_t differingPixelCount;
+  /**
+   The largest difference in any one channel of any pixel, including differences within tolerance.
+   */
+  uint8_t maxChannelDelta;
+  /**
+   The smallest rectangle containing every differing pixel.
+   */
+  FBPixelRect differingBounds;
+} FBImageCompareResult;
+
+/**
+ Requires every pixel to match exactly.
+ */
+extern const FBImageCompareOptions FBImageCompareOptionsExact;
+
+/**
+ Compares two images of the same size pixel by pixel, 16 bytes at a time.
+ Large images are split into bands of rows which are compared in parallel.
+ @param reference The reference (correct) pixels.
+ @param image The pixels to test against the reference. Must be the same width and height as the reference.
+ @param options The tolerance and budget for differing pixels.
+ @param stopEarly Whether to stop as soon as the budget is exceeded, rather than describing every difference.
+ */
+extern FBImageCompareResult FBImageCompareBuffers(FBImageBuffer reference,
+                                                  FBImageBuffer image,
+                                                  FBImageCompareOptions options,
+                                                  bool stopEarly);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
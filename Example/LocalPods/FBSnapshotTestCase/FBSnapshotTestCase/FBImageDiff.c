@@ -0,0 +1,246 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "FBImageDiff.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__has_include)
+#if __has_include(<dispatch/dispatch.h>)
+#include <dispatch/dispatch.h>
+#define FB_HAS_DISPATCH 1
+#endif
+#endif
+
+typedef struct FBDiffContext {
+  FBImageBuffer reference;
+  FBImageBuffer image;
+  uint8_t channelTolerance;
+  FBImageDiff *diff;
+} FBDiffContext;
+
+static inline uint8_t FBChannelDelta(uint8_t a, uint8_t b)
+{
+  return a > b ? a - b : b - a;
+}
+
+/** What is needed to finish a tile's statistics once all of its rows are done. */
+typedef struct FBTileAccumulator {
+  uint64_t deltaSum;
+  size_t minX, minY, maxX, maxY;
+} FBTileAccumulator;
+
+/** Fills in the heatmap and statistics for one row of tiles. */
+static void FBDiffTileRow(void *context, size_t tileRow)
+{
+  FBDiffContext *diffContext = context;
+  FBImageDiff *diff = diffContext->diff;
+  size_t tileSize = diff->tileSize;
+  FBDiffTile *tiles = &diff->tiles[tileRow * diff->tilesAcross];
+
+  size_t firstRow = tileRow * tileSize;
+  size_t lastRow = firstRow + tileSize < diff->height ? firstRow + tileSize : diff->height;
+
+  FBTileAccumulator *accumulators = calloc(diff->tilesAcross, sizeof(FBTileAccumulator));
+  if (!accumulators) {
+    return;
+  }
+
+  for (size_t y = firstRow; y < lastRow; y++) {
+    const uint8_t *a = diffContext->reference.pixels + y * diffContext->reference.bytesPerRow;
+    const uint8_t *b = diffContext->image.pixels + y * diffContext->image.bytesPerRow;
+    uint8_t *out = diff->heatmap + y * diff->width * 4;
+
+    for (size_t x = 0; x < diff->width; x++) {
+      const uint8_t *pa = a + x * 4, *pb = b + x * 4;
+      uint8_t delta = FBChannelDelta(pa[0], pb[0]);
+      uint8_t channel = FBChannelDelta(pa[1], pb[1]);
+      if (channel > delta) delta = channel;
+      channel = FBChannelDelta(pa[2], pb[2]);
+      if (channel > delta) delta = channel;
+      channel = FBChannelDelta(pa[3], pb[3]);
+      if (channel > delta) delta = channel;
+
+      FBDiffTile *tile = &tiles[x / tileSize];
+      FBTileAccumulator *accumulator = &accumulators[x / tileSize];
+      accumulator->deltaSum += delta;
+      if (delta > tile->maxChannelDelta) {
+        tile->maxChannelDelta = delta;
+      }
+
+      uint8_t *pixel = out + x * 4;
+      if (delta > diffContext->channelTolerance) {
+        if (tile->differingPixelCount++ == 0) {
+          accumulator->minX = accumulator->maxX = x;
+          accumulator->minY = accumulator->maxY = y;
+        } else {
+          if (x < accumulator->minX) accumulator->minX = x;
+          if (x > accumulator->maxX) accumulator->maxX = x;
+          accumulator->maxY = y;
+        }
+        pixel[0] = 128 + delta / 2;
+        pixel[1] = 0;
+        pixel[2] = 0;
+      } else {
+        // A faded copy of the reference, for context
+        uint8_t gray = 192 + (uint8_t)(((unsigned)pa[0] + pa[1] + pa[2]) / 12);
+        pixel[0] = pixel[1] = pixel[2] = gray;
+      }
+      pixel[3] = 255;
+    }
+  }
+
+  for (size_t column = 0; column < diff->tilesAcross; column++) {
+    FBDiffTile *tile = &tiles[column];
+    FBTileAccumulator *accumulator = &accumulators[column];
+    size_t area = tile->frame.width * tile->frame.height;
+    tile->meanDelta = area ? (double)accumulator->deltaSum / (double)area : 0;
+    if (tile->differingPixelCount) {
+      tile->differingBounds = (FBPixelRect){
+        accumulator->minX,
+        accumulator->minY,
+        accumulator->maxX - accumulator->minX + 1,
+        accumulator->maxY - accumulator->minY + 1,
+      };
+    }
+  }
+
+  free(accumulators);
+}
+
+static FBPixelRect FBPixelRectUnion(FBPixelRect a, FBPixelRect b)
+{
+  if (!a.width) return b;
+  if (!b.width) return a;
+  size_t minX = a.x < b.x ? a.x : b.x;
+  size_t minY = a.y < b.y ? a.y : b.y;
+  size_t maxX = a.x + a.width > b.x + b.width ? a.x + a.width : b.x + b.width;
+  size_t maxY = a.y + a.height > b.y + b.height ? a.y + a.height : b.y + b.height;
+  return (FBPixelRect){ minX, minY, maxX - minX, maxY - minY };
+}
+
+/** Groups changed tiles that touch, including diagonally, into regions. Only looks at tiles, not pixels. */
+static bool FBDiffFindRegions(FBImageDiff *diff)
+{
+  size_t tileCount = diff->tilesAcross * diff->tilesDown;
+  size_t capacity = tileCount > 0 ? tileCount : 1;
+  bool *visited = calloc(capacity, sizeof(bool));
+  size_t *stack = malloc(capacity * sizeof(size_t));
+  diff->regions = malloc(capacity * sizeof(FBDiffRegion));
+  if (!visited || !stack || !diff->regions) {
+    free(visited);
+    free(stack);
+    return false;
+  }
+
+  for (size_t start = 0; start < tileCount; start++) {
+    if (visited[start] || !diff->tiles[start].differingPixelCount) {
+      continue;
+    }
+
+    FBDiffRegion region = { { 0 }, 0 };
+    size_t depth = 0;
+    stack[depth++] = start;
+    visited[start] = true;
+
+    while (depth) {
+      size_t current = stack[--depth];
+      FBDiffTile *tile = &diff->tiles[current];
+      region.bounds = FBPixelRectUnion(region.bounds, tile->differingBounds);
+      region.differingPixelCount += tile->differingPixelCount;
+
+      size_t column = current % diff->tilesAcross, row = current / diff->tilesAcross;
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          if ((dx < 0 && column == 0) || (dy < 0 && row == 0) ||
+              (dx > 0 && column + 1 == diff->tilesAcross) || (dy > 0 && row + 1 == diff->tilesDown)) {
+            continue;
+          }
+          size_t neighbor = (row + dy) * diff->tilesAcross + column + dx;
+          if (!visited[neighbor] && diff->tiles[neighbor].differingPixelCount) {
+            visited[neighbor] = true;
+            stack[depth++] = neighbor;
+          }
+        }
+      }
+    }
+
+    diff->regions[diff->regionCount++] = region;
+  }
+
+  free(visited);
+  free(stack);
+  return true;
+}
+
+bool FBImageDiffCreate(FBImageBuffer reference,
+                       FBImageBuffer image,
+                       uint8_t channelTolerance,
+                       size_t tileSize,
+                       FBImageDiff *diff)
+{
+  memset(diff, 0, sizeof(*diff));
+  if (reference.width != image.width || reference.height != image.height || !tileSize) {
+    return false;
+  }
+
+  diff->width = reference.width;
+  diff->height = reference.height;
+  diff->tileSize = tileSize;
+  diff->tilesAcross = (diff->width + tileSize - 1) / tileSize;
+  diff->tilesDown = (diff->height + tileSize - 1) / tileSize;
+
+  size_t tileCount = diff->tilesAcross * diff->tilesDown;
+  size_t heatmapLength = diff->width * diff->height * 4;
+  diff->heatmap = malloc(heatmapLength > 0 ? heatmapLength : 1);
+  diff->tiles = calloc(tileCount > 0 ? tileCount : 1, sizeof(FBDiffTile));
+  if (!diff->heatmap || !diff->tiles) {
+    FBImageDiffFree(diff);
+    return false;
+  }
+
+  for (size_t i = 0; i < tileCount; i++) {
+    size_t x = (i % diff->tilesAcross) * tileSize, y = (i / diff->tilesAcross) * tileSize;
+    diff->tiles[i].frame = (FBPixelRect){
+      x, y, x + tileSize < diff->width ? tileSize : diff->width - x, y + tileSize < diff->height ? tileSize : diff->height - y,
+    };
+  }
+
+  FBDiffContext context = { reference, image, channelTolerance, diff };
+#if FB_HAS_DISPATCH
+  dispatch_apply_f(diff->tilesDown, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), &context, FBDiffTileRow);
+#else
+  for (size_t row = 0; row < diff->tilesDown; row++) {
+    FBDiffTileRow(&context, row);
+  }
+#endif
+
+  for (size_t i = 0; i < tileCount; i++) {
+    diff->differingPixelCount += diff->tiles[i].differingPixelCount;
+    if (diff->tiles[i].maxChannelDelta > diff->maxChannelDelta) {
+      diff->maxChannelDelta = diff->tiles[i].maxChannelDelta;
+    }
+  }
+
+  if (!FBDiffFindRegions(diff)) {
+    FBImageDiffFree(diff);
+    return false;
+  }
+  return true;
+}
+
+void FBImageDiffFree(FBImageDiff *diff)
+{
+  free(diff->heatmap);
+  free(diff->tiles);
+  free(diff->regions);
+  memset(diff, 0, sizeof(*diff));
+}
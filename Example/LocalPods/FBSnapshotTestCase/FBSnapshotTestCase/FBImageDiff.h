@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef FBImageDiff_h
+#define FBImageDiff_h
+
+#include "FBImageCompare.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ How much one square tile of the image changed.
+ */
+typedef struct FBDiffTile {
+  FBPixelRect frame;
+  size_t differingPixelCount;
+  uint8_t maxChannelDelta;
+  /**
+   The mean of the largest channel difference of each pixel in the tile, differing or not.
+   */
+  double meanDelta;
+  /**
+   The smallest rectangle containing every differing pixel in the tile. Empty if none differ.
+   */
+  FBPixelRect differingBounds;
+} FBDiffTile;
+
+/**
+ A group of touching tiles which changed, such as a button whose title moved.
+ */
+typedef struct FBDiffRegion {
+  FBPixelRect bounds;
+  size_t differingPixelCount;
+} FBDiffRegion;
+
+typedef struct FBImageDiff {
+  /**
+   Packed RGBA pixels the size of the images: unchanged pixels are a faded copy of the reference,
+   and changed pixels are red, brighter the more they changed.
+   */
+  uint8_t *heatmap;
+  size_t width;
+  size_t height;
+
+  size_t tileSize;
+  size_t tilesAcross;
+  size_t tilesDown;
+  /**
+   Row by row, `tilesAcross` × `tilesDown` of them.
+   */
+  FBDiffTile *tiles;
+
+  FBDiffRegion *regions;
+  size_t regionCount;
+
+  size_t differingPixelCount;
+  uint8_t maxChannelDelta;
+} FBImageDiff;
+
+/**
+ Builds a heatmap, per-tile statistics, and the regions that changed in a single pass over both images,
+ one row of tiles at a time in parallel.
+ @param reference The reference (correct) pixels.
+ @param image The pixels being tested. Must be the same width and height as the reference.
+ @param channelTolerance The largest difference in any one channel for which two pixels still count as the same.
+ @param tileSize The width and height of each tile, in pixels.
+ @param diff Filled in on success. Free it with FBImageDiffFree.
+ @returns false if the images are different sizes or memory could not be allocated.
+ */
+extern bool FBImageDiffCreate(FBImageBuffer reference,
+                              FBImageBuffer image,
+                              uint8_t channelTolerance,
+                              size_t tileSize,
+                              FBImageDiff *diff);
+
+extern void FBImageDiffFree(FBImageDiff *diff);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,434 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "FBReferenceImageStore.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char *const FBReferenceIndexFileName = "FBReferenceImageIndex.txt";
+
+static const char FBReferenceIndexHeaderV1[] = "# FBSnapshotTestCase reference image index v1\n";
+static const char FBReferenceIndexHeader[] = "# FBSnapshotTestCase reference image index v2\n";
+
+/* Hashing */
+
+static const uint64_t FBHashPrime1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t FBHashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+static inline uint64_t FBHashRound(uint64_t hash, uint64_t value)
+{
+  hash ^= value * FBHashPrime2;
+  hash = (hash << 31) | (hash >> 33);
+  return hash * FBHashPrime1;
+}
+
+static inline uint64_t FBHashFinalize(uint64_t hash)
+{
+  hash ^= hash >> 33;
+  hash *= FBHashPrime2;
+  hash ^= hash >> 29;
+  hash *= FBHashPrime1;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+/** Four independent lanes, so that each round doesn't wait on the one before it. */
+static void FBHashBytes(uint64_t lanes[4], const uint8_t *bytes, size_t length)
+{
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    uint64_t values[4];
+    memcpy(values, bytes + i, 32);
+    lanes[0] = FBHashRound(lanes[0], values[0]);
+    lanes[1] = FBHashRound(lanes[1], values[1]);
+    lanes[2] = FBHashRound(lanes[2], values[2]);
+    lanes[3] = FBHashRound(lanes[3], values[3]);
+  }
+  for (; i < length; i += 8) {
+    uint64_t value = 0;
+    memcpy(&value, bytes + i, length - i < 8 ? length - i : 8);
+    lanes[0] = FBHashRound(lanes[0], value);
+  }
+}
+
+static uint64_t FBHashLanes(const uint64_t lanes[4], uint64_t length)
+{
+  uint64_t hash = FBHashRound(FBHashRound(lanes[0], lanes[1]), FBHashRound(lanes[2], lanes[3]));
+  return FBHashFinalize(FBHashRound(hash, length));
+}
+
+uint64_t FBImageBufferHash(FBImageBuffer buffer)
+{
+  uint64_t lanes[4] = { FBHashPrime1, FBHashPrime2, ~FBHashPrime1, ~FBHashPrime2 };
+  for (size_t y = 0; y < buffer.height; y++) {
+    FBHashBytes(lanes, buffer.pixels + y * buffer.bytesPerRow, buffer.width * 4);
+  }
+  return FBHashLanes(lanes, ((uint64_t)buffer.width << 32) | (uint64_t)buffer.height);
+}
+
+FBReferenceEntry FBReferenceEntryMake(FBImageBuffer buffer)
+{
+  return (FBReferenceEntry){ FBImageBufferHash(buffer), (uint32_t)buffer.width, (uint32_t)buffer.height, 0, 0 };
+}
+
+bool FBReferenceEntryEqual(FBReferenceEntry a, FBReferenceEntry b)
+{
+  return a.hash == b.hash && a.width == b.width && a.height == b.height;
+}
+
+bool FBFileFingerprint(const char *path, uint64_t *size, uint64_t *hash)
+{
+  int descriptor = open(path, O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(descriptor, &info) != 0) {
+    close(descriptor);
+    return false;
+  }
+
+  size_t length = (size_t)info.st_size;
+  uint64_t lanes[4] = { FBHashPrime1, FBHashPrime2, ~FBHashPrime1, ~FBHashPrime2 };
+  if (length > 0) {
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping == MAP_FAILED) {
+      close(descriptor);
+      return false;
+    }
+    FBHashBytes(lanes, mapping, length);
+    munmap(mapping, length);
+  }
+  close(descriptor);
+
+  *size = length;
+  *hash = FBHashLanes(lanes, length);
+  return true;
+}
+
+bool FBReferenceEntrySetFile(FBReferenceEntry *entry, const char *path)
+{
+  uint64_t size, hash;
+  if (!FBFileFingerprint(path, &size, &hash)) {
+    return false;
+  }
+  entry->fileSize = size;
+  entry->fileHash = hash;
+  return true;
+}
+
+bool FBReferenceEntryMatchesFile(FBReferenceEntry entry, const char *path)
+{
+  // Checking the size first means a changed file is usually caught without reading it
+  struct stat info;
+  if (entry.fileSize == 0 || stat(path, &info) != 0 || (uint64_t)info.st_size != entry.fileSize) {
+    return false;
+  }
+
+  uint64_t size, hash;
+  return FBFileFingerprint(path, &size, &hash) && size == entry.fileSize && hash == entry.fileHash;
+}
+
+/* Index */
+
+typedef struct FBIndexRecord {
+  char *name;
+  FBReferenceEntry entry;
+} FBIndexRecord;
+
+struct FBReferenceIndex {
+  /** Sorted by name. */
+  FBIndexRecord *records;
+  size_t count;
+  size_t capacity;
+};
+
+/** @returns The position of `name`, or where it would be inserted. */
+static size_t FBReferenceIndexSearch(const FBReferenceIndex *index, const char *name, bool *found)
+{
+  size_t low = 0, high = index->count;
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    int order = strcmp(index->records[mid].name, name);
+    if (order == 0) {
+      *found = true;
+      return mid;
+    }
+    if (order < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  *found = false;
+  return low;
+}
+
+FBReferenceIndex *FBReferenceIndexCreate(void)
+{
+  return calloc(1, sizeof(FBReferenceIndex));
+}
+
+void FBReferenceIndexFree(FBReferenceIndex *index)
+{
+  if (!index) {
+    return;
+  }
+  for (size_t i = 0; i < index->count; i++) {
+    free(index->records[i].name);
+  }
+  free(index->records);
+  free(index);
+}
+
+size_t FBReferenceIndexCount(const FBReferenceIndex *index)
+{
+  return index->count;
+}
+
+bool FBReferenceIndexLookup(const FBReferenceIndex *index, const char *name, FBReferenceEntry *entry)
+{
+  bool found;
+  size_t position = FBReferenceIndexSearch(index, name, &found);
+  if (found && entry) {
+    *entry = index->records[position].entry;
+  }
+  return found;
+}
+
+bool FBReferenceIndexSet(FBReferenceIndex *index, const char *name, FBReferenceEntry entry)
+{
+  bool found;
+  size_t position = FBReferenceIndexSearch(index, name, &found);
+  if (found) {
+    index->records[position].entry = entry;
+    return true;
+  }
+
+  if (index->count == index->capacity) {
+    size_t capacity = index->capacity ? index->capacity * 2 : 64;
+    FBIndexRecord *records = realloc(index->records, capacity * sizeof(FBIndexRecord));
+    if (!records) {
+      return false;
+    }
+    index->records = records;
+    index->capacity = capacity;
+  }
+
+  size_t length = strlen(name) + 1;
+  char *copy = malloc(length);
+  if (!copy) {
+    return false;
+  }
+  memcpy(copy, name, length);
+
+  memmove(&index->records[position + 1], &index->records[position], (index->count - position) * sizeof(FBIndexRecord));
+  index->records[position] = (FBIndexRecord){ copy, entry };
+  index->count++;
+  return true;
+}
+
+FBReferenceIndex *FBReferenceIndexLoad(const char *path)
+{
+  FBReferenceIndex *index = FBReferenceIndexCreate();
+  if (!index) {
+    return NULL;
+  }
+
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    return index;
+  }
+
+  // Each line is "<hash> <width> <height> <file size> <file hash> <name>"; the name is last because identifiers may
+  // contain spaces. Version 1 lines have no file size or hash.
+  char line[4096];
+  bool valid = true, version1 = false;
+  while (valid && fgets(line, sizeof(line), file)) {
+    if (strcmp(line, FBReferenceIndexHeaderV1) == 0) {
+      version1 = true;
+      continue;
+    }
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    }
+
+    // A line without a newline is only allowed at the end of the file
+    size_t length = strlen(line);
+    if (line[length - 1] == '\n') {
+      line[length - 1] = '\0';
+    } else if (!feof(file)) {
+      valid = false;
+      break;
+    }
+
+    FBReferenceEntry entry = { 0, 0, 0, 0, 0 };
+    int nameStart = 0;
+    if (version1) {
+      valid = sscanf(line, "%" SCNx64 " %" SCNu32 " %" SCNu32 " %n",
+                     &entry.hash, &entry.width, &entry.height, &nameStart) == 3;
+    } else {
+      valid = sscanf(line, "%" SCNx64 " %" SCNu32 " %" SCNu32 " %" SCNu64 " %" SCNx64 " %n",
+                     &entry.hash, &entry.width, &entry.height, &entry.fileSize, &entry.fileHash, &nameStart) == 5;
+    }
+    if (!valid || !nameStart || line[nameStart] == '\0') {
+      valid = false;
+      break;
+    }
+
+    valid = FBReferenceIndexSet(index, line + nameStart, entry);
+  }
+
+  fclose(file);
+  if (!valid) {
+    FBReferenceIndexFree(index);
+    return NULL;
+  }
+  return index;
+}
+
+/** @returns A copy of `path` with a unique suffix, for writing and then renaming over `path`. */
+static char *FBTemporaryPathFor(const char *path)
+{
+  static _Atomic(unsigned long) lastSuffix = 0;
+  unsigned long suffix = atomic_fetch_add(&lastSuffix, 1);
+
+  size_t length = strlen(path) + 64;
+  char *temporary = malloc(length);
+  if (temporary) {
+    snprintf(temporary, length, "%s.%ld.%lu.tmp", path, (long)getpid(), suffix);
+  }
+  return temporary;
+}
+
+bool FBReferenceIndexSave(const FBReferenceIndex *index, const char *path)
+{
+  char *temporary = FBTemporaryPathFor(path);
+  if (!temporary) {
+    return false;
+  }
+
+  FILE *file = fopen(temporary, "w");
+  bool written = file != NULL;
+  if (written) {
+    written = fputs(FBReferenceIndexHeader, file) >= 0;
+    for (size_t i = 0; written && i < index->count; i++) {
+      FBIndexRecord *record = &index->records[i];
+      written = fprintf(file, "%016" PRIx64 " %" PRIu32 " %" PRIu32 " %" PRIu64 " %016" PRIx64 " %s\n",
+                        record->entry.hash, record->entry.width, record->entry.height,
+                        record->entry.fileSize, record->entry.fileHash, record->name) > 0;
+    }
+    written = (fclose(file) == 0) && written;
+  }
+
+  if (written) {
+    written = rename(temporary, path) == 0;
+  }
+  if (!written) {
+    unlink(temporary);
+  }
+
+  free(temporary);
+  return written;
+}
+
+/* Raw image cache */
+
+static const char FBRawImageMagic[8] = { 'F', 'B', 'R', 'G', 'B', 'A', '0', '1' };
+
+typedef struct FBRawImageHeader {
+  char magic[8];
+  uint32_t width;
+  uint32_t height;
+} FBRawImageHeader;
+
+bool FBRawImageWrite(const char *path, FBImageBuffer buffer)
+{
+  char *temporary = FBTemporaryPathFor(path);
+  if (!temporary) {
+    return false;
+  }
+
+  FILE *file = fopen(temporary, "wb");
+  bool written = file != NULL;
+  if (written) {
+    FBRawImageHeader header = { .width = (uint32_t)buffer.width, .height = (uint32_t)buffer.height };
+    memcpy(header.magic, FBRawImageMagic, sizeof(header.magic));
+    written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    size_t rowBytes = buffer.width * 4;
+    for (size_t y = 0; written && y < buffer.height; y++) {
+      written = fwrite(buffer.pixels + y * buffer.bytesPerRow, rowBytes, 1, file) == 1;
+    }
+    written = (fclose(file) == 0) && written;
+  }
+
+  if (written) {
+    written = rename(temporary, path) == 0;
+  }
+  if (!written) {
+    unlink(temporary);
+  }
+
+  free(temporary);
+  return written;
+}
+
+bool FBRawImageMap(const char *path, FBMappedImage *image)
+{
+  int descriptor = open(path, O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(descriptor, &info) != 0 || (size_t)info.st_size < sizeof(FBRawImageHeader)) {
+    close(descriptor);
+    return false;
+  }
+
+  size_t length = (size_t)info.st_size;
+  void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  close(descriptor);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  FBRawImageHeader header;
+  memcpy(&header, mapping, sizeof(header));
+  size_t rowBytes = (size_t)header.width * 4;
+  if (memcmp(header.magic, FBRawImageMagic, sizeof(header.magic)) != 0 ||
+      length != sizeof(header) + rowBytes * header.height) {
+    munmap(mapping, length);
+    return false;
+  }
+
+  image->buffer = (FBImageBuffer){ (const uint8_t *)mapping + sizeof(header), header.width, header.height, rowBytes };
+  image->mapping = mapping;
+  image->length = length;
+  return true;
+}
+
+void FBRawImageUnmap(FBMappedImage *image)
+{
+  if (image->mapping) {
+    munmap(image->mapping, image->length);
+  }
+  memset(image, 0, sizeof(*image));
+}
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#ifndef FBReferenceImageStore_h
+#define FBReferenceImageStore_h
+
+#include "FBImageCompare.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ The name of the index file kept next to the reference images of each test class.
+ */
+extern const char *const FBReferenceIndexFileName;
+
+/**
+ What a reference image's decoded pixels looked like when it was recorded, and which file they were decoded from.
+ */
+typedef struct FBReferenceEntry {
+  uint64_t hash;
+  uint32_t width;
+  uint32_t height;
+  /** The size of the reference image file, or 0 if unknown. */
+  uint64_t fileSize;
+  /** A hash of the bytes of the reference image file. */
+  uint64_t fileHash;
+} FBReferenceEntry;
+
+/**
+ Hashes the pixels of an image, ignoring any padding at the end of each row. Images of different sizes
+ never hash the same, even if they have the same bytes.
+ */
+extern uint64_t FBImageBufferHash(FBImageBuffer buffer);
+
+/**
+ @returns An entry describing the pixels of `buffer`, not yet tied to a file.
+ */
+extern FBReferenceEntry FBReferenceEntryMake(FBImageBuffer buffer);
+
+/**
+ @returns true if both entries describe the same pixels.
+ */
+extern bool FBReferenceEntryEqual(FBReferenceEntry a, FBReferenceEntry b);
+
+/**
+ Hashes the bytes of a file.
+ @returns false if the file doesn't exist or can't be read.
+ */
+extern bool FBFileFingerprint(const char *path, uint64_t *size, uint64_t *hash);
+
+/**
+ Ties `entry` to the reference image file at `path`, which its pixels were decoded from.
+ @returns false if the file can't be read.
+ */
+extern bool FBReferenceEntrySetFile(FBReferenceEntry *entry, const char *path);
+
+/**
+ @returns true if the file at `path` is the one `entry` was tied to: it exists, and has the same size and bytes.
+ Entries that were never tied to a file match nothing.
+ */
+extern bool FBReferenceEntryMatchesFile(FBReferenceEntry entry, const char *path);
+
+/* Index */
+
+/**
+ Maps reference image file names to the hashes of their pixels and files. Stored as text, one image per line, so that
+ it can be checked in and merged alongside the images. Indexes written before files were hashed load with unknown
+ files, which match nothing.
+ */
+typedef struct FBReferenceIndex FBReferenceIndex;
+
+/**
+ Reads an index from disk.
+ @returns The index, or an empty index if the file doesn't exist. NULL if the file can't be read or is malformed.
+ */
+extern FBReferenceIndex *FBReferenceIndexLoad(const char *path);
+
+/**
+ @returns A new, empty index.
+ */
+extern FBReferenceIndex *FBReferenceIndexCreate(void);
+
+extern void FBReferenceIndexFree(FBReferenceIndex *index);
+
+/**
+ @returns true and sets `entry` if the index has an entry for `name`.
+ */
+extern bool FBReferenceIndexLookup(const FBReferenceIndex *index, const char *name, FBReferenceEntry *entry);
+
+/**
+ Adds or replaces the entry for `name`.
+ @returns false if memory could not be allocated.
+ */
+extern bool FBReferenceIndexSet(FBReferenceIndex *index, const char *name, FBReferenceEntry entry);
+
+extern size_t FBReferenceIndexCount(const FBReferenceIndex *index);
+
+/**
+ Writes the index to disk atomically, sorted by name so that diffs stay small.
+ */
+extern bool FBReferenceIndexSave(const FBReferenceIndex *index, const char *path);
+
+/* Raw image cache */
+
+/**
+ An uncompressed image mapped into memory. Its `buffer` stays valid until it is unmapped.
+ */
+typedef struct FBMappedImage {
+  FBImageBuffer buffer;
+  void *mapping;
+  size_t length;
+} FBMappedImage;
+
+/**
+ Writes packed pixels to `path` uncompressed, atomically, so that they can be mapped back in without decoding.
+ */
+extern bool FBRawImageWrite(const char *path, FBImageBuffer buffer);
+
+/**
+ Maps an image written by FBRawImageWrite.
+ @returns false if the file doesn't exist or isn't a complete raw image.
+ */
+extern bool FBRawImageMap(const char *path, FBMappedImage *image);
+
+extern void FBRawImageUnmap(FBMappedImage *image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+#import "FBReferenceImageStore.h"
+
+/**
+ @returns Where the decoded pixels described by `entry` are cached, uncompressed, inside `cacheDirectory`.
+ */
+extern NSString *FBReferenceImageCachePath(NSString *cacheDirectory, FBReferenceEntry entry);
+
+/**
+ Writes reference images in the background, so that recording doesn't wait on PNG encoding.
+ Recordings are hashed first and skipped if the reference image already on disk has the same pixels, so re-recording
+ leaves unchanged images, and their git history, alone. The rest are encoded and written in parallel, at most a few
+ at a time so that pending snapshots don't pile up in memory, and the reference image indexes are saved once per
+ batch rather than once per image.
+ One recorder is shared by every test class, and is flushed before the process exits.
+ */
+@interface FBSnapshotRecorder : NSObject
+
++ (FBSnapshotRecorder *)sharedRecorder;
+
+/**
+ Queues an image to be saved as a reference image. Blocks only while too many images are already being written.
+ @param image The snapshot to record.
+ @param filePath Where the reference image goes. Its directory's index is updated to match.
+ @param cacheDirectory Where the decoded pixels of the reference image are cached.
+ */
+- (void)recordImage:(UIImage *)image
+         toFilePath:(NSString *)filePath
+     cacheDirectory:(NSString *)cacheDirectory;
+
+/**
+ Waits for every queued image to be written, then saves the indexes of the directories they were written to.
+ Failures are left pending for -waitUntilFinished:.
+ */
+- (void)flush;
+
+/**
+ Flushes, then reports and clears any failures since this method last returned. Failures are also logged as they
+ happen.
+ @param error The first failure since this method last returned, if this method returns NO.
+ @returns YES if every image and index was written.
+ */
+- (BOOL)waitUntilFinished:(NSError **)errorPtr;
+
+@end
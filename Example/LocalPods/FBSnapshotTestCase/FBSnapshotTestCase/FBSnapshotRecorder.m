@@ -0,0 +1,285 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "FBSnapshotRecorder.h"
+
+#import "FBSnapshotTestController.h"
+#import "UIImage+Compare.h"
+
+#include <stdlib.h>
+
+NSString *FBReferenceImageCachePath(NSString *cacheDirectory, FBReferenceEntry entry)
+{
+  NSString *fileName = [NSString stringWithFormat:@"%016llx-%ux%u.rgba",
+                        (unsigned long long)entry.hash, entry.width, entry.height];
+  return [cacheDirectory stringByAppendingPathComponent:fileName];
+}
+
+static void FBSnapshotRecorderFlushAtExit(void)
+{
+  // Too late to fail a test; only reached by failures nothing waited for
+  NSError *error = nil;
+  if (![[FBSnapshotRecorder sharedRecorder] waitUntilFinished:&error]) {
+    NSLog(@"Some snapshots could not be recorded: %@", error);
+  }
+}
+
+@implementation FBSnapshotRecorder
+{
+  dispatch_queue_t _workQueue;
+  dispatch_group_t _pending;
+  /** Bounds how many images are in memory waiting to be written. */
+  dispatch_semaphore_t _slots;
+
+  /** Serializes access to the indexes and the state below. */
+  dispatch_queue_t _indexQueue;
+  NSMutableDictionary *_indexes;
+  NSMutableSet *_changedIndexPaths;
+  NSError *_firstError;
+  NSUInteger _writtenCount;
+  NSUInteger _unchangedCount;
+}
+
+#pragma mark -
+#pragma mark Lifecycle
+
++ (FBSnapshotRecorder *)sharedRecorder
+{
+  static FBSnapshotRecorder *sharedRecorder = nil;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedRecorder = [[FBSnapshotRecorder alloc] init];
+    atexit(FBSnapshotRecorderFlushAtExit);
+  });
+  return sharedRecorder;
+}
+
+- (id)init
+{
+  if ((self = [super init])) {
+    _workQueue = dispatch_queue_create("com.facebook.FBSnapshotRecorder.work", DISPATCH_QUEUE_CONCURRENT);
+    _pending = dispatch_group_create();
+    _slots = dispatch_semaphore_create(MAX([NSProcessInfo processInfo].activeProcessorCount, 1) * 2);
+    _indexQueue = dispatch_queue_create("com.facebook.FBSnapshotRecorder.index", DISPATCH_QUEUE_SERIAL);
+    _indexes = [NSMutableDictionary dictionary];
+    _changedIndexPaths = [NSMutableSet set];
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  for (NSValue *index in _indexes.allValues) {
+    FBReferenceIndexFree(index.pointerValue);
+  }
+}
+
+#pragma mark -
+#pragma mark Public API
+
+- (void)recordImage:(UIImage *)image
+         toFilePath:(NSString *)filePath
+     cacheDirectory:(NSString *)cacheDirectory
+{
+  NSParameterAssert(image);
+  NSParameterAssert(filePath);
+
+  dispatch_semaphore_wait(_slots, DISPATCH_TIME_FOREVER);
+  dispatch_group_async(_pending, _workQueue, ^{
+    @autoreleasepool {
+      [self _writeImage:image toFilePath:filePath cacheDirectory:cacheDirectory];
+    }
+    dispatch_semaphore_signal(_slots);
+  });
+}
+
+- (void)flush
+{
+  dispatch_group_wait(_pending, DISPATCH_TIME_FOREVER);
+
+  dispatch_sync(_indexQueue, ^{
+    for (NSString *indexPath in _changedIndexPaths) {
+      FBReferenceIndex *index = [_indexes[indexPath] pointerValue];
+      if (!FBReferenceIndexSave(index, indexPath.fileSystemRepresentation)) {
+        NSLog(@"Unable to write reference image index: %@", indexPath);
+        _firstError = _firstError ?: [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                                         code:FBSnapshotTestControllerErrorCodeIndexFailed
+                                                     userInfo:@{
+                                  FBReferenceImageFilePathKey: indexPath,
+                                    NSLocalizedDescriptionKey: @"Unable to write reference image index.",
+                                      }];
+      }
+    }
+    [_changedIndexPaths removeAllObjects];
+
+    if (_writtenCount || _unchangedCount) {
+      NSLog(@"Recorded %lu reference images, %lu unchanged",
+            (unsigned long)_writtenCount, (unsigned long)_unchangedCount);
+    }
+    _writtenCount = 0;
+    _unchangedCount = 0;
+  });
+}
+
+- (BOOL)waitUntilFinished:(NSError **)errorPtr
+{
+  [self flush];
+
+  __block NSError *error = nil;
+  dispatch_sync(_indexQueue, ^{
+    error = _firstError;
+    _firstError = nil;
+  });
+
+  if (nil != error && NULL != errorPtr) {
+    *errorPtr = error;
+  }
+  return nil == error;
+}
+
+#pragma mark -
+#pragma mark Private API
+
+/**
+ Runs on the work queue.
+ */
+- (void)_writeImage:(UIImage *)image toFilePath:(NSString *)filePath cacheDirectory:(NSString *)cacheDirectory
+{
+  NSString *indexPath = [[filePath stringByDeletingLastPathComponent]
+                         stringByAppendingPathComponent:@(FBReferenceIndexFileName)];
+  NSString *fileName = filePath.lastPathComponent;
+
+  // The index only describes the file on disk if it is still the file that was indexed; if it was deleted, replaced,
+  // or recorded before there was an index, what is there is hashed instead, once
+  FBReferenceEntry existing;
+  BOOL hasExisting = [self _lookupEntry:&existing indexPath:indexPath fileName:fileName] &&
+                     FBReferenceEntryMatchesFile(existing, filePath.fileSystemRepresentation);
+  if (!hasExisting) {
+    UIImage *existingImage = [UIImage imageWithContentsOfFile:filePath];
+    NSData *existingPixels = [existingImage fb_RGBAPixels];
+    if (nil != existingPixels) {
+      existing = FBReferenceEntryMake(FBImageBufferWithPixels(existingImage, existingPixels));
+      hasExisting = FBReferenceEntrySetFile(&existing, filePath.fileSystemRepresentation);
+      if (hasExisting) {
+        [self _setEntry:existing indexPath:indexPath fileName:fileName];
+      }
+    }
+  }
+
+  // Most recordings of opaque views hash the same before and after a round trip through PNG, so try without encoding
+  NSData *pixels = [image fb_RGBAPixels];
+  if (hasExisting && nil != pixels &&
+      FBReferenceEntryEqual(existing, FBReferenceEntryMake(FBImageBufferWithPixels(image, pixels)))) {
+    [self _countWrite:NO];
+    return;
+  }
+
+  NSData *pngData = UIImagePNGRepresentation(image);
+  if (nil == pngData) {
+    [self _recordError:[NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                           code:FBSnapshotTestControllerErrorCodePNGCreationFailed
+                                       userInfo:@{
+                    FBReferenceImageFilePathKey: filePath,
+                        }]];
+    return;
+  }
+
+  // Hash the pixels as they will be decoded, since a round trip through PNG can change translucent pixels
+  UIImage *decodedImage = [UIImage imageWithData:pngData];
+  NSData *decodedPixels = [decodedImage fb_RGBAPixels];
+  FBImageBuffer decodedBuffer = FBImageBufferWithPixels(decodedImage, decodedPixels);
+  FBReferenceEntry entry = { 0 };
+  if (nil != decodedPixels) {
+    entry = FBReferenceEntryMake(decodedBuffer);
+    if (hasExisting && FBReferenceEntryEqual(existing, entry)) {
+      [self _countWrite:NO];
+      return;
+    }
+  }
+
+  NSFileManager *fileManager = [[NSFileManager alloc] init];
+  NSError *error = nil;
+  BOOL didWrite = [fileManager createDirectoryAtPath:[filePath stringByDeletingLastPathComponent]
+                         withIntermediateDirectories:YES
+                                          attributes:nil
+                                               error:&error] &&
+                  [pngData writeToFile:filePath options:NSDataWritingAtomic error:&error];
+  if (!didWrite) {
+    [self _recordError:error];
+    return;
+  }
+
+  NSLog(@"Reference image save at: %@", filePath);
+  [self _countWrite:YES];
+  if (nil != decodedPixels && FBReferenceEntrySetFile(&entry, filePath.fileSystemRepresentation)) {
+    [self _setEntry:entry indexPath:indexPath fileName:fileName];
+    [fileManager createDirectoryAtPath:cacheDirectory withIntermediateDirectories:YES attributes:nil error:NULL];
+    FBRawImageWrite(FBReferenceImageCachePath(cacheDirectory, entry).fileSystemRepresentation, decodedBuffer);
+  }
+}
+
+/**
+ Runs on the index queue.
+ @returns The index kept in `indexPath`, loaded the first time it's needed, or NULL if it can't be read.
+ */
+- (FBReferenceIndex *)_indexAtPath:(NSString *)indexPath
+{
+  NSValue *index = _indexes[indexPath];
+  if (nil == index) {
+    index = [NSValue valueWithPointer:FBReferenceIndexLoad(indexPath.fileSystemRepresentation)];
+    _indexes[indexPath] = index;
+  }
+  return index.pointerValue;
+}
+
+- (BOOL)_lookupEntry:(FBReferenceEntry *)entry indexPath:(NSString *)indexPath fileName:(NSString *)fileName
+{
+  __block BOOL found = NO;
+  dispatch_sync(_indexQueue, ^{
+    FBReferenceIndex *index = [self _indexAtPath:indexPath];
+    found = NULL != index && FBReferenceIndexLookup(index, fileName.UTF8String, entry);
+  });
+  return found;
+}
+
+- (void)_setEntry:(FBReferenceEntry)entry indexPath:(NSString *)indexPath fileName:(NSString *)fileName
+{
+  dispatch_sync(_indexQueue, ^{
+    FBReferenceIndex *index = [self _indexAtPath:indexPath];
+    if (NULL != index && FBReferenceIndexSet(index, fileName.UTF8String, entry)) {
+      [_changedIndexPaths addObject:indexPath];
+    }
+  });
+}
+
+- (void)_countWrite:(BOOL)written
+{
+  dispatch_sync(_indexQueue, ^{
+    if (written) {
+      _writtenCount++;
+    } else {
+      _unchangedCount++;
+    }
+  });
+}
+
+- (void)_recordError:(NSError *)error
+{
+  NSLog(@"Unable to record reference image: %@", error);
+  dispatch_sync(_indexQueue, ^{
+    if (nil == _firstError) {
+      _firstError = error ?: [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                                 code:FBSnapshotTestControllerErrorCodeUnknown
+                                             userInfo:nil];
+    }
+  });
+}
+
+@end
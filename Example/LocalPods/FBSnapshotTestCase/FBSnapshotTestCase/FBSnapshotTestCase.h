@@ -14,6 +14,8 @@
 
 #import <XCTest/XCTest.h>
 
+#import "FBImageCompare.h"
+
 #ifndef FB_REFERENCE_IMAGE_DIR
 #define FB_REFERENCE_IMAGE_DIR "\"$(SOURCE_ROOT)/$(PROJECT_NAME)Tests/ReferenceImages\""
 #endif
@@ -65,6 +67,12 @@
  **/
 @property (readwrite, nonatomic, assign) BOOL renderAsLayer;
 
+/**
+ How different a snapshot may be from its reference image and still pass, such as to allow for anti-aliasing
+ differences between machines. Defaults to an exact match.
+ **/
+@property (readwrite, nonatomic, assign) FBImageCompareOptions compareOptions;
+
 /**
  Performs the comparisong or records a snapshot of the layer if recordMode is YES.
  @param layer The Layer to snapshot
@@ -28,6 +28,11 @@
 
 - (void)tearDown
 {
+  // Snapshots this test recorded are written in the background; it fails here if any of them couldn't be
+  NSError *error = nil;
+  if (![FBSnapshotTestController waitForRecordedSnapshots:&error]) {
+    XCTFail(@"Snapshots could not be recorded: %@", error);
+  }
   self.snapshotController = nil;
   [super tearDown];
 }
@@ -52,6 +57,16 @@
     self.snapshotController.renderAsLayer = renderAsLayer;
 }
 
+- (FBImageCompareOptions)compareOptions
+{
+  return self.snapshotController.compareOptions;
+}
+
+- (void)setCompareOptions:(FBImageCompareOptions)compareOptions
+{
+  self.snapshotController.compareOptions = compareOptions;
+}
+
 - (BOOL)compareSnapshotOfLayer:(CALayer *)layer
       referenceImagesDirectory:(NSString *)referenceImagesDirectory
                     identifier:(NSString *)identifier
@@ -11,12 +11,16 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+#import "FBImageCompare.h"
+#import "FBReferenceImageStore.h"
+
 typedef NS_ENUM(NSInteger, FBSnapshotTestControllerErrorCode) {
   FBSnapshotTestControllerErrorCodeUnknown,
   FBSnapshotTestControllerErrorCodeNeedsRecord,
   FBSnapshotTestControllerErrorCodePNGCreationFailed,
   FBSnapshotTestControllerErrorCodeImagesDifferentSizes,
   FBSnapshotTestControllerErrorCodeImagesDifferent,
+  FBSnapshotTestControllerErrorCodeIndexFailed,
 };
 /**
  Errors returned by the methods of FBSnapshotTestController use this domain.
@@ -28,6 +32,22 @@ extern NSString *const FBSnapshotTestControllerErrorDomain;
  */
 extern NSString *const FBReferenceImageFilePathKey;
 
+/**
+ When images are different, the `userInfo` of the error contains the number of differing pixels under this key.
+ */
+extern NSString *const FBDifferingPixelCountKey;
+
+/**
+ When images are different, the `userInfo` of the error contains the largest difference in any one channel under this key.
+ */
+extern NSString *const FBMaxChannelDeltaKey;
+
+/**
+ When images are different, the `userInfo` of the error contains a CGRect in pixels, boxed in an NSValue, under this
+ key. It bounds every differing pixel found before the comparison stopped.
+ */
+extern NSString *const FBDifferingBoundsKey;
+
 /**
  Provides the heavy-lifting for FBSnapshotTestCase. It loads and saves images, along with performing the actual pixel-
  by-pixel comparison of images.
@@ -36,7 +56,8 @@ extern NSString *const FBReferenceImageFilePathKey;
 @interface FBSnapshotTestController : NSObject
 
 /**
- Record snapshots.
+ Record snapshots. Snapshots are written in the background, and only if their pixels changed; see
+ +waitForRecordedSnapshots:.
  **/
 @property(readwrite, nonatomic, assign) BOOL recordMode;
 
@@ -45,6 +66,11 @@ extern NSString *const FBReferenceImageFilePathKey;
  **/
 @property(readwrite, nonatomic, assign) BOOL renderAsLayer;
 
+/**
+ How different a snapshot may be from its reference image and still pass. Defaults to an exact match.
+ **/
+@property(readwrite, nonatomic, assign) FBImageCompareOptions compareOptions;
+
 /**
  Designated initializer.
  Before this methods returns the controller enumerates over the test methods in `testClass` and loads the images
@@ -101,6 +127,34 @@ extern NSString *const FBReferenceImageFilePathKey;
  */
 @property (readwrite, nonatomic, copy) NSString *referenceImagesDirectory;
 
+/**
+ The directory in which decoded reference images are cached, uncompressed, so that a reference image only has to be
+ decoded from PNG the first time a snapshot doesn't match it. Defaults to the REFERENCE_IMAGE_CACHE_DIR environment
+ variable, or a directory inside NSTemporaryDirectory().
+ */
+@property (readwrite, nonatomic, copy) NSString *referenceImageCacheDirectory;
+
+/**
+ Writes an index of the pixels of every reference image in each subdirectory of `referenceImagesDirectory`.
+ With an index, a snapshot whose pixels hash the same as its reference image passes without the reference image
+ being decoded, as long as the image is still the file that was indexed. Run this once for reference images recorded
+ without an index, or with an index from before files were hashed; recording keeps it up to date.
+ @param referenceImagesDirectory The directory in which reference images are stored.
+ @param error An error, if this methods returns NO, the error will be something useful.
+ @returns YES if every index was written.
+ */
++ (BOOL)buildReferenceImageIndexesInDirectory:(NSString *)referenceImagesDirectory
+                                        error:(NSError **)errorPtr;
+
+/**
+ Waits for every snapshot recorded so far to be written, along with the indexes of their directories.
+ FBSnapshotTestCase calls this after each test, and fails the test if it returns NO. Failures stay pending until
+ this method reports them, so anything else that uses FBSnapshotTestController in record mode must call it too.
+ @param error The first error since this method was last called, if this methods returns NO.
+ @returns YES if every recorded snapshot was written or was already up to date.
+ */
++ (BOOL)waitForRecordedSnapshots:(NSError **)errorPtr;
+
 /**
  Loads a reference image.
  @param selector The test method being run.
@@ -113,7 +167,7 @@ extern NSString *const FBReferenceImageFilePathKey;
                                  error:(NSError **)error;
 
 /**
- Saves a reference image.
+ Saves a reference image, unless the one already saved has the same pixels, and waits for it to be written.
  @param selector The test method being run.
  @param identifier The optional identifier, used when multiple images are tested in a single -test method.
  @param error An error, if this methods returns NO, the error will be something useful.
@@ -125,7 +179,7 @@ extern NSString *const FBReferenceImageFilePathKey;
                      error:(NSError **)errorPtr;
 
 /**
- Performs a pixel-by-pixel comparison of the two images.
+ Performs a pixel-by-pixel comparison of the two images, within the tolerance given by `compareOptions`.
  @param referenceImage The reference (correct) image.
  @param image The image to test against the reference.
  @param error An error that indicates why the comparison failed if it does.
@@ -136,7 +190,8 @@ extern NSString *const FBReferenceImageFilePathKey;
                         error:(NSError **)errorPtr;
 
 /**
- Saves the reference image and the test image to `failedOutputDirectory`.
+ Saves the reference image and the test image to `failedOutputDirectory`, along with a heatmap of the pixels that
+ changed and a JSON report of the regions that changed and per-tile statistics, for tools to read.
  @param referenceImage The reference (correct) image.
  @param testImage The image to test against the reference.
  @param selector The test method being run.
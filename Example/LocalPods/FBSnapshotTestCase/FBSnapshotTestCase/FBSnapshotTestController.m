@@ -0,0 +1,636 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "FBSnapshotTestController.h"
+
+#import "FBSnapshotRecorder.h"
+#import "UIImage+Compare.h"
+#import "UIImage+Diff.h"
+#import "FBImageDiff.h"
+
+#import <objc/runtime.h>
+
+#import <UIKit/UIKit.h>
+
+NSString *const FBSnapshotTestControllerErrorDomain = @"FBSnapshotTestControllerErrorDomain";
+
+NSString *const FBReferenceImageFilePathKey = @"FBReferenceImageFilePathKey";
+
+NSString *const FBDifferingPixelCountKey = @"FBDifferingPixelCountKey";
+
+NSString *const FBMaxChannelDeltaKey = @"FBMaxChannelDeltaKey";
+
+NSString *const FBDifferingBoundsKey = @"FBDifferingBoundsKey";
+
+typedef struct RGBAPixel {
+  char r;
+  char g;
+  char b;
+  char a;
+} RGBAPixel;
+
+@interface FBSnapshotTestController ()
+
+@property (readonly, nonatomic, retain) Class testClass;
+
+@end
+
+/**
+ The width and height of the tiles that diffs of failed snapshots are broken into.
+ */
+static const size_t FBDiffTileSize = 32;
+
+static NSDictionary *FBDictionaryFromPixelRect(FBPixelRect rect)
+{
+  return @{ @"x": @(rect.x), @"y": @(rect.y), @"width": @(rect.width), @"height": @(rect.height) };
+}
+
+/**
+ @returns A machine-readable description of a diff: the regions that changed, and statistics for each changed tile.
+ */
+static NSDictionary *FBDiffReport(const FBImageDiff *diff)
+{
+  NSMutableArray *regions = [NSMutableArray arrayWithCapacity:diff->regionCount];
+  for (size_t i = 0; i < diff->regionCount; i++) {
+    NSMutableDictionary *region = [FBDictionaryFromPixelRect(diff->regions[i].bounds) mutableCopy];
+    region[@"differingPixelCount"] = @(diff->regions[i].differingPixelCount);
+    [regions addObject:region];
+  }
+
+  NSMutableArray *tiles = [NSMutableArray array];
+  for (size_t i = 0; i < diff->tilesAcross * diff->tilesDown; i++) {
+    const FBDiffTile *tile = &diff->tiles[i];
+    if (!tile->differingPixelCount) {
+      continue;
+    }
+    NSMutableDictionary *tileReport = [FBDictionaryFromPixelRect(tile->frame) mutableCopy];
+    tileReport[@"differingPixelCount"] = @(tile->differingPixelCount);
+    tileReport[@"maxChannelDelta"] = @(tile->maxChannelDelta);
+    tileReport[@"meanDelta"] = @(tile->meanDelta);
+    tileReport[@"differingBounds"] = FBDictionaryFromPixelRect(tile->differingBounds);
+    [tiles addObject:tileReport];
+  }
+
+  return @{
+    @"width": @(diff->width),
+    @"height": @(diff->height),
+    @"tileSize": @(diff->tileSize),
+    @"differingPixelCount": @(diff->differingPixelCount),
+    @"maxChannelDelta": @(diff->maxChannelDelta),
+    @"regions": regions,
+    @"changedTiles": tiles,
+  };
+}
+
+@implementation FBSnapshotTestController
+{
+  NSFileManager *_fileManager;
+  FBReferenceIndex *_referenceIndex;
+  NSString *_referenceIndexPath;
+}
+
+#pragma mark -
+#pragma mark Lifecycle
+
+- (id)initWithTestClass:(Class)testClass;
+{
+  if ((self = [super init])) {
+    _testClass = testClass;
+    _fileManager = [[NSFileManager alloc] init];
+    if (getenv("REFERENCE_IMAGE_CACHE_DIR")) {
+      _referenceImageCacheDirectory = @(getenv("REFERENCE_IMAGE_CACHE_DIR"));
+    } else {
+      _referenceImageCacheDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"FBReferenceImageCache"];
+    }
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  FBReferenceIndexFree(_referenceIndex);
+}
+
+#pragma mark -
+#pragma mark Properties
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"%@ %@", [super description], _referenceImagesDirectory];
+}
+
+#pragma mark -
+#pragma mark Public API
+
++ (BOOL)buildReferenceImageIndexesInDirectory:(NSString *)referenceImagesDirectory
+                                        error:(NSError **)errorPtr
+{
+  NSFileManager *fileManager = [[NSFileManager alloc] init];
+  NSArray *classDirectories = [fileManager contentsOfDirectoryAtPath:referenceImagesDirectory error:errorPtr];
+  if (nil == classDirectories) {
+    return NO;
+  }
+
+  for (NSString *classDirectory in classDirectories) {
+    NSString *directory = [referenceImagesDirectory stringByAppendingPathComponent:classDirectory];
+    NSArray *fileNames = [fileManager contentsOfDirectoryAtPath:directory error:NULL];
+    FBReferenceIndex *index = FBReferenceIndexCreate();
+
+    for (NSString *fileName in fileNames) {
+      if (![fileName.pathExtension isEqualToString:@"png"]) {
+        continue;
+      }
+      @autoreleasepool {
+        NSString *filePath = [directory stringByAppendingPathComponent:fileName];
+        UIImage *image = [UIImage imageWithContentsOfFile:filePath];
+        NSData *pixels = [image fb_RGBAPixels];
+        FBReferenceEntry entry = FBReferenceEntryMake(FBImageBufferWithPixels(image, pixels));
+        if (nil != pixels && FBReferenceEntrySetFile(&entry, filePath.fileSystemRepresentation)) {
+          FBReferenceIndexSet(index, fileName.UTF8String, entry);
+        }
+      }
+    }
+
+    NSString *indexPath = [directory stringByAppendingPathComponent:@(FBReferenceIndexFileName)];
+    BOOL saved = 0 == FBReferenceIndexCount(index) || FBReferenceIndexSave(index, indexPath.fileSystemRepresentation);
+    FBReferenceIndexFree(index);
+    if (!saved) {
+      if (NULL != errorPtr) {
+        *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                        code:FBSnapshotTestControllerErrorCodeIndexFailed
+                                    userInfo:@{
+                 FBReferenceImageFilePathKey: indexPath,
+                   NSLocalizedDescriptionKey: @"Unable to write reference image index.",
+                     }];
+      }
+      return NO;
+    }
+  }
+  return YES;
+}
+
++ (BOOL)waitForRecordedSnapshots:(NSError **)errorPtr
+{
+  return [[FBSnapshotRecorder sharedRecorder] waitUntilFinished:errorPtr];
+}
+
+- (UIImage *)referenceImageForSelector:(SEL)selector
+                            identifier:(NSString *)identifier
+                                 error:(NSError **)errorPtr
+{
+  NSString *filePath = [self _referenceFilePathForSelector:selector identifier:identifier];
+  UIImage *image = [UIImage imageWithContentsOfFile:filePath];
+  if (nil == image && NULL != errorPtr) {
+    BOOL exists = [_fileManager fileExistsAtPath:filePath];
+    if (!exists) {
+      *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                      code:FBSnapshotTestControllerErrorCodeNeedsRecord
+                                  userInfo:@{
+               FBReferenceImageFilePathKey: filePath,
+                 NSLocalizedDescriptionKey: @"Unable to load reference image.",
+          NSLocalizedFailureReasonErrorKey: @"Reference image not found. You need to run the test in record mode",
+                   }];
+    } else {
+      *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                      code:FBSnapshotTestControllerErrorCodeUnknown
+                                  userInfo:nil];
+    }
+  }
+  return image;
+}
+
+- (BOOL)saveReferenceImage:(UIImage *)image
+                  selector:(SEL)selector
+                identifier:(NSString *)identifier
+                     error:(NSError **)errorPtr
+{
+  if (nil == image) {
+    return NO;
+  }
+  FBSnapshotRecorder *recorder = [FBSnapshotRecorder sharedRecorder];
+  [recorder recordImage:image
+             toFilePath:[self _referenceFilePathForSelector:selector identifier:identifier]
+         cacheDirectory:_referenceImageCacheDirectory];
+  return [recorder waitUntilFinished:errorPtr];
+}
+
+- (BOOL)saveFailedReferenceImage:(UIImage *)referenceImage
+                       testImage:(UIImage *)testImage
+                        selector:(SEL)selector
+                      identifier:(NSString *)identifier
+                           error:(NSError **)errorPtr
+{
+  NSData *referencePNGData = UIImagePNGRepresentation(referenceImage);
+  NSData *testPNGData = UIImagePNGRepresentation(testImage);
+
+  NSString *referencePath = [self _failedFilePathForSelector:selector
+                                                  identifier:identifier
+                                                fileNameType:FBTestSnapshotFileNameTypeFailedReference];
+
+  NSError *creationError = nil;
+  BOOL didCreateDir = [_fileManager createDirectoryAtPath:[referencePath stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:&creationError];
+  if (!didCreateDir) {
+    if (NULL != errorPtr) {
+      *errorPtr = creationError;
+    }
+    return NO;
+  }
+
+  if (![referencePNGData writeToFile:referencePath options:NSDataWritingAtomic error:errorPtr]) {
+    return NO;
+  }
+
+  NSString *testPath = [self _failedFilePathForSelector:selector
+                                             identifier:identifier
+                                           fileNameType:FBTestSnapshotFileNameTypeFailedTest];
+
+  if (![testPNGData writeToFile:testPath options:NSDataWritingAtomic error:errorPtr]) {
+    return NO;
+  }
+
+  NSString *diffPath = [self _failedFilePathForSelector:selector
+                                               identifier:identifier
+                                             fileNameType:FBTestSnapshotFileNameTypeFailedTestDiff];
+
+  NSData *referencePixels = [referenceImage fb_RGBAPixels];
+  NSData *testPixels = [testImage fb_RGBAPixels];
+  FBImageDiff diff;
+  if (nil != referencePixels && nil != testPixels &&
+      FBImageDiffCreate(FBImageBufferWithPixels(referenceImage, referencePixels),
+                        FBImageBufferWithPixels(testImage, testPixels),
+                        _compareOptions.channelTolerance,
+                        FBDiffTileSize,
+                        &diff)) {
+    UIImage *heatmap = [UIImage fb_imageWithRGBAPixels:diff.heatmap
+                                                 width:diff.width
+                                                height:diff.height
+                                                 scale:testImage.scale];
+    NSData *heatmapData = UIImagePNGRepresentation(heatmap);
+    NSData *reportData = [NSJSONSerialization dataWithJSONObject:FBDiffReport(&diff) options:NSJSONWritingPrettyPrinted error:NULL];
+    FBImageDiffFree(&diff);
+
+    NSString *reportPath = [[diffPath stringByDeletingPathExtension] stringByAppendingPathExtension:@"json"];
+    if (![heatmapData writeToFile:diffPath options:NSDataWritingAtomic error:errorPtr] ||
+        ![reportData writeToFile:reportPath options:NSDataWritingAtomic error:errorPtr]) {
+      return NO;
+    }
+  } else {
+    // Images of different sizes can only be compared by eye
+    UIImage *diffImage = [referenceImage diffWithImage:testImage];
+    NSData *diffImageData = UIImagePNGRepresentation(diffImage);
+
+    if (![diffImageData writeToFile:diffPath options:NSDataWritingAtomic error:errorPtr]) {
+      return NO;
+    }
+  }
+
+  NSLog(@"If you have Kaleidoscope installed you can run this command to see an image diff:\n"
+        @"ksdiff \"%@\" \"%@\"", referencePath, testPath);
+
+  return YES;
+}
+
+- (BOOL)compareReferenceImage:(UIImage *)referenceImage toImage:(UIImage *)image error:(NSError **)errorPtr
+{
+  if (CGSizeEqualToSize(referenceImage.size, image.size)) {
+    NSData *referencePixels = [referenceImage fb_RGBAPixels];
+    NSData *imagePixels = [image fb_RGBAPixels];
+    if (nil == referencePixels || nil == imagePixels) {
+      if (NULL != errorPtr) {
+        *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                        code:FBSnapshotTestControllerErrorCodeUnknown
+                                    userInfo:nil];
+      }
+      return NO;
+    }
+    return [self _compareReferenceBuffer:FBImageBufferWithPixels(referenceImage, referencePixels)
+                                toBuffer:FBImageBufferWithPixels(image, imagePixels)
+                                   error:errorPtr];
+  }
+  if (NULL != errorPtr) {
+    *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                    code:FBSnapshotTestControllerErrorCodeImagesDifferentSizes
+                                userInfo:@{
+               NSLocalizedDescriptionKey: @"Images different sizes",
+        NSLocalizedFailureReasonErrorKey: [NSString stringWithFormat:@"referenceImage:%@, image:%@",
+                                           NSStringFromCGSize(referenceImage.size),
+                                           NSStringFromCGSize(image.size)],
+                 }];
+  }
+  return NO;
+}
+
+#pragma mark -
+#pragma mark Private API
+
+- (BOOL)_compareReferenceBuffer:(FBImageBuffer)reference toBuffer:(FBImageBuffer)image error:(NSError **)errorPtr
+{
+  if (reference.width == image.width && reference.height == image.height) {
+    FBImageCompareResult result = FBImageCompareBuffers(reference, image, _compareOptions, true);
+    BOOL imagesEqual = result.passed;
+    if (!imagesEqual && NULL != errorPtr) {
+      FBPixelRect bounds = result.differingBounds;
+      NSString *reason = [NSString stringWithFormat:@"%@%zu pixels differ by up to %u, within {%zu, %zu, %zu, %zu}",
+                          result.stoppedEarly ? @"At least " : @"",
+                          result.differingPixelCount,
+                          result.maxChannelDelta,
+                          bounds.x, bounds.y, bounds.width, bounds.height];
+      *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                      code:FBSnapshotTestControllerErrorCodeImagesDifferent
+                                  userInfo:@{
+                 NSLocalizedDescriptionKey: @"Images different",
+          NSLocalizedFailureReasonErrorKey: reason,
+                  FBDifferingPixelCountKey: @(result.differingPixelCount),
+                      FBMaxChannelDeltaKey: @(result.maxChannelDelta),
+                      FBDifferingBoundsKey: [NSValue valueWithCGRect:CGRectMake(bounds.x, bounds.y, bounds.width, bounds.height)],
+                   }];
+    }
+    return imagesEqual;
+  }
+  if (NULL != errorPtr) {
+    *errorPtr = [NSError errorWithDomain:FBSnapshotTestControllerErrorDomain
+                                    code:FBSnapshotTestControllerErrorCodeImagesDifferentSizes
+                                userInfo:@{
+               NSLocalizedDescriptionKey: @"Images different sizes",
+        NSLocalizedFailureReasonErrorKey: [NSString stringWithFormat:@"referenceImage:%zux%zu, image:%zux%zu pixels",
+                                           reference.width, reference.height, image.width, image.height],
+                 }];
+  }
+  return NO;
+}
+
+typedef NS_ENUM(NSUInteger, FBTestSnapshotFileNameType) {
+  FBTestSnapshotFileNameTypeReference,
+  FBTestSnapshotFileNameTypeFailedReference,
+  FBTestSnapshotFileNameTypeFailedTest,
+  FBTestSnapshotFileNameTypeFailedTestDiff,
+};
+
+- (NSString *)_fileNameForSelector:(SEL)selector
+                        identifier:(NSString *)identifier
+                      fileNameType:(FBTestSnapshotFileNameType)fileNameType
+{
+  NSString *fileName = nil;
+  switch (fileNameType) {
+    case FBTestSnapshotFileNameTypeFailedReference:
+      fileName = @"reference_";
+      break;
+    case FBTestSnapshotFileNameTypeFailedTest:
+      fileName = @"failed_";
+      break;
+    case FBTestSnapshotFileNameTypeFailedTestDiff:
+      fileName = @"diff_";
+      break;
+    default:
+      fileName = @"";
+      break;
+  }
+  fileName = [fileName stringByAppendingString:NSStringFromSelector(selector)];
+  if (0 < identifier.length) {
+    fileName = [fileName stringByAppendingFormat:@"_%@", identifier];
+  }
+  if ([[UIScreen mainScreen] scale] > 1.0) {
+    fileName = [fileName stringByAppendingFormat:@"@%.fx", [[UIScreen mainScreen] scale]];
+  }
+  fileName = [fileName stringByAppendingPathExtension:@"png"];
+  return fileName;
+}
+
+- (NSString *)_referenceDirectory
+{
+  return [_referenceImagesDirectory stringByAppendingPathComponent:NSStringFromClass(_testClass)];
+}
+
+/**
+ @returns The index of the reference images for the test class, loaded the first time it's needed, or NULL if it
+ can't be read.
+ */
+- (FBReferenceIndex *)_referenceIndex
+{
+  NSString *indexPath = [[self _referenceDirectory] stringByAppendingPathComponent:@(FBReferenceIndexFileName)];
+  if (![indexPath isEqualToString:_referenceIndexPath]) {
+    FBReferenceIndexFree(_referenceIndex);
+    _referenceIndex = FBReferenceIndexLoad(indexPath.fileSystemRepresentation);
+    _referenceIndexPath = [indexPath copy];
+  }
+  return _referenceIndex;
+}
+
+- (void)_cacheReferenceBuffer:(FBImageBuffer)buffer entry:(FBReferenceEntry)entry
+{
+  [_fileManager createDirectoryAtPath:_referenceImageCacheDirectory
+          withIntermediateDirectories:YES
+                           attributes:nil
+                                error:NULL];
+  FBRawImageWrite(FBReferenceImageCachePath(_referenceImageCacheDirectory, entry).fileSystemRepresentation, buffer);
+}
+
+- (NSString *)_referenceFilePathForSelector:(SEL)selector identifier:(NSString *)identifier
+{
+  NSString *fileName = [self _fileNameForSelector:selector
+                                       identifier:identifier
+                                     fileNameType:FBTestSnapshotFileNameTypeReference];
+  return [[self _referenceDirectory] stringByAppendingPathComponent:fileName];
+}
+
+- (NSString *)_failedFilePathForSelector:(SEL)selector
+                              identifier:(NSString *)identifier
+                            fileNameType:(FBTestSnapshotFileNameType)fileNameType
+{
+  NSString *fileName = [self _fileNameForSelector:selector
+                                       identifier:identifier
+                                     fileNameType:fileNameType];
+  NSString *folderPath = NSTemporaryDirectory();
+  if (getenv("IMAGE_DIFF_DIR")) {
+    folderPath = @(getenv("IMAGE_DIFF_DIR"));
+  }
+  NSString *filePath = [folderPath stringByAppendingPathComponent:NSStringFromClass(_testClass)];
+  filePath = [filePath stringByAppendingPathComponent:fileName];
+  return filePath;
+}
+
+- (BOOL)compareSnapshotOfLayer:(CALayer *)layer
+                      selector:(SEL)selector
+                    identifier:(NSString *)identifier
+                         error:(NSError **)errorPtr
+{
+  return [self compareSnapshotOfViewOrLayer:layer
+                                   selector:selector
+                                 identifier:identifier
+                                      error:errorPtr];
+}
+
+- (BOOL)compareSnapshotOfView:(UIView *)view
+                     selector:(SEL)selector
+                   identifier:(NSString *)identifier
+                        error:(NSError **)errorPtr
+{
+  return [self compareSnapshotOfViewOrLayer:view
+                                   selector:selector
+                                 identifier:identifier
+                                      error:errorPtr];
+}
+
+- (BOOL)compareSnapshotOfViewOrLayer:(id)viewOrLayer
+                            selector:(SEL)selector
+                          identifier:(NSString *)identifier
+                               error:(NSError **)errorPtr
+{
+  if (self.recordMode) {
+    return [self _recordSnapshotOfViewOrLayer:viewOrLayer selector:selector identifier:identifier error:errorPtr];
+  } else {
+    return [self _performPixelComparisonWithViewOrLayer:viewOrLayer selector:selector identifier:identifier error:errorPtr];
+  }
+}
+
+#pragma mark -
+#pragma mark Private API
+
+- (BOOL)_performPixelComparisonWithViewOrLayer:(UIView *)viewOrLayer
+                                      selector:(SEL)selector
+                                    identifier:(NSString *)identifier
+                                         error:(NSError **)errorPtr
+{
+  // A reference image may still be being recorded; any failure to record it is left for +waitForRecordedSnapshots:
+  [[FBSnapshotRecorder sharedRecorder] flush];
+
+  UIImage *snapshot = [self _snapshotViewOrLayer:viewOrLayer];
+  NSData *snapshotPixels = [snapshot fb_RGBAPixels];
+  FBImageBuffer snapshotBuffer = FBImageBufferWithPixels(snapshot, snapshotPixels);
+
+  // Most snapshots match; when the index says so, the reference image never needs to be decoded. The index is only
+  // trusted while the reference image is the file it was made from, so that a deleted, replaced, or merged image
+  // is decoded and reported as usual.
+  FBReferenceIndex *index = [self _referenceIndex];
+  NSString *referencePath = [self _referenceFilePathForSelector:selector identifier:identifier];
+  FBReferenceEntry referenceEntry;
+  BOOL indexed = nil != snapshotPixels && NULL != index &&
+                 FBReferenceIndexLookup(index, referencePath.lastPathComponent.UTF8String, &referenceEntry) &&
+                 FBReferenceEntryMatchesFile(referenceEntry, referencePath.fileSystemRepresentation);
+  if (indexed) {
+    if (FBReferenceEntryEqual(referenceEntry, FBReferenceEntryMake(snapshotBuffer))) {
+      return YES;
+    }
+
+    // Close enough may still pass; compare against the cached pixels rather than decoding the PNG
+    FBMappedImage cached;
+    if (FBRawImageMap(FBReferenceImageCachePath(_referenceImageCacheDirectory, referenceEntry).fileSystemRepresentation, &cached)) {
+      BOOL imagesSame = [self _compareReferenceBuffer:cached.buffer toBuffer:snapshotBuffer error:NULL];
+      FBRawImageUnmap(&cached);
+      if (imagesSame) {
+        return YES;
+      }
+    }
+  }
+
+  UIImage *referenceImage = [self referenceImageForSelector:selector identifier:identifier error:errorPtr];
+  if (nil != referenceImage) {
+    NSData *referencePixels = [referenceImage fb_RGBAPixels];
+    BOOL imagesSame = NO;
+    if (nil != referencePixels && nil != snapshotPixels) {
+      FBImageBuffer referenceBuffer = FBImageBufferWithPixels(referenceImage, referencePixels);
+      if (indexed) {
+        [self _cacheReferenceBuffer:referenceBuffer entry:FBReferenceEntryMake(referenceBuffer)];
+      }
+      imagesSame = [self _compareReferenceBuffer:referenceBuffer toBuffer:snapshotBuffer error:errorPtr];
+    } else {
+      imagesSame = [self compareReferenceImage:referenceImage toImage:snapshot error:errorPtr];
+    }
+    if (!imagesSame) {
+      [self saveFailedReferenceImage:referenceImage
+                           testImage:snapshot
+                            selector:selector
+                          identifier:identifier
+                               error:errorPtr];
+    }
+    return imagesSame;
+  }
+  return NO;
+}
+
+- (BOOL)_recordSnapshotOfViewOrLayer:(id)viewOrLayer
+                            selector:(SEL)selector
+                          identifier:(NSString *)identifier
+                               error:(NSError **)errorPtr
+{
+  UIImage *snapshot = [self _snapshotViewOrLayer:viewOrLayer];
+  if (nil == snapshot) {
+    return NO;
+  }
+  // Written in the background; failures are reported by +waitForRecordedSnapshots:, which -[FBSnapshotTestCase tearDown]
+  // calls to fail this test if they happen
+  [[FBSnapshotRecorder sharedRecorder] recordImage:snapshot
+                                        toFilePath:[self _referenceFilePathForSelector:selector identifier:identifier]
+                                    cacheDirectory:_referenceImageCacheDirectory];
+  return YES;
+}
+
+- (UIImage *)_snapshotViewOrLayer:(id)viewOrLayer
+{
+  CALayer *layer = nil;
+  
+  if ([viewOrLayer isKindOfClass:[UIView class]]) {
+    return [self _renderView:viewOrLayer];
+  } else if ([viewOrLayer isKindOfClass:[CALayer class]]) {
+    layer = (CALayer *)viewOrLayer;
+    [layer layoutIfNeeded];
+    return [self _renderLayer:layer];
+  } else {
+    [NSException raise:@"Only UIView and CALayer classes can be snapshotted" format:@"%@", viewOrLayer];
+  }
+  return nil;
+}
+
+- (UIImage *)_renderLayer:(CALayer *)layer
+{
+  CGRect bounds = layer.bounds;
+
+  NSAssert1(CGRectGetWidth(bounds), @"Zero width for layer %@", layer);
+  NSAssert1(CGRectGetHeight(bounds), @"Zero height for layer %@", layer);
+
+  UIGraphicsBeginImageContextWithOptions(bounds.size, NO, 0);
+  CGContextRef context = UIGraphicsGetCurrentContext();
+  NSAssert1(context, @"Could not generate context for layer %@", layer);
+  
+  CGContextSaveGState(context);
+  {
+    [layer renderInContext:context];
+  }
+  CGContextRestoreGState(context);
+  
+  UIImage *snapshot = UIGraphicsGetImageFromCurrentImageContext();
+  UIGraphicsEndImageContext();
+  
+  return snapshot;
+}
+        
+- (UIImage *)_renderView:(UIView *)view
+{
+  if (!self.renderAsLayer) {
+#ifdef __IPHONE_7_0
+    if ([view respondsToSelector:@selector(drawViewHierarchyInRect:afterScreenUpdates:)]) {
+      UIGraphicsBeginImageContextWithOptions(view.frame.size, NO, 0);
+      [view drawViewHierarchyInRect:view.bounds afterScreenUpdates:YES];
+      UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+      UIGraphicsEndImageContext();
+      return image;
+    }
+#else
+    NSLog(@"drawViewHierarchy is only available on iOS 7+");
+#endif
+  }
+  [view layoutIfNeeded];
+  return [self _renderLayer:view.layer];
+}
+
+@end
@@ -30,8 +30,34 @@
 
 #import <UIKit/UIKit.h>
 
+#import "FBImageCompare.h"
+
+/**
+ @returns A buffer describing the pixels returned by -[UIImage fb_RGBAPixels]. Valid as long as `pixels` is.
+ */
+extern FBImageBuffer FBImageBufferWithPixels(UIImage *image, NSData *pixels);
+
 @interface UIImage (Compare)
 
+/**
+ Draws the image into a new buffer of 8-bit premultiplied RGBA pixels, one row after another with no padding.
+ The buffer is as wide and as tall as the image's CGImage.
+ @returns The pixels, or nil if they could not be drawn.
+ */
+- (NSData *)fb_RGBAPixels;
+
+/**
+ @returns YES if every pixel of both images is exactly the same.
+ */
 - (BOOL)compareWithImage:(UIImage *)image;
 
+/**
+ Compares the pixels of both images with the given tolerance, stopping early once too many pixels differ.
+ @param image The image to compare against. Must be the same size.
+ @param options How different the images may be and still count as the same.
+ @param result If not NULL, set to a description of how the images differ.
+ @returns YES if the images count as the same.
+ */
+- (BOOL)compareWithImage:(UIImage *)image options:(FBImageCompareOptions)options result:(FBImageCompareResult *)result;
+
 @end
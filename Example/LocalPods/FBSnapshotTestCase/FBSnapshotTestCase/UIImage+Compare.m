@@ -0,0 +1,99 @@
+//
+//  Created by Gabriel Handford on 3/1/09.
+//  Copyright 2009-2013. All rights reserved.
+//  Created by John Boiles on 10/20/11.
+//  Copyright (c) 2011. All rights reserved
+//  Modified by Felix Schulze on 2/11/13.
+//  Copyright 2013. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import "UIImage+Compare.h"
+
+FBImageBuffer FBImageBufferWithPixels(UIImage *image, NSData *pixels)
+{
+  size_t width = CGImageGetWidth(image.CGImage);
+  return (FBImageBuffer){ pixels.bytes, width, CGImageGetHeight(image.CGImage), width * 4 };
+}
+
+@implementation UIImage (Compare)
+
+- (NSData *)fb_RGBAPixels
+{
+  CGImageRef imageRef = self.CGImage;
+  size_t width = CGImageGetWidth(imageRef);
+  size_t height = CGImageGetHeight(imageRef);
+  size_t bytesPerRow = width * 4;
+
+  NSMutableData *pixels = [NSMutableData dataWithLength:bytesPerRow * height];
+  if (!pixels) {
+    return nil;
+  }
+
+  // Always draw into the same format, so that images from different sources can be compared byte for byte
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(pixels.mutableBytes,
+                                               width,
+                                               height,
+                                               8,
+                                               bytesPerRow,
+                                               colorSpace,
+                                               (CGBitmapInfo)kCGImageAlphaPremultipliedLast
+                                               );
+  CGColorSpaceRelease(colorSpace);
+
+  if (!context) {
+    return nil;
+  }
+
+  CGContextDrawImage(context, CGRectMake(0.0f, 0.0f, width, height), imageRef);
+  CGContextRelease(context);
+  return pixels;
+}
+
+- (BOOL)compareWithImage:(UIImage *)image
+{
+  return [self compareWithImage:image options:FBImageCompareOptionsExact result:NULL];
+}
+
+- (BOOL)compareWithImage:(UIImage *)image options:(FBImageCompareOptions)options result:(FBImageCompareResult *)resultPtr
+{
+  NSAssert(CGSizeEqualToSize(self.size, image.size), @"Images must be same size.");
+
+  NSData *referencePixels = [self fb_RGBAPixels];
+  NSData *imagePixels = [image fb_RGBAPixels];
+  if (!referencePixels || !imagePixels) {
+    return NO;
+  }
+
+  FBImageCompareResult result = FBImageCompareBuffers(FBImageBufferWithPixels(self, referencePixels),
+                                                     FBImageBufferWithPixels(image, imagePixels),
+                                                     options,
+                                                     true);
+  if (NULL != resultPtr) {
+    *resultPtr = result;
+  }
+  return result.passed;
+}
+
+@end
@@ -34,4 +34,9 @@
 
 - (UIImage *)diffWithImage:(UIImage *)image;
 
+/**
+ @returns An image of packed 8-bit RGBA pixels, such as the heatmap of an FBImageDiff.
+ */
++ (UIImage *)fb_imageWithRGBAPixels:(const uint8_t *)pixels width:(size_t)width height:(size_t)height scale:(CGFloat)scale;
+
 @end
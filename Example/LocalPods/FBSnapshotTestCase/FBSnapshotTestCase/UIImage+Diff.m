@@ -53,4 +53,28 @@
   return returnImage;
 }
 
++ (UIImage *)fb_imageWithRGBAPixels:(const uint8_t *)pixels width:(size_t)width height:(size_t)height scale:(CGFloat)scale
+{
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate((void *)pixels,
+                                               width,
+                                               height,
+                                               8,
+                                               width * 4,
+                                               colorSpace,
+                                               (CGBitmapInfo)kCGImageAlphaPremultipliedLast
+                                               );
+  CGColorSpaceRelease(colorSpace);
+  if (!context) {
+    return nil;
+  }
+
+  // Copies the pixels, so the image outlives them
+  CGImageRef imageRef = CGBitmapContextCreateImage(context);
+  CGContextRelease(context);
+  UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+  CGImageRelease(imageRef);
+  return image;
+}
+
 @end
@@ -0,0 +1,543 @@
+/*
+ *  Copyright (c) 2013, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ Tests of the C core of FBSnapshotTestCase: the comparison kernel, the diff, and the reference image store. They
+ need neither UIKit nor XCTest, so they build and run anywhere with a C11 compiler:
+
+   cc -std=c11 -pedantic -Wall -Wextra -fsanitize=address,undefined -IFBSnapshotTestCase \
+       Tests/FBSnapshotCoreTests.c FBSnapshotTestCase/FBImageCompare.c FBSnapshotTestCase/FBImageDiff.c \
+       FBSnapshotTestCase/FBReferenceImageStore.c -o fbsnapshot-core-tests && ./fbsnapshot-core-tests
+ */
+
+// mkdtemp and truncate
+#define _POSIX_C_SOURCE 200809L
+
+#include "FBImageCompare.h"
+#include "FBImageDiff.h"
+#include "FBReferenceImageStore.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int FBFailureCount = 0;
+
+#define FB_EXPECT(condition__) \
+  do { \
+    if (!(condition__)) { \
+      fprintf(stderr, "%s:%d: %s: expected %s\n", __FILE__, __LINE__, __func__, #condition__); \
+      FBFailureCount++; \
+    } \
+  } while (0)
+
+/* Images */
+
+/** A solid gray image, optionally with padding at the end of each row. */
+typedef struct FBTestImage {
+  uint8_t *pixels;
+  FBImageBuffer buffer;
+} FBTestImage;
+
+static FBTestImage FBTestImageCreate(size_t width, size_t height, size_t padding)
+{
+  size_t bytesPerRow = width * 4 + padding;
+  uint8_t *pixels = malloc(bytesPerRow * height + 1);
+  memset(pixels, 0x80, bytesPerRow * height + 1);
+  // Padding holds garbage, which nothing may look at
+  for (size_t y = 0; y < height; y++) {
+    memset(pixels + y * bytesPerRow + width * 4, (int)(0xA5 + y), padding);
+  }
+  return (FBTestImage){ pixels, { pixels, width, height, bytesPerRow } };
+}
+
+static FBTestImage FBTestImageCopy(FBTestImage image)
+{
+  FBTestImage copy = FBTestImageCreate(image.buffer.width, image.buffer.height, image.buffer.bytesPerRow - image.buffer.width * 4);
+  memcpy(copy.pixels, image.pixels, image.buffer.bytesPerRow * image.buffer.height);
+  return copy;
+}
+
+static uint8_t *FBTestPixel(FBTestImage image, size_t x, size_t y)
+{
+  return image.pixels + y * image.buffer.bytesPerRow + x * 4;
+}
+
+static void FBTestImageFree(FBTestImage image)
+{
+  free(image.pixels);
+}
+
+static FBImageCompareOptions FBTestOptions(uint8_t tolerance, size_t maxPixels, double maxFraction)
+{
+  return (FBImageCompareOptions){ tolerance, maxPixels, maxFraction };
+}
+
+/* Hash */
+
+static void FBTestHashIgnoresPadding(void)
+{
+  FBTestImage packed = FBTestImageCreate(13, 7, 0);
+  FBTestImage padded = FBTestImageCreate(13, 7, 12);
+  FB_EXPECT(FBImageBufferHash(packed.buffer) == FBImageBufferHash(padded.buffer));
+  FBTestImageFree(packed);
+  FBTestImageFree(padded);
+}
+
+static void FBTestHashSeesEveryPixel(void)
+{
+  // 13 pixels is 52 bytes a row: one full 32-byte round, then the tail
+  FBTestImage image = FBTestImageCreate(13, 7, 4);
+  uint64_t original = FBImageBufferHash(image.buffer);
+
+  FBTestPixel(image, 2, 3)[1] ^= 1;
+  FB_EXPECT(FBImageBufferHash(image.buffer) != original);
+  FBTestPixel(image, 2, 3)[1] ^= 1;
+  FB_EXPECT(FBImageBufferHash(image.buffer) == original);
+
+  FBTestPixel(image, 12, 6)[3] ^= 1;
+  FB_EXPECT(FBImageBufferHash(image.buffer) != original);
+  FBTestImageFree(image);
+}
+
+static void FBTestHashIncludesSize(void)
+{
+  FBTestImage image = FBTestImageCreate(4, 4, 0);
+  FBImageBuffer reshaped = { image.pixels, 2, 8, 8 };
+  FB_EXPECT(FBImageBufferHash(image.buffer) != FBImageBufferHash(reshaped));
+
+  FBReferenceEntry a = FBReferenceEntryMake(image.buffer), b = FBReferenceEntryMake(reshaped);
+  FB_EXPECT(!FBReferenceEntryEqual(a, b));
+  FB_EXPECT(FBReferenceEntryEqual(a, FBReferenceEntryMake(image.buffer)));
+  FB_EXPECT(a.width == 4 && a.height == 4 && a.fileSize == 0);
+  FBTestImageFree(image);
+}
+
+/* Files */
+
+static char FBTestDirectory[] = "/tmp/fbsnapshot-core-tests-XXXXXX";
+
+static const char *FBTestPath(const char *name)
+{
+  static char path[4][512];
+  static int next = 0;
+  char *result = path[next++ % 4];
+  snprintf(result, sizeof(path[0]), "%s/%s", FBTestDirectory, name);
+  return result;
+}
+
+static void FBTestWriteFile(const char *path, const char *contents)
+{
+  FILE *file = fopen(path, "w");
+  fputs(contents, file);
+  fclose(file);
+}
+
+static void FBTestReferenceEntryMatchesFile(void)
+{
+  const char *path = FBTestPath("reference.png");
+  FBTestWriteFile(path, "not really a PNG");
+
+  FBTestImage image = FBTestImageCreate(3, 3, 0);
+  FBReferenceEntry entry = FBReferenceEntryMake(image.buffer);
+  FB_EXPECT(!FBReferenceEntryMatchesFile(entry, path));
+  FB_EXPECT(FBReferenceEntrySetFile(&entry, path));
+  FB_EXPECT(entry.fileSize == strlen("not really a PNG"));
+  FB_EXPECT(FBReferenceEntryMatchesFile(entry, path));
+
+  // Same size, different bytes
+  FBTestWriteFile(path, "not really a PNh");
+  FB_EXPECT(!FBReferenceEntryMatchesFile(entry, path));
+  FBTestWriteFile(path, "not really a PNG, longer");
+  FB_EXPECT(!FBReferenceEntryMatchesFile(entry, path));
+
+  unlink(path);
+  FB_EXPECT(!FBReferenceEntryMatchesFile(entry, path));
+  FB_EXPECT(!FBReferenceEntrySetFile(&entry, path));
+  FBTestImageFree(image);
+}
+
+/* Index */
+
+static FBReferenceEntry FBTestEntry(uint64_t hash, uint32_t width, uint32_t height, uint64_t fileSize, uint64_t fileHash)
+{
+  return (FBReferenceEntry){ hash, width, height, fileSize, fileHash };
+}
+
+static bool FBTestEntriesIdentical(FBReferenceEntry a, FBReferenceEntry b)
+{
+  return FBReferenceEntryEqual(a, b) && a.fileSize == b.fileSize && a.fileHash == b.fileHash;
+}
+
+static void FBTestIndexSetAndLookup(void)
+{
+  FBReferenceIndex *index = FBReferenceIndexCreate();
+  FBReferenceEntry entry;
+  FB_EXPECT(!FBReferenceIndexLookup(index, "a.png", &entry));
+
+  // Enough to grow the records more than once, out of order
+  char name[32];
+  for (int i = 199; i >= 0; i--) {
+    snprintf(name, sizeof(name), "test_%03d@2x.png", i);
+    FB_EXPECT(FBReferenceIndexSet(index, name, FBTestEntry((uint64_t)i, 1, 2, 3, 4)));
+  }
+  FB_EXPECT(FBReferenceIndexCount(index) == 200);
+  FB_EXPECT(FBReferenceIndexLookup(index, "test_042@2x.png", &entry) && entry.hash == 42);
+  FB_EXPECT(!FBReferenceIndexLookup(index, "test_042.png", NULL));
+
+  FB_EXPECT(FBReferenceIndexSet(index, "test_042@2x.png", FBTestEntry(7, 8, 9, 10, 11)));
+  FB_EXPECT(FBReferenceIndexCount(index) == 200);
+  FB_EXPECT(FBReferenceIndexLookup(index, "test_042@2x.png", &entry));
+  FB_EXPECT(FBTestEntriesIdentical(entry, FBTestEntry(7, 8, 9, 10, 11)));
+  FBReferenceIndexFree(index);
+}
+
+static void FBTestIndexRoundTrip(void)
+{
+  const char *path = FBTestPath("index.txt");
+  FBReferenceIndex *index = FBReferenceIndexCreate();
+  FBReferenceIndexSet(index, "testB_with spaces@2x.png", FBTestEntry(0xFFFFFFFFFFFFFFFFULL, 320, 480, 12345, 0x0123456789ABCDEFULL));
+  FBReferenceIndexSet(index, "testA.png", FBTestEntry(1, 1, 1, 1, 1));
+  FB_EXPECT(FBReferenceIndexSave(index, path));
+  FBReferenceIndexFree(index);
+
+  index = FBReferenceIndexLoad(path);
+  FB_EXPECT(index != NULL);
+  if (index) {
+    FBReferenceEntry entry;
+    FB_EXPECT(FBReferenceIndexCount(index) == 2);
+    FB_EXPECT(FBReferenceIndexLookup(index, "testB_with spaces@2x.png", &entry));
+    FB_EXPECT(FBTestEntriesIdentical(entry, FBTestEntry(0xFFFFFFFFFFFFFFFFULL, 320, 480, 12345, 0x0123456789ABCDEFULL)));
+    FB_EXPECT(FBReferenceIndexLookup(index, "testA.png", &entry));
+    FB_EXPECT(FBTestEntriesIdentical(entry, FBTestEntry(1, 1, 1, 1, 1)));
+    FBReferenceIndexFree(index);
+  }
+
+  // Sorted by name, so that diffs stay small
+  FILE *file = fopen(path, "r");
+  char header[128], first[256];
+  FB_EXPECT(fgets(header, sizeof(header), file) && header[0] == '#');
+  FB_EXPECT(fgets(first, sizeof(first), file) && strstr(first, " testA.png\n"));
+  fclose(file);
+  unlink(path);
+}
+
+static void FBTestIndexLoadsMissingFileAsEmpty(void)
+{
+  FBReferenceIndex *index = FBReferenceIndexLoad(FBTestPath("missing.txt"));
+  FB_EXPECT(index != NULL && FBReferenceIndexCount(index) == 0);
+  FBReferenceIndexFree(index);
+}
+
+static void FBTestIndexLoadsVersion1(void)
+{
+  const char *path = FBTestPath("index-v1.txt");
+  FBTestWriteFile(path, "# FBSnapshotTestCase reference image index v1\n"
+                        "00000000000000ff 10 20 testA.png\n"
+                        "0000000000000001 1 1 12 34.png");
+  FBReferenceIndex *index = FBReferenceIndexLoad(path);
+  FB_EXPECT(index != NULL);
+  if (index) {
+    FBReferenceEntry entry;
+    FB_EXPECT(FBReferenceIndexLookup(index, "testA.png", &entry));
+    FB_EXPECT(FBTestEntriesIdentical(entry, FBTestEntry(0xff, 10, 20, 0, 0)));
+    // A name that looks like more numbers, on a last line without a newline
+    FB_EXPECT(FBReferenceIndexLookup(index, "12 34.png", &entry) && entry.hash == 1);
+    FBReferenceIndexFree(index);
+  }
+  unlink(path);
+}
+
+static void FBTestIndexRejectsMalformedFiles(void)
+{
+  const char *malformed[] = {
+    "00000000000000ff 10 20 1 2\n",                   // No name
+    "00000000000000ff 10 20 testA.png\n",             // Version 1 line in a version 2 index
+    "zzzz 10 20 1 2 testA.png\n",                     // Not a hash
+    "# FBSnapshotTestCase reference image index v1\n"
+    "00000000000000ff ten 20 testA.png\n",            // Not a size
+  };
+  const char *path = FBTestPath("malformed.txt");
+  for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+    FBTestWriteFile(path, malformed[i]);
+    FBReferenceIndex *index = FBReferenceIndexLoad(path);
+    if (index) {
+      fprintf(stderr, "  loaded malformed index %zu\n", i);
+    }
+    FB_EXPECT(index == NULL);
+    FBReferenceIndexFree(index);
+  }
+
+  // A line too long for the reader, which isn't the last
+  FILE *file = fopen(path, "w");
+  fputs("00000000000000ff 1 1 1 1 ", file);
+  for (int i = 0; i < 5000; i++) {
+    fputc('x', file);
+  }
+  fputs(".png\n00000000000000ff 1 1 1 1 b.png\n", file);
+  fclose(file);
+  FB_EXPECT(FBReferenceIndexLoad(path) == NULL);
+  unlink(path);
+}
+
+/* Raw image cache */
+
+static void FBTestRawImageRoundTrip(void)
+{
+  const char *path = FBTestPath("image.rgba");
+  FBTestImage image = FBTestImageCreate(5, 3, 8);
+  FBTestPixel(image, 4, 2)[0] = 7;
+  FB_EXPECT(FBRawImageWrite(path, image.buffer));
+
+  FBMappedImage mapped;
+  FB_EXPECT(FBRawImageMap(path, &mapped));
+  FB_EXPECT(mapped.buffer.width == 5 && mapped.buffer.height == 3 && mapped.buffer.bytesPerRow == 20);
+  FB_EXPECT(FBImageBufferHash(mapped.buffer) == FBImageBufferHash(image.buffer));
+  FBRawImageUnmap(&mapped);
+  FB_EXPECT(mapped.mapping == NULL);
+
+  // Truncated
+  FB_EXPECT(truncate(path, 16 + 5 * 4 * 3 - 1) == 0);
+  FB_EXPECT(!FBRawImageMap(path, &mapped));
+  FB_EXPECT(truncate(path, 4) == 0);
+  FB_EXPECT(!FBRawImageMap(path, &mapped));
+
+  FBTestWriteFile(path, "NOTRGBA1xxxxxxxx");
+  FB_EXPECT(!FBRawImageMap(path, &mapped));
+  unlink(path);
+  FB_EXPECT(!FBRawImageMap(path, &mapped));
+  FBTestImageFree(image);
+}
+
+/* Compare */
+
+static void FBTestCompareIdentical(void)
+{
+  FBTestImage a = FBTestImageCreate(37, 11, 0), b = FBTestImageCreate(37, 11, 20);
+  FBImageCompareResult result = FBImageCompareBuffers(a.buffer, b.buffer, FBImageCompareOptionsExact, true);
+  FB_EXPECT(result.passed && !result.stoppedEarly);
+  FB_EXPECT(result.differingPixelCount == 0 && result.maxChannelDelta == 0);
+  FB_EXPECT(result.differingBounds.width == 0 && result.differingBounds.height == 0);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestCompareTolerance(void)
+{
+  FBTestImage a = FBTestImageCreate(8, 2, 0), b = FBTestImageCopy(a);
+  FBTestPixel(b, 1, 0)[2] += 3;
+  FBTestPixel(b, 6, 1)[0] -= 2;
+
+  FBImageCompareResult result = FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(3, 0, 0), false);
+  FB_EXPECT(result.passed && result.differingPixelCount == 0);
+  FB_EXPECT(result.maxChannelDelta == 3);
+
+  result = FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(2, 0, 0), false);
+  FB_EXPECT(!result.passed && result.differingPixelCount == 1);
+  result = FBImageCompareBuffers(a.buffer, b.buffer, FBImageCompareOptionsExact, false);
+  FB_EXPECT(!result.passed && result.differingPixelCount == 2);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestComparePixelBudget(void)
+{
+  FBTestImage a = FBTestImageCreate(10, 10, 0), b = FBTestImageCopy(a);
+  FBTestPixel(b, 0, 0)[0] = 0;
+  FBTestPixel(b, 9, 9)[0] = 0;
+
+  FB_EXPECT(FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 2, 0), true).passed);
+  FB_EXPECT(!FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 1, 0), true).passed);
+
+  // The larger of the two budgets wins: 2% of 100 pixels is 2
+  FB_EXPECT(FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 1, 0.02), true).passed);
+  FB_EXPECT(FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 2, 0.01), true).passed);
+  FB_EXPECT(!FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 0, 0.01), true).passed);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestCompareBounds(void)
+{
+  // 21 pixels wide: five full vectors and a tail pixel; the padding differs but doesn't count
+  FBTestImage a = FBTestImageCreate(21, 9, 12), b = FBTestImageCreate(21, 9, 4);
+  FBTestPixel(b, 3, 1)[1] = 0;
+  FBTestPixel(b, 20, 5)[3] = 0;
+  FBTestPixel(b, 7, 8)[0] = 0;
+
+  FBImageCompareResult result = FBImageCompareBuffers(a.buffer, b.buffer, FBImageCompareOptionsExact, false);
+  FB_EXPECT(result.differingPixelCount == 3);
+  FB_EXPECT(result.maxChannelDelta == 0x80);
+  FB_EXPECT(result.differingBounds.x == 3 && result.differingBounds.y == 1);
+  FB_EXPECT(result.differingBounds.width == 18 && result.differingBounds.height == 8);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestCompareStopsEarly(void)
+{
+  // Tall enough for several bands of rows, each with a differing pixel
+  FBTestImage a = FBTestImageCreate(16, 512, 0), b = FBTestImageCopy(a);
+  for (size_t y = 0; y < 512; y++) {
+    FBTestPixel(b, y % 16, y)[0] = 0;
+  }
+
+  FBImageCompareResult full = FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 10, 0), false);
+  FB_EXPECT(!full.passed && !full.stoppedEarly && full.differingPixelCount == 512);
+  FB_EXPECT(full.differingBounds.height == 512);
+
+  FBImageCompareResult early = FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 10, 0), true);
+  FB_EXPECT(!early.passed && early.stoppedEarly);
+  FB_EXPECT(early.differingPixelCount > 10 && early.differingPixelCount < 512);
+
+  // Within budget, stopping early changes nothing
+  FBImageCompareResult within = FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(0, 512, 0), true);
+  FB_EXPECT(within.passed && !within.stoppedEarly && within.differingPixelCount == 512);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestCompareRejectsDifferentSizes(void)
+{
+  FBTestImage a = FBTestImageCreate(4, 4, 0), b = FBTestImageCreate(4, 5, 0);
+  FB_EXPECT(!FBImageCompareBuffers(a.buffer, b.buffer, FBTestOptions(255, 1000, 1), false).passed);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+/* Diff */
+
+static void FBTestDiffTilesAndRegions(void)
+{
+  // 70 × 40 in tiles of 32: three across, the last 6 wide, and two down, the last 8 tall
+  FBTestImage a = FBTestImageCreate(70, 40, 8), b = FBTestImageCopy(a);
+  FBTestPixel(b, 1, 1)[0] = 0x80 + 10;
+  FBTestPixel(b, 5, 2)[0] = 0x80 - 100;
+  FBTestPixel(b, 68, 39)[2] = 0;
+  // Within tolerance: counted in deltas, but not as differing
+  FBTestPixel(b, 40, 10)[1] = 0x80 + 2;
+
+  FBImageDiff diff;
+  FB_EXPECT(FBImageDiffCreate(a.buffer, b.buffer, 2, 32, &diff));
+  FB_EXPECT(diff.width == 70 && diff.height == 40);
+  FB_EXPECT(diff.tilesAcross == 3 && diff.tilesDown == 2);
+  FB_EXPECT(diff.tiles[2].frame.x == 64 && diff.tiles[2].frame.width == 6);
+  FB_EXPECT(diff.tiles[5].frame.y == 32 && diff.tiles[5].frame.height == 8);
+
+  FB_EXPECT(diff.differingPixelCount == 3);
+  FB_EXPECT(diff.maxChannelDelta == 0x80);
+  FB_EXPECT(diff.tiles[0].differingPixelCount == 2 && diff.tiles[0].maxChannelDelta == 100);
+  FB_EXPECT(diff.tiles[0].differingBounds.x == 1 && diff.tiles[0].differingBounds.y == 1);
+  FB_EXPECT(diff.tiles[0].differingBounds.width == 5 && diff.tiles[0].differingBounds.height == 2);
+  FB_EXPECT(diff.tiles[0].meanDelta > 0.1 && diff.tiles[0].meanDelta < 0.11);
+  FB_EXPECT(diff.tiles[1].differingPixelCount == 0 && diff.tiles[1].maxChannelDelta == 2);
+  FB_EXPECT(diff.tiles[5].differingPixelCount == 1);
+
+  // The two changed tiles don't touch
+  FB_EXPECT(diff.regionCount == 2);
+  if (diff.regionCount == 2) {
+    FB_EXPECT(diff.regions[0].differingPixelCount == 2 && diff.regions[0].bounds.x == 1);
+    FB_EXPECT(diff.regions[1].differingPixelCount == 1);
+    FB_EXPECT(diff.regions[1].bounds.x == 68 && diff.regions[1].bounds.y == 39);
+    FB_EXPECT(diff.regions[1].bounds.width == 1 && diff.regions[1].bounds.height == 1);
+  }
+
+  // Changed pixels are red, the rest a faded gray
+  const uint8_t *changed = diff.heatmap + (2 * 70 + 5) * 4, *unchanged = diff.heatmap + (10 * 70 + 40) * 4;
+  FB_EXPECT(changed[0] == 128 + 50 && changed[1] == 0 && changed[2] == 0 && changed[3] == 255);
+  FB_EXPECT(unchanged[0] == unchanged[1] && unchanged[1] == unchanged[2] && unchanged[0] >= 192);
+  FBImageDiffFree(&diff);
+  FB_EXPECT(diff.heatmap == NULL && diff.regionCount == 0);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestDiffMergesDiagonalTiles(void)
+{
+  FBTestImage a = FBTestImageCreate(64, 64, 0), b = FBTestImageCopy(a);
+  FBTestPixel(b, 31, 31)[0] = 0;
+  FBTestPixel(b, 32, 32)[0] = 0;
+
+  FBImageDiff diff;
+  FB_EXPECT(FBImageDiffCreate(a.buffer, b.buffer, 0, 32, &diff));
+  FB_EXPECT(diff.regionCount == 1);
+  if (diff.regionCount == 1) {
+    FBPixelRect bounds = diff.regions[0].bounds;
+    FB_EXPECT(diff.regions[0].differingPixelCount == 2);
+    FB_EXPECT(bounds.x == 31 && bounds.y == 31 && bounds.width == 2 && bounds.height == 2);
+  }
+  FBImageDiffFree(&diff);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+static void FBTestDiffRejectsBadInput(void)
+{
+  FBTestImage a = FBTestImageCreate(4, 4, 0), b = FBTestImageCreate(5, 4, 0);
+  FBImageDiff diff;
+  FB_EXPECT(!FBImageDiffCreate(a.buffer, b.buffer, 0, 32, &diff));
+  FB_EXPECT(!FBImageDiffCreate(a.buffer, a.buffer, 0, 0, &diff));
+
+  // An empty image diffs to nothing
+  FBImageBuffer empty = { a.pixels, 0, 0, 0 };
+  FB_EXPECT(FBImageDiffCreate(empty, empty, 0, 32, &diff));
+  FB_EXPECT(diff.regionCount == 0 && diff.differingPixelCount == 0);
+  FBImageDiffFree(&diff);
+  FBTestImageFree(a);
+  FBTestImageFree(b);
+}
+
+int main(void)
+{
+  if (!mkdtemp(FBTestDirectory)) {
+    perror("mkdtemp");
+    return 1;
+  }
+
+  static const struct {
+    const char *name;
+    void (*run)(void);
+  } tests[] = {
+    { "hash ignores padding", FBTestHashIgnoresPadding },
+    { "hash sees every pixel", FBTestHashSeesEveryPixel },
+    { "hash includes size", FBTestHashIncludesSize },
+    { "reference entry matches file", FBTestReferenceEntryMatchesFile },
+    { "index set and lookup", FBTestIndexSetAndLookup },
+    { "index round trip", FBTestIndexRoundTrip },
+    { "index loads missing file as empty", FBTestIndexLoadsMissingFileAsEmpty },
+    { "index loads version 1", FBTestIndexLoadsVersion1 },
+    { "index rejects malformed files", FBTestIndexRejectsMalformedFiles },
+    { "raw image round trip", FBTestRawImageRoundTrip },
+    { "compare identical", FBTestCompareIdentical },
+    { "compare tolerance", FBTestCompareTolerance },
+    { "compare pixel budget", FBTestComparePixelBudget },
+    { "compare bounds", FBTestCompareBounds },
+    { "compare stops early", FBTestCompareStopsEarly },
+    { "compare rejects different sizes", FBTestCompareRejectsDifferentSizes },
+    { "diff tiles and regions", FBTestDiffTilesAndRegions },
+    { "diff merges diagonal tiles", FBTestDiffMergesDiagonalTiles },
+    { "diff rejects bad input", FBTestDiffRejectsBadInput },
+  };
+
+  // Every test runs, even after a failure
+  size_t failedTests = 0;
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+    int failuresBefore = FBFailureCount;
+    tests[i].run();
+    bool passed = FBFailureCount == failuresBefore;
+    failedTests += !passed;
+    printf("%s: %s\n", passed ? "PASS" : "FAIL", tests[i].name);
+  }
+
+  rmdir(FBTestDirectory);
+  printf("%zu of %zu tests failed\n", failedTests, sizeof(tests) / sizeof(tests[0]));
+  return failedTests ? 1 : 0;
+}
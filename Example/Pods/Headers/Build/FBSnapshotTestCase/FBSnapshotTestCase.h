@@ -1 +1 @@
-../../../FBSnapshotTestCase/FBSnapshotTestCase.h
\ No newline at end of file
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/FBSnapshotTestCase.h
\ No newline at end of file
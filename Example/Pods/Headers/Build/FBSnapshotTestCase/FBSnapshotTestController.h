@@ -1 +1 @@
-../../../FBSnapshotTestCase/FBSnapshotTestController.h
\ No newline at end of file
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/FBSnapshotTestController.h
\ No newline at end of file
@@ -1 +1 @@
-../../../FBSnapshotTestCase/UIImage+Compare.h
\ No newline at end of file
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/UIImage+Compare.h
\ No newline at end of file
@@ -1 +1 @@
-../../../FBSnapshotTestCase/UIImage+Diff.h
\ No newline at end of file
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/UIImage+Diff.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/FBImageCompare.h
\ No newline at end of file
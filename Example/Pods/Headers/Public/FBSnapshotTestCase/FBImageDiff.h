@@ -0,0 +1 @@
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/FBImageDiff.h
\ No newline at end of file
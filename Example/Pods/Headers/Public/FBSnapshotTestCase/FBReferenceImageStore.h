@@ -0,0 +1 @@
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/FBReferenceImageStore.h
\ No newline at end of file
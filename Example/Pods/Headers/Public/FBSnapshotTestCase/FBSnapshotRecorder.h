@@ -0,0 +1 @@
+../../../../LocalPods/FBSnapshotTestCase/FBSnapshotTestCase/FBSnapshotRecorder.h
\ No newline at end of file
@@ -246,16 +246,14 @@
 - (TBAlertController *)modifiedAlert:(TBAlertController *)alert {
     if (self.usesDestructiveButton)
         alert.destructiveButtonIndex = self.destructiveIndex;
-    if (self.willDismissProgrammaticallyAfterDelay)
-        [self performSelector:@selector(dismissAlert:) withObject:alert afterDelay:2];
+    if (self.willDismissProgrammaticallyAfterDelay) {
+        alert.deadline = 2;
+        alert.deadlineButtonIndex = (NSInteger)self.dismissIndex < 0 ? NSNotFound : self.dismissIndex;
+    }
     
     return alert;
 }
 
-- (void)dismissAlert:(TBAlertController *)alert {
-    [alert dismissWithButtonIndex:self.dismissIndex];
-}
-
 - (void)log {
     [self log:@"Target-action success!"];
 }
@@ -4,15 +4,42 @@ import PackageDescription
 let package = Package(
     name: "TBAlertController",
     platforms: [
-        .iOS(.v9)
+        .iOS(.v9),
+        .macOS(.v10_13)
     ],
     products: [
-        .library(name: "TBAlertController", targets: ["TBAlertController"])
+        .library(name: "TBAlertController", targets: ["TBAlertController"]),
+        .executable(name: "tbalert-bench", targets: ["TBAlertBenchmarks"]),
+        .executable(name: "tbalert-catalog", targets: ["TBAlertCatalogCompiler"])
     ],
     targets: [
         .target(
             name: "TBAlertController",
             path: "Classes"
+        ),
+        .target(
+            name: "TBAlertBenchmarks",
+            dependencies: ["TBAlertController", "TBAlertTestSupport"],
+            path: "Benchmarks",
+            cSettings: [.headerSearchPath("../Classes"), .headerSearchPath("../Tests/TBAlertTestSupport")]
+        ),
+        .target(
+            name: "TBAlertCatalogCompiler",
+            dependencies: ["TBAlertController"],
+            path: "Tools/CatalogCompiler",
+            cSettings: [.headerSearchPath("../../Classes")]
+        ),
+        .target(
+            name: "TBAlertTestSupport",
+            dependencies: ["TBAlertController"],
+            path: "Tests/TBAlertTestSupport",
+            cSettings: [.headerSearchPath("../../Classes")]
+        ),
+        .testTarget(
+            name: "TBAlertControllerTests",
+            dependencies: ["TBAlertController", "TBAlertTestSupport"],
+            path: "Tests/TBAlertControllerTests",
+            cSettings: [.headerSearchPath("../../Classes"), .headerSearchPath("../TBAlertTestSupport")]
         )
     ]
 )
@@ -0,0 +1,226 @@
+//
+//  TBAlertActionTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <objc/runtime.h>
+#import "TBAlertAction.h"
+
+/** Records every call made to it, as strings. */
+@interface TBActionTestTarget : NSObject
+@property (nonatomic) NSMutableArray<NSString *> *calls;
+@property (nonatomic) NSInteger observed;
+@end
+
+@implementation TBActionTestTarget
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _calls = [NSMutableArray new];
+    }
+
+    return self;
+}
+
+- (void)fire {
+    [self.calls addObject:@"fire"];
+}
+
+- (void)fireWithObject:(id)object {
+    [self.calls addObject:[NSString stringWithFormat:@"object %@", object]];
+}
+
+- (void)recordInt:(int)i double:(double)d flag:(BOOL)flag object:(id)object range:(NSRange)range {
+    [self.calls addObject:[NSString stringWithFormat:@"%d %g %d %@ %@",
+        i, d, (int)flag, object ?: @"nil", NSStringFromRange(range)
+    ]];
+}
+
+@end
+
+/** Overrides \c fire, to be swapped in under an existing target. */
+@interface TBActionTestSubtarget : TBActionTestTarget
+@end
+
+@implementation TBActionTestSubtarget
+
+- (void)fire {
+    [self.calls addObject:@"subclass fire"];
+}
+
+@end
+
+/** Counts assertion failures instead of raising, so release-build fallbacks can be tested in debug builds too. */
+@interface TBCountingAssertionHandler : NSAssertionHandler
+@property (nonatomic) NSUInteger failures;
+@end
+
+@implementation TBCountingAssertionHandler
+
+- (void)handleFailureInMethod:(SEL)selector object:(id)object file:(NSString *)fileName
+                   lineNumber:(NSInteger)line description:(NSString *)format, ... {
+    self.failures++;
+}
+
+- (void)handleFailureInFunction:(NSString *)functionName file:(NSString *)fileName
+                     lineNumber:(NSInteger)line description:(NSString *)format, ... {
+    self.failures++;
+}
+
+@end
+
+@interface TBAlertActionTests : XCTestCase
+@property (nonatomic) TBActionTestTarget *target;
+@end
+
+@implementation TBAlertActionTests
+
+- (void)setUp {
+    [super setUp];
+    self.target = [TBActionTestTarget new];
+}
+
+- (void)tearDown {
+    [NSThread.currentThread.threadDictionary removeObjectForKey:NSAssertionHandlerKey];
+    [super tearDown];
+}
+
+#pragma mark - Cluster
+
+- (void)testEachInitializerPerformsItsStyle {
+    __block NSArray *received = nil;
+    TBAlertAction *none = [[TBAlertAction alloc] initWithTitle:@"None"];
+    TBAlertAction *block = [[TBAlertAction alloc] initWithTitle:@"Block" block:^(NSArray *strings) {
+        received = strings;
+    }];
+    TBAlertAction *target = [[TBAlertAction alloc] initWithTitle:@"Target" target:self.target action:@selector(fire)];
+    TBAlertAction *object = [[TBAlertAction alloc]
+        initWithTitle:@"Object" target:self.target action:@selector(fireWithObject:) object:@42
+    ];
+
+    XCTAssertEqual(none.style, TBAlertActionStyleNoAction);
+    XCTAssertEqual(block.style, TBAlertActionStyleBlock);
+    XCTAssertEqual(target.style, TBAlertActionStyleTarget);
+    XCTAssertEqual(object.style, TBAlertActionStyleTargetObject);
+    XCTAssertEqualObjects(object.object, @42);
+    XCTAssertEqual(target.target, self.target);
+    XCTAssertEqual(target.action, @selector(fire));
+
+    [none perform:@[@"ignored"]];
+    [block perform:@[@"typed"]];
+    [target perform];
+    [object perform];
+
+    XCTAssertEqualObjects(received, @[@"typed"]);
+    XCTAssertEqualObjects(self.target.calls, (@[@"fire", @"object 42"]));
+}
+
+/** Targets are kept, like they were before actions became a class cluster. */
+- (void)testKeepsItsTarget {
+    TBAlertAction *action = nil;
+    __weak TBActionTestTarget *weakTarget = nil;
+    @autoreleasepool {
+        TBActionTestTarget *target = [TBActionTestTarget new];
+        weakTarget = target;
+        action = [[TBAlertAction alloc] initWithTitle:@"Fire" target:target action:@selector(fire)];
+    }
+
+    XCTAssertNotNil(weakTarget);
+    [action perform];
+    XCTAssertEqualObjects(weakTarget.calls, @[@"fire"]);
+}
+
+#pragma mark - Method lookup
+
+/** The method is looked up once, and again when the target's class changes under the action. */
+- (void)testLooksUpTheMethodAgainWhenTheClassChanges {
+    TBAlertAction *action = [[TBAlertAction alloc] initWithTitle:@"Fire" target:self.target action:@selector(fire)];
+    [action perform];
+
+    object_setClass(self.target, [TBActionTestSubtarget class]);
+    [action perform];
+    object_setClass(self.target, [TBActionTestTarget class]);
+    [action perform];
+
+    XCTAssertEqualObjects(self.target.calls, (@[@"fire", @"subclass fire", @"fire"]));
+}
+
+- (void)testKeepsWorkingUnderKeyValueObserving {
+    TBAlertAction *action = [[TBAlertAction alloc] initWithTitle:@"Fire" target:self.target action:@selector(fire)];
+    [action perform];
+
+    [self.target addObserver:self forKeyPath:@"observed" options:0 context:NULL];
+    XCTAssertNotEqual(object_getClass(self.target), [TBActionTestTarget class], @"KVO didn't swap the class");
+    [action perform];
+    [self.target removeObserver:self forKeyPath:@"observed"];
+    [action perform];
+
+    XCTAssertEqualObjects(self.target.calls, (@[@"fire", @"fire", @"fire"]));
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context {
+}
+
+#pragma mark - Arguments
+
+- (void)testUnboxesArguments {
+    SEL selector = @selector(recordInt:double:flag:object:range:);
+    NSArray *arguments = @[@7, @2.5, @YES, [NSNull null], [NSValue valueWithRange:NSMakeRange(1, 2)]];
+    TBAlertAction *action = [[TBAlertAction alloc] initWithTitle:@"Record" target:self.target action:selector arguments:arguments];
+
+    XCTAssertEqual(action.style, TBAlertActionStyleTargetArguments);
+    XCTAssertEqualObjects(action.arguments, arguments);
+
+    [action perform];
+    [action perform];
+    XCTAssertEqualObjects(self.target.calls, (@[@"7 2.5 1 nil {1, 2}", @"7 2.5 1 nil {1, 2}"]));
+
+    arguments = @[@-1, @0, @NO, @"text", [NSValue valueWithRange:NSMakeRange(0, 0)]];
+    [self.target.calls removeAllObjects];
+    [[[TBAlertAction alloc] initWithTitle:@"Record" target:self.target action:selector arguments:arguments] perform];
+    XCTAssertEqualObjects(self.target.calls, @[@"-1 0 0 text {0, 0}"]);
+}
+
+/** Arguments that don't fit are rejected up front, in release builds too, instead of being copied out of bounds. */
+- (void)testRejectsArgumentsThatDontFit {
+    TBCountingAssertionHandler *handler = [TBCountingAssertionHandler new];
+    NSThread.currentThread.threadDictionary[NSAssertionHandlerKey] = handler;
+
+    SEL selector = @selector(recordInt:double:flag:object:range:);
+    NSValue *point = [NSValue valueWithPointer:NULL];
+    NSArray<NSArray *> *rejected = @[
+        // An NSValue of another type, smaller than the parameter
+        @[@7, @2.5, @YES, [NSNull null], point],
+        // Not an NSValue at all
+        @[@7, @2.5, @YES, [NSNull null], @"{1, 2}"],
+        // An NSNumber for a struct
+        @[@7, @2.5, @YES, [NSNull null], @3],
+        // An object for a scalar
+        @[@"7", @2.5, @YES, [NSNull null], [NSValue valueWithRange:NSMakeRange(1, 2)]],
+        // Too few
+        @[@7, @2.5],
+    ];
+
+    for (NSArray *arguments in rejected) {
+        TBAlertAction *action = [[TBAlertAction alloc] initWithTitle:@"Record" target:self.target action:selector arguments:arguments];
+        XCTAssertEqual(action.style, TBAlertActionStyleNoAction, @"%@", arguments);
+        [action perform];
+    }
+
+    TBAlertAction *unknown = [[TBAlertAction alloc]
+        initWithTitle:@"Missing" target:self.target action:NSSelectorFromString(@"missing:") arguments:@[@1]
+    ];
+    XCTAssertEqual(unknown.style, TBAlertActionStyleNoAction);
+
+    XCTAssertEqualObjects(self.target.calls, @[]);
+#if !defined(NS_BLOCK_ASSERTIONS)
+    XCTAssertEqual(handler.failures, rejected.count + 1);
+#endif
+}
+
+@end
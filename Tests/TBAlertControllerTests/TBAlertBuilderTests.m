@@ -0,0 +1,43 @@
+//
+//  TBAlertBuilderTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController+Builder.h"
+
+@interface TBAlertBuilderTests : XCTestCase
+@end
+
+@implementation TBAlertBuilderTests
+
+/** A button's \c action, asked for once the alert is built, is the one the alert uses. */
+- (void)testActionAfterBuildingIsTheAlertsAction {
+    __block TBAlertActionBuilder *save = nil, *other = nil;
+    TBAlertController *alert = [TBAlert makeAlert:^(TBAlert *make) {
+        make.title(@"Rename");
+        other = make.button(@"Other");
+        save = make.button(@"Save").enabled(NO);
+        make.button(@"Cancel").cancelStyle();
+    }];
+
+    // Indexes move; the action still belongs to its button
+    [alert removeButtonAtIndex:0];
+    TBAlertAction *action = save.action;
+    XCTAssertEqual(action, [alert buttonAtIndex:0]);
+    XCTAssertEqual(save.action, action);
+    XCTAssertFalse(action.enabled);
+
+    action.enabled = YES;
+    XCTAssertTrue([alert isButtonEnabledAtIndex:0]);
+
+    // A removed button gets a detached action rather than someone else's
+    XCTAssertNotNil(other.action);
+    XCTAssertEqualObjects(other.action.title, @"Other");
+    XCTAssertNotEqual(other.action, [alert buttonAtIndex:0]);
+}
+
+@end
@@ -0,0 +1,229 @@
+//
+//  TBAlertCatalogTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertCatalog.h"
+#import "TBHeadlessAlertPresenter.h"
+
+@interface TBAlertCatalogTests : XCTestCase
+@property (nonatomic) NSArray<NSDictionary *> *specs;
+@end
+
+@implementation TBAlertCatalogTests
+
+- (void)setUp {
+    [super setUp];
+    self.specs = @[
+        @{
+            @"identifier": @"upload.failed",
+            @"title": @"Upload failed",
+            @"message": @"{count} files could not be uploaded.",
+            @"buttons": @[
+                @"Retry",
+                @{ @"title": @"Delete", @"role": @"destructive", @"enabled": @NO },
+                @{ @"title": @"Cancel", @"role": @"cancel" },
+            ],
+            @"textFields": @[
+                @{ @"identifier": @"password", @"placeholder": @"Password", @"secure": @YES },
+                @{ @"placeholder": @"Note" },
+            ],
+        },
+        @{
+            @"identifier": @"move.to",
+            @"style": @"sheet",
+            @"title": @"Move to",
+            @"buttons": @[@"Inbox", @"Archive", @{ @"title": @"Cancel", @"role": @"cancel" }],
+        },
+        @{ @"identifier": @"empty" },
+    ];
+}
+
+- (TBAlertCatalog *)catalogWithSpecs:(NSArray *)specs {
+    NSError *error = nil;
+    NSData *data = [TBAlertCatalog compileSpecs:specs error:&error];
+    XCTAssertNotNil(data, @"%@", error);
+    TBAlertCatalog *catalog = data ? [TBAlertCatalog catalogWithData:data error:&error] : nil;
+    XCTAssertNotNil(catalog, @"%@", error);
+    return catalog;
+}
+
+- (void)assertCompiling:(NSArray *)specs failsWithCode:(TBAlertCatalogErrorCode)code {
+    NSError *error = nil;
+    XCTAssertNil([TBAlertCatalog compileSpecs:specs error:&error]);
+    XCTAssertEqualObjects(error.domain, TBAlertCatalogErrorDomain);
+    XCTAssertEqual(error.code, code, @"%@", error.localizedDescription);
+}
+
+#pragma mark - Round trip
+
+- (void)testRoundTrip {
+    TBAlertCatalog *catalog = [self catalogWithSpecs:self.specs];
+    XCTAssertEqual(catalog.count, 3);
+    XCTAssertEqualObjects(catalog.identifiers, (@[@"empty", @"move.to", @"upload.failed"]));
+    XCTAssertNil([catalog templateWithIdentifier:@"missing"]);
+    XCTAssertNil([catalog alertControllerWithIdentifier:@"upload"]);
+
+    // Decoded once, then shared
+    TBAlertTemplate *template = [catalog templateWithIdentifier:@"move.to"];
+    XCTAssertNotNil(template);
+    XCTAssertEqual([catalog templateWithIdentifier:@"move.to"], template);
+}
+
+- (void)testRoundTripThroughFiles {
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+    NSString *path = [directory stringByAppendingPathComponent:@"catalog.tbalerts"];
+    [NSFileManager.defaultManager createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    NSData *first = [NSJSONSerialization dataWithJSONObject:self.specs[0] options:0 error:nil];
+    NSData *rest = [NSJSONSerialization dataWithJSONObject:[self.specs subarrayWithRange:NSMakeRange(1, 2)] options:0 error:nil];
+    [first writeToFile:[directory stringByAppendingPathComponent:@"a.json"] atomically:YES];
+    [rest writeToFile:[directory stringByAppendingPathComponent:@"b.json"] atomically:YES];
+
+    NSError *error = nil;
+    XCTAssertTrue([TBAlertCatalog compileSpecsInDirectory:directory toFile:path error:&error], @"%@", error);
+    TBAlertCatalog *catalog = [TBAlertCatalog catalogWithContentsOfFile:path error:&error];
+    XCTAssertNotNil(catalog, @"%@", error);
+    XCTAssertEqualObjects(catalog.identifiers, (@[@"empty", @"move.to", @"upload.failed"]));
+    XCTAssertEqualObjects([catalog alertControllerWithIdentifier:@"upload.failed"].title, @"Upload failed");
+
+    // The same specs in another file
+    [first writeToFile:[directory stringByAppendingPathComponent:@"c.json"] atomically:YES];
+    XCTAssertFalse([TBAlertCatalog compileSpecsInDirectory:directory toFile:path error:&error]);
+    XCTAssertEqual(error.code, TBAlertCatalogErrorDuplicateIdentifier);
+
+    [NSFileManager.defaultManager removeItemAtPath:directory error:nil];
+}
+
+#pragma mark - Decoding
+
+- (void)testDecodesTitlesRolesAndTextFields {
+    TBAlertCatalog *catalog = [self catalogWithSpecs:self.specs];
+    TBAlertController *alert = [catalog alertControllerWithIdentifier:@"upload.failed"];
+    XCTAssertEqualObjects(alert.identifier, @"upload.failed");
+    XCTAssertEqual(alert.style, TBAlertControllerStyleAlert);
+    XCTAssertEqualObjects(alert.title, @"Upload failed");
+    XCTAssertEqualObjects(alert.message, @"{count} files could not be uploaded.");
+
+    // The cancel button goes last
+    XCTAssertEqual(alert.numberOfButtons, 3);
+    XCTAssertEqualObjects([alert titleForButtonAtIndex:0], @"Retry");
+    XCTAssertEqualObjects([alert titleForButtonAtIndex:1], @"Delete");
+    XCTAssertEqualObjects([alert titleForButtonAtIndex:2], @"Cancel");
+    XCTAssertEqual([alert actionStyleForButtonAtIndex:0], UIAlertActionStyleDefault);
+    XCTAssertEqual([alert actionStyleForButtonAtIndex:1], UIAlertActionStyleDestructive);
+    XCTAssertEqual([alert actionStyleForButtonAtIndex:2], UIAlertActionStyleCancel);
+    XCTAssertEqual(alert.destructiveButtonIndex, 1);
+    XCTAssertTrue([alert isButtonEnabledAtIndex:0]);
+    XCTAssertFalse([alert isButtonEnabledAtIndex:1]);
+
+    XCTAssertEqualObjects(alert.textFieldIdentifiers, (@[@"password", NSNull.null]));
+    TBHeadlessAlertPresenter *presenter = [TBHeadlessAlertPresenter new];
+    alert.presenter = presenter;
+    [alert showFromViewController:nil animated:NO completion:nil];
+    NSArray<UITextField *> *textFields = presenter.topPresentation.textFields;
+    XCTAssertEqual(textFields.count, 2);
+    if (textFields.count == 2) {
+        XCTAssertEqualObjects(textFields[0].placeholder, @"Password");
+        XCTAssertTrue(textFields[0].secureTextEntry);
+        XCTAssertEqualObjects(textFields[1].placeholder, @"Note");
+        XCTAssertFalse(textFields[1].secureTextEntry);
+    }
+    [alert dismissAnimated:NO completion:nil];
+}
+
+- (void)testDecodesSheetsAndEmptyAlerts {
+    TBAlertCatalog *catalog = [self catalogWithSpecs:self.specs];
+    TBAlertController *sheet = [catalog alertControllerWithIdentifier:@"move.to"];
+    XCTAssertEqual(sheet.style, TBAlertControllerStyleActionSheet);
+    XCTAssertNil(sheet.message);
+    XCTAssertEqual(sheet.numberOfButtons, 3);
+    XCTAssertEqual(sheet.destructiveButtonIndex, NSNotFound);
+    XCTAssertEqual([sheet actionStyleForButtonAtIndex:2], UIAlertActionStyleCancel);
+
+    TBAlertController *empty = [catalog alertControllerWithIdentifier:@"empty"];
+    XCTAssertNil(empty.title);
+    XCTAssertNil(empty.message);
+    XCTAssertEqual(empty.numberOfButtons, 0);
+    XCTAssertEqual(empty.textFieldIdentifiers.count, 0);
+}
+
+#pragma mark - Invalid specs
+
+- (void)testRejectsDuplicateIdentifiers {
+    [self assertCompiling:@[@{ @"identifier": @"a" }, @{ @"identifier": @"b" }, @{ @"identifier": @"a" }]
+            failsWithCode:TBAlertCatalogErrorDuplicateIdentifier];
+}
+
+- (void)testRejectsInvalidSpecs {
+    NSArray *invalid = @[
+        @"not an object",
+        @{ @"title": @"No identifier" },
+        @{ @"identifier": @"" },
+        @{ @"identifier": @"a", @"title": @1 },
+        @{ @"identifier": @"a", @"style": @"popover" },
+        @{ @"identifier": @"a", @"buttons": @"OK" },
+        @{ @"identifier": @"a", @"buttons": @[@{ @"role": @"cancel" }] },
+        @{ @"identifier": @"a", @"buttons": @[@{ @"title": @"OK", @"role": @"primary" }] },
+        @{ @"identifier": @"a", @"buttons": @[@{ @"title": @"OK", @"enabled": @"yes" }] },
+        @{ @"identifier": @"a", @"buttons": @[
+            @{ @"title": @"Cancel", @"role": @"cancel" }, @{ @"title": @"Close", @"role": @"cancel" }
+        ] },
+        @{ @"identifier": @"a", @"buttons": @[
+            @{ @"title": @"Delete", @"role": @"destructive" }, @{ @"title": @"Erase", @"role": @"destructive" }
+        ] },
+        @{ @"identifier": @"a", @"style": @"sheet", @"textFields": @[@{ @"placeholder": @"Name" }] },
+        @{ @"identifier": @"a", @"textFields": @[@"Name"] },
+    ];
+    for (id spec in invalid) {
+        [self assertCompiling:@[spec] failsWithCode:TBAlertCatalogErrorInvalidSpec];
+    }
+}
+
+#pragma mark - Invalid catalogs
+
+- (void)testRejectsTruncatedCatalogs {
+    NSData *data = [TBAlertCatalog compileSpecs:self.specs error:nil];
+    for (NSUInteger length = 0; length < data.length; length++) {
+        NSError *error = nil;
+        TBAlertCatalog *catalog = [TBAlertCatalog catalogWithData:[data subdataWithRange:NSMakeRange(0, length)] error:&error];
+        XCTAssertNil(catalog, @"opened a catalog cut off after %lu bytes", (unsigned long)length);
+        XCTAssertEqual(error.code, TBAlertCatalogErrorInvalidCatalog);
+    }
+
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+    [[data subdataWithRange:NSMakeRange(0, data.length / 2)] writeToFile:path atomically:YES];
+    XCTAssertNil([TBAlertCatalog catalogWithContentsOfFile:path error:nil]);
+    [NSFileManager.defaultManager removeItemAtPath:path error:nil];
+    XCTAssertNil([TBAlertCatalog catalogWithContentsOfFile:path error:nil]);
+}
+
+/** Every single byte changed to a few values: whatever opens must read without crashing, and
+ whatever decodes must still be an alert a catalog could describe. */
+- (void)testSurvivesCorruptedCatalogs {
+    NSData *data = [TBAlertCatalog compileSpecs:self.specs error:nil];
+    const uint8_t values[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+    for (NSUInteger offset = 0; offset < data.length; offset++) {
+        for (size_t v = 0; v < sizeof(values); v++) {
+            @autoreleasepool {
+                NSMutableData *corrupt = data.mutableCopy;
+                ((uint8_t *)corrupt.mutableBytes)[offset] = values[v];
+                TBAlertCatalog *catalog = [TBAlertCatalog catalogWithData:corrupt error:nil];
+                for (NSString *identifier in catalog.identifiers) {
+                    TBAlertController *alert = [catalog alertControllerWithIdentifier:identifier];
+                    if (alert.style == TBAlertControllerStyleActionSheet) {
+                        XCTAssertEqual(alert.textFieldIdentifiers.count, 0);
+                    }
+                }
+                for (NSDictionary *spec in self.specs) {
+                    [catalog alertControllerWithIdentifier:spec[@"identifier"]];
+                }
+            }
+        }
+    }
+}
+
+@end
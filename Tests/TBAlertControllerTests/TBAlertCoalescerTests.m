@@ -0,0 +1,80 @@
+//
+//  TBAlertCoalescerTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController.h"
+#import "TBAlertCoalescer.h"
+#import "TBHeadlessAlertPresenter.h"
+#include <stdatomic.h>
+
+/** Runs the main run loop until \c done returns \c YES, so that blocks sent to the main queue run. */
+static void TBRunMainLoopUntil(BOOL (^done)(void)) {
+    while (!done()) {
+        [NSRunLoop.mainRunLoop runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+}
+
+/** Run under ThreadSanitizer to look for data races; see the README. */
+@interface TBAlertCoalescerTests : XCTestCase
+@end
+
+@implementation TBAlertCoalescerTests
+
+- (void)tearDown {
+    TBAlertController.coalescer = nil;
+    [super tearDown];
+}
+
+/** The same alert shown from many threads at once, folded into one by a coalescer,
+ then one choice made for all of them. Every alert's handler must run exactly once. */
+- (void)testStormOfIdenticalAlertsIsPresentedOnce {
+    NSUInteger threads = MAX(NSProcessInfo.processInfo.activeProcessorCount, 4), alertsPerThread = 1000;
+    TBHeadlessAlertPresenter *presenter = [TBHeadlessAlertPresenter new];
+    TBAlertCoalescer *coalescer = [TBAlertCoalescer new];
+    coalescer.repeatCountFormat = @"Happened %lu times.";
+    TBAlertController.coalescer = coalescer;
+
+    NSUInteger total = threads * alertsPerThread;
+    static _Atomic(NSUInteger) retries;
+    atomic_store(&retries, 0);
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    for (NSUInteger t = 0; t < threads; t++) {
+        dispatch_group_async(group, queue, ^{
+            for (NSUInteger i = 0; i < alertsPerThread; i++) {
+                @autoreleasepool {
+                    TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Request failed" message:@"Please try again later."];
+                    alert.presenter = presenter;
+                    [alert addOtherButtonWithTitle:@"Retry" buttonAction:^(NSArray *strings) {
+                        atomic_fetch_add(&retries, 1);
+                    }];
+                    [alert setCancelButtonWithTitle:@"Cancel"];
+                    [alert showFromViewController:nil animated:NO completion:nil];
+                }
+            }
+        });
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    TBRunMainLoopUntil(^BOOL{ return presenter.topPresentation != nil; });
+    XCTAssertEqual(presenter.presentationCount, 1, @"identical alerts were presented separately");
+    TBAlertController *shown = presenter.topPresentation.alert;
+
+    // However the folding threads raced, the newest count is the one that sticks
+    NSString *counted = [NSString stringWithFormat:@"Please try again later.\n\nHappened %lu times.", (unsigned long)total];
+    TBRunMainLoopUntil(^BOOL{ return [shown.message isEqualToString:counted]; });
+
+    [presenter.topPresentation tapButtonWithTitle:@"Retry"];
+    XCTAssertEqual(atomic_load(&retries), total);
+
+    TBRunMainLoopUntil(^BOOL{ return presenter.topPresentation == nil; });
+    XCTAssertEqualObjects(shown.message, @"Please try again later.", @"the repeat count outlived the alert");
+}
+
+@end
@@ -0,0 +1,135 @@
+//
+//  TBAlertConcurrencyTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController.h"
+#import "TBHeadlessAlertPresenter.h"
+#include <stdatomic.h>
+
+/** Runs the main run loop until \c done returns \c YES, so that blocks sent to the main queue run. */
+static void TBRunMainLoopUntil(BOOL (^done)(void)) {
+    while (!done()) {
+        [NSRunLoop.mainRunLoop runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+}
+
+/** Run under ThreadSanitizer to look for data races; see the README. */
+@interface TBAlertConcurrencyTests : XCTestCase
+@property (nonatomic) NSUInteger threads;
+@end
+
+@implementation TBAlertConcurrencyTests
+
+- (void)setUp {
+    [super setUp];
+    self.threads = MAX(NSProcessInfo.processInfo.activeProcessorCount, 4);
+}
+
+/** Many threads change one alert while the main thread keeps showing, updating, and dismissing it. */
+- (void)testManyThreadsChangingOneAlert {
+    NSUInteger threads = self.threads, editsPerThread = 200;
+    TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Syncing" message:nil];
+    TBHeadlessAlertPresenter *presenter = [TBHeadlessAlertPresenter new];
+    alert.presenter = presenter;
+    [alert setCancelButtonWithTitle:@"Cancel"];
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    for (NSUInteger t = 0; t < threads; t++) {
+        dispatch_group_async(group, queue, ^{
+            for (NSUInteger i = 0; i < editsPerThread; i++) {
+                @autoreleasepool {
+                    // Every thread adds two buttons and removes one, so the count is known at the end
+                    [alert addOtherButtonWithTitle:[NSString stringWithFormat:@"%lu.%lu", (unsigned long)t, (unsigned long)i]];
+                    [alert addOtherButtonWithTitle:@"Scratch"];
+                    NSUInteger scratch = [alert.actions indexOfObjectPassingTest:^BOOL(TBAlertAction *action, NSUInteger idx, BOOL *stop) {
+                        return [action.title isEqualToString:@"Scratch"];
+                    }];
+                    if (scratch != NSNotFound) {
+                        [alert setButtonEnabled:i % 2 atIndex:scratch];
+                    }
+                    alert.message = [NSString stringWithFormat:@"%lu of %lu", (unsigned long)i, (unsigned long)editsPerThread];
+                    alert.titleProvider = ^{ return @"Syncing"; };
+                    (void)alert.title;
+                    (void)alert.numberOfButtons;
+                    (void)alert.destructiveButtonIndex;
+                    if (i % 16 == 0) {
+                        [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) { }];
+                        [alert prepareForPresentation];
+                    }
+                }
+            }
+        });
+    }
+
+    // Meanwhile, keep presenting whatever the alert looks like at the moment
+    TBRunMainLoopUntil(^BOOL{
+        [alert showFromViewController:nil animated:NO completion:nil];
+        [alert updateIfNeeded];
+        [alert dismissAnimated:NO completion:nil];
+        return dispatch_group_wait(group, DISPATCH_TIME_NOW) == 0;
+    });
+
+    // Scratch buttons are removed from the main thread, where indexes can't shift underneath us
+    for (NSUInteger i = alert.numberOfButtons; i-- > 0;) {
+        if ([[alert buttonAtIndex:i].title isEqualToString:@"Scratch"]) {
+            [alert removeButtonAtIndex:i];
+        }
+    }
+
+    [alert showFromViewController:nil animated:NO completion:nil];
+    TBRunMainLoopUntil(^BOOL{ return presenter.topPresentation != nil; });
+    [alert updateIfNeeded];
+
+    NSUInteger expected = threads * editsPerThread + 1;
+    NSArray<NSString *> *presented = presenter.topPresentation.buttonTitles;
+    XCTAssertEqual(alert.numberOfButtons, expected);
+    XCTAssertEqual(presented.count, expected);
+    for (NSUInteger i = 0; i < MIN(expected, presented.count); i++) {
+        XCTAssertEqualObjects(presented[i], [alert titleForButtonAtIndex:i], @"button %lu", (unsigned long)i);
+    }
+
+    [alert dismissAnimated:NO completion:nil];
+}
+
+/** Many threads reading a provided button title while another keeps invalidating it, like a coalescer
+ fingerprinting alerts off the main thread while the main thread refreshes them. */
+- (void)testManyThreadsResolvingOneButtonTitle {
+    NSUInteger threads = self.threads, readsPerThread = 2000;
+    static _Atomic(NSUInteger) calls;
+    atomic_store(&calls, 0);
+    TBAlertAction *action = [TBAlertAction actionWithTitleProvider:^NSString *{
+        return [NSString stringWithFormat:@"Retry (%lu)", (unsigned long)atomic_fetch_add(&calls, 1)];
+    } block:nil];
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    for (NSUInteger t = 0; t < threads; t++) {
+        dispatch_group_async(group, queue, ^{
+            for (NSUInteger i = 0; i < readsPerThread; i++) {
+                @autoreleasepool {
+                    NSString *title = action.title;
+                    if (![title hasPrefix:@"Retry ("]) {
+                        XCTFail(@"read a torn title: %@", title);
+                        return;
+                    }
+                    if (t == 0 && i % 10 == 0) {
+                        [action invalidateTitle];
+                    }
+                }
+            }
+        });
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    // Resolved again only after being invalidated, give or take threads racing to resolve it
+    XCTAssertLessThanOrEqual(atomic_load(&calls), (readsPerThread / 10 + 1) * threads);
+    XCTAssertEqualObjects(action.title, action.title);
+}
+
+@end
@@ -0,0 +1,77 @@
+//
+//  TBAlertDeadlineSchedulerTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertDeadlineScheduler.h"
+
+@interface TBAlertDeadlineSchedulerTests : XCTestCase
+@property (nonatomic) TBAlertManualClock *clock;
+@property (nonatomic) TBAlertDeadlineScheduler *scheduler;
+@property (nonatomic) NSMutableArray<NSNumber *> *fired;
+@end
+
+@implementation TBAlertDeadlineSchedulerTests
+
+- (void)setUp {
+    [super setUp];
+    self.clock = [TBAlertManualClock new];
+    self.scheduler = [[TBAlertDeadlineScheduler alloc] initWithClock:self.clock];
+    self.fired = [NSMutableArray new];
+}
+
+- (NSUInteger)schedule:(NSUInteger)i {
+    return [self.scheduler scheduleAfter:i handler:^{
+        [self.fired addObject:@(i)];
+    }];
+}
+
+/** Advances the clock one second at a time until every deadline has passed. */
+- (void)runUntilEmpty {
+    while (self.scheduler.count) {
+        [self.clock advanceBy:1];
+    }
+}
+
+/** Most deadlines, like alert timeouts, are cancelled long before they pass. The rest must still
+ fire in order, however often the cancelled ones are cleared out of the way. */
+- (void)testCancellingMostDeadlines {
+    NSUInteger total = 1000;
+    NSMutableArray<NSNumber *> *tokens = [NSMutableArray new];
+    for (NSUInteger i = 1; i <= total; i++) {
+        [tokens addObject:@([self schedule:i])];
+    }
+
+    // Cancel all but every tenth, in a scattered order, and schedule more along the way
+    for (NSUInteger step = 0; step < total; step++) {
+        NSUInteger i = step * 7 % total;
+        if (i % 10) {
+            [self.scheduler cancelDeadline:tokens[i].unsignedIntegerValue];
+        }
+        if (step % 100 == 0) {
+            [self schedule:total + step];
+        }
+    }
+
+    NSMutableArray<NSNumber *> *expected = [NSMutableArray new];
+    for (NSUInteger i = 1; i <= total; i += 10) {
+        [expected addObject:@(i)];
+    }
+    for (NSUInteger step = 0; step < total; step += 100) {
+        [expected addObject:@(total + step)];
+    }
+
+    XCTAssertEqual(self.scheduler.count, expected.count);
+    [self runUntilEmpty];
+    XCTAssertEqualObjects(self.fired, expected);
+
+    // Cancelling what already fired does nothing
+    [self.scheduler cancelDeadline:tokens[0].unsignedIntegerValue];
+    XCTAssertEqual(self.scheduler.count, 0);
+}
+
+@end
@@ -0,0 +1,194 @@
+//
+//  TBAlertResultTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController.h"
+#import "TBAlertResult.h"
+#import "TBHeadlessAlertPresenter.h"
+
+@interface TBAlertResultTests : XCTestCase
+@property (nonatomic) TBHeadlessAlertPresenter *presenter;
+@end
+
+@implementation TBAlertResultTests
+
+- (void)setUp {
+    [super setUp];
+    self.presenter = [TBHeadlessAlertPresenter new];
+}
+
+- (TBAlertController *)saveAlert {
+    TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Save changes?" message:nil];
+    alert.presenter = self.presenter;
+    TBAlertAction *save = [[TBAlertAction alloc] initWithTitle:@"Save"];
+    save.identifier = @"save";
+    [alert addOtherButton:save];
+    [alert setCancelButtonWithTitle:@"Cancel"];
+    return alert;
+}
+
+#pragma mark Results
+
+- (void)testChoosingAButton {
+    __block TBAlertResult *result = nil;
+    [self.saveAlert presentForResultFromViewController:nil cancellationToken:nil timeout:0 completion:^(TBAlertResult *r) {
+        result = r;
+    }];
+
+    XCTAssertNil(result);
+    [self.presenter.topPresentation tapButtonWithTitle:@"Save"];
+
+    XCTAssertEqual(result.reason, TBAlertResultReasonButton);
+    XCTAssertEqual(result.buttonIndex, 0);
+    XCTAssertEqualObjects(result.buttonIdentifier, @"save");
+    XCTAssertNil(self.presenter.topPresentation);
+}
+
+- (void)testTimingOut {
+    XCTestExpectation *resolved = [self expectationWithDescription:@"resolved"];
+    __block TBAlertResult *result = nil;
+    [self.saveAlert presentForResultFromViewController:nil cancellationToken:nil timeout:0.05 completion:^(TBAlertResult *r) {
+        result = r;
+        [resolved fulfill];
+    }];
+
+    XCTAssertNotNil(self.presenter.topPresentation);
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqual(result.reason, TBAlertResultReasonTimedOut);
+    XCTAssertEqual(result.buttonIndex, NSNotFound);
+    XCTAssertNil(result.textFieldValues);
+    XCTAssertNil(self.presenter.topPresentation, @"a timed out alert is still presented");
+}
+
+/** Choosing a button first cancels the timeout, which must not resolve the alert a second time. */
+- (void)testChoosingAButtonBeforeTheTimeout {
+    __block NSUInteger calls = 0;
+    [self.saveAlert presentForResultFromViewController:nil cancellationToken:nil timeout:0.05 completion:^(TBAlertResult *r) {
+        calls++;
+    }];
+    [self.presenter.topPresentation tapButtonWithTitle:@"Cancel"];
+
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertEqual(calls, 1);
+}
+
+#pragma mark Cancellation
+
+- (void)testCancelling {
+    TBAlertCancellationToken *token = [TBAlertCancellationToken new];
+    NSMutableArray<TBAlertResult *> *results = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 2; i++) {
+        [self.saveAlert presentForResultFromViewController:nil cancellationToken:token timeout:0 completion:^(TBAlertResult *r) {
+            [results addObject:r];
+        }];
+    }
+
+    XCTAssertEqual(self.presenter.presentations.count, 2);
+    [token cancel];
+
+    XCTAssertTrue(token.isCancelled);
+    XCTAssertEqual(results.count, 2, @"cancelling on the main thread didn't resolve before returning");
+    XCTAssertEqual(results.firstObject.reason, TBAlertResultReasonCancelled);
+    XCTAssertEqual(results.lastObject.reason, TBAlertResultReasonCancelled);
+    XCTAssertEqual(self.presenter.presentations.count, 0);
+}
+
+- (void)testAlreadyCancelledTokenDoesNotPresent {
+    TBAlertCancellationToken *token = [TBAlertCancellationToken new];
+    [token cancel];
+
+    __block TBAlertResult *result = nil;
+    [self.saveAlert presentForResultFromViewController:nil cancellationToken:token timeout:0 completion:^(TBAlertResult *r) {
+        result = r;
+    }];
+
+    XCTAssertEqual(result.reason, TBAlertResultReasonCancelled);
+    XCTAssertEqual(self.presenter.presentationCount, 0);
+}
+
+/** Once resolved, an alert removes its handler, so cancelling the token later does nothing to it. */
+- (void)testCancellingAfterAResult {
+    TBAlertCancellationToken *token = [TBAlertCancellationToken new];
+    __block NSUInteger calls = 0;
+    [self.saveAlert presentForResultFromViewController:nil cancellationToken:token timeout:0 completion:^(TBAlertResult *r) {
+        calls++;
+    }];
+    [self.presenter.topPresentation tapButtonWithTitle:@"Save"];
+    [token cancel];
+
+    XCTAssertEqual(calls, 1);
+}
+
+- (void)testCancellingFromAnotherThreadCallsHandlersOnTheMainThread {
+    TBAlertCancellationToken *token = [TBAlertCancellationToken new];
+    XCTestExpectation *before = [self expectationWithDescription:@"added before cancelling"];
+    XCTestExpectation *after = [self expectationWithDescription:@"added after cancelling"];
+    [token addCancellationHandler:^{
+        XCTAssertTrue(NSThread.isMainThread);
+        [before fulfill];
+    }];
+    id<NSObject> removed = [token addCancellationHandler:^{
+        XCTFail(@"a removed handler was called");
+    }];
+    [token removeCancellationHandler:removed];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [token cancel];
+        XCTAssertTrue(token.isCancelled);
+        [token addCancellationHandler:^{
+            XCTAssertTrue(NSThread.isMainThread);
+            [after fulfill];
+        }];
+    });
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+/** Threads add and remove handlers while another cancels. Every handler that isn't removed
+ is called exactly once, on the main thread, whether it was added before or after cancelling. */
+- (void)testConcurrentHandlersAndCancellation {
+    TBAlertCancellationToken *token = [TBAlertCancellationToken new];
+    NSUInteger threads = 8, handlersPerThread = 500;
+    NSUInteger expected = threads * handlersPerThread / 2;
+    __block NSUInteger calls = 0, offMain = 0;
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    for (NSUInteger t = 0; t < threads; t++) {
+        dispatch_group_async(group, queue, ^{
+            for (NSUInteger i = 0; i < handlersPerThread; i++) {
+                id<NSObject> registration = [token addCancellationHandler:^{
+                    offMain += !NSThread.isMainThread;
+                    calls++;
+                }];
+                if (i % 2) {
+                    [token removeCancellationHandler:registration];
+                }
+            }
+        });
+    }
+    dispatch_group_async(group, queue, ^{
+        [token cancel];
+    });
+
+    // Handlers run on the main thread, so let it turn while we wait
+    while (dispatch_group_wait(group, DISPATCH_TIME_NOW)) {
+        [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    NSDate *giveUp = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (calls < expected && giveUp.timeIntervalSinceNow > 0) {
+        [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+    XCTAssertEqual(calls, expected);
+    XCTAssertEqual(offMain, 0);
+}
+
+@end
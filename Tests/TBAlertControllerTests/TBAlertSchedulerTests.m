@@ -0,0 +1,136 @@
+//
+//  TBAlertSchedulerTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertScheduler.h"
+#import "TBHeadlessAlertPresenter.h"
+
+/** Can't present alerts with some titles, like a UIKit presenter with nothing to present from. */
+@interface TBRefusingAlertPresenter : TBHeadlessAlertPresenter
+@property (nonatomic, copy) NSSet<NSString *> *refusedTitles;
+@end
+
+@implementation TBRefusingAlertPresenter
+
+- (id<TBAlertPresentation>)presentAlert:(TBAlertController *)alert
+                     fromViewController:(UIViewController *)viewController
+                               animated:(BOOL)animated
+                             completion:(TBVoidBlock)completion {
+    if ([self.refusedTitles containsObject:alert.title]) {
+        return nil;
+    }
+
+    return [super presentAlert:alert fromViewController:viewController animated:animated completion:completion];
+}
+
+@end
+
+/** Ordering, preemption, and drop policies, against the headless presenter. */
+@interface TBAlertSchedulerTests : XCTestCase
+@property (nonatomic) TBRefusingAlertPresenter *presenter;
+@property (nonatomic) TBAlertScheduler *scheduler;
+@end
+
+@implementation TBAlertSchedulerTests
+
+- (void)setUp {
+    [super setUp];
+    self.presenter = [TBRefusingAlertPresenter new];
+    self.scheduler = [TBAlertScheduler new];
+}
+
+- (TBAlertController *)noticeWithTitle:(NSString *)title {
+    TBAlertController *alert = [TBAlertController alertViewWithTitle:title message:nil];
+    alert.presenter = self.presenter;
+    [alert setCancelButtonWithTitle:@"OK"];
+    return alert;
+}
+
+/** Dismisses whatever is on screen until nothing is, and returns the titles in the order they were shown. */
+- (NSArray<NSString *> *)tapThrough {
+    NSMutableArray<NSString *> *shown = [NSMutableArray new];
+    while (self.presenter.topPresentation) {
+        [shown addObject:self.presenter.topPresentation.title];
+        [self.presenter.topPresentation tapButtonAtIndex:0];
+    }
+
+    return shown;
+}
+
+- (void)testPrioritiesPreemptionAndDropPolicies {
+    TBAlertScheduler *scheduler = self.scheduler;
+    [scheduler setLimit:2 dropPolicy:TBAlertDropPolicyOldest forPriority:TBAlertPriorityLow];
+    [scheduler setLimit:1 dropPolicy:TBAlertDropPolicyNewest forPriority:TBAlertPriorityHigh];
+
+    // "normal 1" is shown right away; everything else waits
+    NSArray *schedule = @[
+        @[@"normal 1", @(TBAlertPriorityNormal)],
+        @[@"low 1", @(TBAlertPriorityLow)],
+        @[@"high 1", @(TBAlertPriorityHigh)],
+        @[@"low 2", @(TBAlertPriorityLow)],
+        @[@"normal 2", @(TBAlertPriorityNormal)],
+        @[@"low 3", @(TBAlertPriorityLow)],  // Drops "low 1"
+        @[@"high 2", @(TBAlertPriorityHigh)] // Dropped
+    ];
+    for (NSArray *item in schedule) {
+        [scheduler scheduleAlert:[self noticeWithTitle:item[0]] priority:[item[1] integerValue] fromViewController:nil];
+    }
+
+    // Interrupts "normal 1", which comes back before "normal 2"
+    [scheduler scheduleAlert:[self noticeWithTitle:@"critical"] priority:TBAlertPriorityCritical fromViewController:nil];
+    XCTAssertEqual(self.presenter.presentations.count, 1, @"more than one alert on screen at once");
+
+    NSArray *expected = @[@"critical", @"high 1", @"normal 1", @"normal 2", @"low 2", @"low 3"];
+    XCTAssertEqualObjects([self tapThrough], expected);
+    XCTAssertEqual(scheduler.count, 0);
+    XCTAssertNil(scheduler.currentAlert);
+}
+
+/** An alert that can't be presented is dismissed, instead of holding up every alert behind it. */
+- (void)testMovesOnFromAlertsThatCannotBePresented {
+    self.presenter.refusedTitles = [NSSet setWithObjects:@"first", @"broken", nil];
+    TBAlertController *broken = [self noticeWithTitle:@"broken"];
+    __block TBAlertResult *result = nil;
+    [broken presentForResultFromViewController:nil cancellationToken:nil timeout:0 completion:^(TBAlertResult *r) {
+        result = r;
+    }];
+    XCTAssertEqual(result.reason, TBAlertResultReasonDismissed, @"a result waited on an alert that was never shown");
+
+    // Refused right away, and from the back of the queue
+    for (NSString *title in @[@"first", @"second", @"broken", @"third"]) {
+        [self.scheduler scheduleAlert:[self noticeWithTitle:title] priority:TBAlertPriorityNormal fromViewController:nil];
+    }
+
+    XCTAssertEqualObjects([self tapThrough], (@[@"second", @"third"]));
+    XCTAssertEqual(self.scheduler.count, 0);
+    XCTAssertNil(self.scheduler.currentAlert);
+}
+
+/** Threads racing to create the shared scheduler all get the same one. */
+- (void)testSharedSchedulerIsCreatedOnce {
+    TBAlertScheduler *original = TBAlertScheduler.sharedScheduler;
+    NSUInteger threads = MAX(NSProcessInfo.processInfo.activeProcessorCount, 4);
+    // Each thread writes only its own element, and the schedulers are kept alive by the class until the next round
+    NSMutableData *storage = [NSMutableData dataWithLength:threads * sizeof(void *)];
+    void **seen = storage.mutableBytes;
+
+    for (NSUInteger round = 0; round < 100; round++) {
+        TBAlertScheduler.sharedScheduler = nil;
+        dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^(size_t t) {
+            seen[t] = (__bridge void *)TBAlertScheduler.sharedScheduler;
+        });
+
+        for (NSUInteger t = 1; t < threads; t++) {
+            XCTAssertEqual(seen[t], seen[0], @"round %lu", (unsigned long)round);
+        }
+    }
+
+    TBAlertScheduler.sharedScheduler = original;
+}
+
+@end
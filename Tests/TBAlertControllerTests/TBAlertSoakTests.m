@@ -0,0 +1,323 @@
+//
+//  TBAlertSoakTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController.h"
+#import "TBHeadlessAlertPresenter.h"
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+/** Stands in for the example app's view controller: the target of its actions, and what its handlers capture. */
+@interface TBSoakTarget : NSObject
+@property (nonatomic) NSUInteger calls;
+@property (nonatomic) BOOL enabled;
+@end
+
+@implementation TBSoakTarget
+- (void)log {
+    self.calls++;
+}
+- (void)log:(NSString *)output {
+    self.calls++;
+}
+- (void)logStrings:(NSArray *)strings {
+    self.calls += strings.count;
+}
+@end
+
+typedef TBAlertController *(^TBSoakScenario)(TBSoakTarget *target, TBAlertControllerStyle style);
+
+static TBAlertController *TBSoakCancelAlert(NSString *message, TBAlertControllerStyle style) {
+    TBAlertController *alert = [[TBAlertController alloc] initWithTitle:@"Cancel Button" message:message style:style];
+    [alert setCancelButtonWithTitle:@"Cancel"];
+    return alert;
+}
+
+/** The alerts of the example app's TBViewController, by table row, and one built with \c TBAlert
+ whose handler captures the builder. Text fields are only added to alert style alerts. */
+static NSArray<TBSoakScenario> *TBSoakScenarios(void) {
+    return @[
+        // 0
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *error = [TBAlertController simpleOKAlertWithTitle:@"Oops!" message:@"You didn't enter a valid value."];
+            TBAlertController *alert = [[TBAlertController alloc] initWithTitle:@"Dismiss Programmatically" message:@"Enter a button index." style:TBAlertControllerStyleAlert];
+            [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+                textField.text = [NSString stringWithFormat:@"%lu", (unsigned long)target.calls];
+            }];
+            [alert setCancelButtonWithTitle:@"Don't enable" buttonAction:^(NSArray *strings) {
+                target.enabled = NO;
+            }];
+            [alert addOtherButtonWithTitle:@"Enable" buttonAction:^(NSArray *strings) {
+                if ([strings.firstObject length]) {
+                    target.enabled = YES;
+                } else {
+                    [error showFromViewController:nil animated:NO completion:nil];
+                    [error dismissAnimated:NO completion:nil];
+                }
+            }];
+            return alert;
+        },
+        // 1
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            return TBSoakCancelAlert(@"with no action", style);
+        },
+        // 2
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"block", style);
+            [alert setCancelButtonWithTitle:@"Cancel" buttonAction:^(NSArray *strings) {
+                [target log:@"Cancel button pressed"];
+            }];
+            return alert;
+        },
+        // 3
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"target-action", style);
+            [alert setCancelButtonWithTitle:@"Cancel" target:target action:@selector(log)];
+            return alert;
+        },
+        // 4
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"target-action-object", style);
+            [alert setCancelButtonWithTitle:@"Cancel" target:target action:@selector(log:) withObject:@"success!"];
+            return alert;
+        },
+        // 5
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"block", style);
+            [alert addOtherButtonWithTitle:@"OK" buttonAction:^(NSArray *strings) {
+                [target log:@"OK button pressed"];
+            }];
+            [alert removeCancelButton];
+            return alert;
+        },
+        // 6
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"block", style);
+            alert.title = @"Button";
+            [alert addOtherButtonWithTitle:@"OK" buttonAction:^(NSArray *strings) {
+                [target log:@"OK button pressed"];
+            }];
+            return alert;
+        },
+        // 7
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"target-action", style);
+            alert.title = @"Button";
+            [alert addOtherButtonWithTitle:@"OK" target:target action:@selector(log)];
+            return alert;
+        },
+        // 8
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"target-action-object", style);
+            alert.title = @"Button";
+            [alert addOtherButtonWithTitle:@"OK" target:target action:@selector(log:) withObject:@"success!"];
+            return alert;
+        },
+        // 9
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"two text fields", TBAlertControllerStyleAlert);
+            [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+                textField.placeholder = @"First field";
+            }];
+            [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+                textField.placeholder = @"Second field";
+            }];
+            [alert addOtherButtonWithTitle:@"OK" buttonAction:^(NSArray *strings) {
+                [target logStrings:strings];
+            }];
+            return alert;
+        },
+        // 10
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"login and password style", TBAlertControllerStyleAlert);
+            alert.alertViewStyle = UIAlertViewStyleLoginAndPasswordInput;
+            [alert addOtherButtonWithTitle:@"OK" buttonAction:^(NSArray *strings) {
+                [target logStrings:strings];
+            }];
+            return alert;
+        },
+        // 11
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"secure text + additional field", TBAlertControllerStyleAlert);
+            alert.alertViewStyle = UIAlertViewStyleSecureTextInput;
+            [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+                textField.secureTextEntry = YES;
+            }];
+            [alert addOtherButtonWithTitle:@"OK" buttonAction:^(NSArray *strings) {
+                [target logStrings:strings];
+            }];
+            return alert;
+        },
+        // 12
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            TBAlertController *alert = TBSoakCancelAlert(@"added and removed some buttons", style);
+            [alert addOtherButtonWithTitle:@"First"];
+            [alert addOtherButtonWithTitle:@"Second"];
+            [alert addOtherButtonWithTitle:@"Third" buttonAction:^(NSArray *strings) {
+                [target log:@"Third pressed"];
+            }];
+            [alert addOtherButtonWithTitle:@"Fourth"];
+            [alert addOtherButtonWithTitle:@"Fifth" target:target action:@selector(log)];
+            [alert setCancelButton:[[TBAlertAction alloc] initWithTitle:@"TBAlertAction cancel"]];
+            [alert addOtherButtonWithTitle:@"Sixth"];
+            [alert removeButtonAtIndex:0];
+            [alert removeButtonAtIndex:0];
+            [alert removeButtonAtIndex:2];
+            [alert removeButtonAtIndex:3];
+            [alert setButtonEnabled:NO atIndex:1];
+            [alert setCancelButton:[[TBAlertAction alloc] initWithTitle:@"TBAlertAction cancel"]];
+            return alert;
+        },
+        // The builder, captured by its own handler
+        ^(TBSoakTarget *target, TBAlertControllerStyle style) {
+            return [TBAlert makeAlert:^(TBAlert *make) {
+                make.title(@"Request failed").message(@"Please try again later.");
+                make.button(@"Retry").handler(^(NSArray<NSString *> *strings) {
+                    make.title(@"Ignored");
+                    [target log];
+                });
+                make.button(@"Cancel").cancelStyle();
+            }];
+        },
+    ];
+}
+
+static size_t TBResidentBytes(void) {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+#else
+    long pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+    if (fscanf(statm, "%*ld %ld", &pages) != 1) {
+        pages = 0;
+    }
+    fclose(statm);
+    return (size_t)pages * (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/** Shows and dismisses every alert of the example app thousands of times, and fails unless every
+ alert, action, and presentation is released and resident memory stays flat. */
+@interface TBAlertSoakTests : XCTestCase
+@property (nonatomic) TBAlertManualClock *clock;
+@property (nonatomic) TBHeadlessAlertPresenter *presenter;
+/** Every alert, action, and presentation so far, held weakly. */
+@property (nonatomic) NSHashTable *objects;
+@end
+
+@implementation TBAlertSoakTests
+
+- (void)setUp {
+    [super setUp];
+
+    // Deadlines and timeouts pass when told to, so that every round ends right away
+    self.clock = [TBAlertManualClock new];
+    TBAlertDeadlineScheduler.sharedScheduler = [[TBAlertDeadlineScheduler alloc] initWithClock:self.clock];
+    self.presenter = [TBHeadlessAlertPresenter new];
+    self.objects = [NSHashTable weakObjectsHashTable];
+}
+
+- (void)tearDown {
+    TBAlertDeadlineScheduler.sharedScheduler = nil;
+    [super tearDown];
+}
+
+/** Shows one alert and gets rid of it the way round \c round calls for: a button, its deadline, or a result timeout. */
+- (void)soakRound:(NSUInteger)round alert:(TBAlertController *)alert {
+    TBHeadlessAlertPresenter *presenter = self.presenter;
+    NSHashTable *objects = self.objects;
+    alert.presenter = presenter;
+    [objects addObject:alert];
+    for (TBAlertAction *action in alert.actions) {
+        [objects addObject:action];
+    }
+
+    // The example's toolbar toggles: a destructive button, and dismissing after a delay
+    if (round % 2 && alert.numberOfOtherButtons) {
+        alert.destructiveButtonIndex = 0;
+    }
+    if (round % 3 == 1) {
+        alert.deadline = 2;
+        alert.deadlineButtonIndex = round % 2 ? 0 : NSNotFound;
+    }
+
+    if (round % 5 == 4) {
+        [alert presentForResultFromViewController:nil cancellationToken:nil timeout:1 completion:^(TBAlertResult *result) { }];
+    } else {
+        [alert showFromViewController:nil animated:NO completion:nil];
+    }
+
+    TBHeadlessAlertPresentation *presentation = presenter.topPresentation;
+    [objects addObject:presentation];
+    if (presentation.textFields.count) {
+        [presentation setText:@"1" forTextFieldAtIndex:0];
+    }
+
+    if (round % 3 == 1 || round % 5 == 4) {
+        [self.clock advanceBy:3];
+    } else {
+        // The first enabled button from a place that moves with the round
+        NSUInteger count = presentation.buttonTitles.count;
+        for (NSUInteger i = 0; i < count; i++) {
+            if ([presentation tapButtonAtIndex:(round + i) % count]) {
+                break;
+            }
+        }
+    }
+
+    XCTAssertNil(presenter.topPresentation, @"round %lu left \"%@\" on screen", (unsigned long)round, presenter.topPresentation.title);
+}
+
+- (void)testEveryAlertIsReleasedAndMemoryStaysFlat {
+    TBSoakTarget *target = [TBSoakTarget new];
+    NSArray<TBSoakScenario> *scenarios = TBSoakScenarios();
+
+    // One of everything first, so that lazily created statics and caches count towards the baseline
+    @autoreleasepool {
+        for (NSUInteger i = 0; i < scenarios.count * 30; i++) {
+            [self soakRound:i alert:scenarios[i % scenarios.count](target, i % 2)];
+        }
+    }
+    size_t baseline = TBResidentBytes();
+
+    NSUInteger rounds = scenarios.count * 1000;
+    for (NSUInteger i = 0; i < rounds; i++) {
+        @autoreleasepool {
+            [self soakRound:i alert:scenarios[i % scenarios.count](target, i % 2)];
+        }
+
+        // Everything from every round so far should be gone by now
+        if (i % 500 == 499 || i == rounds - 1) {
+            NSArray *live = self.objects.allObjects;
+            if (live.count) {
+                XCTFail(@"%lu objects outlived their alerts, such as %@", (unsigned long)live.count, live.firstObject);
+                return;
+            }
+        }
+    }
+
+    // Allocators keep some memory after it's freed, but a leak grows with every round
+    size_t resident = TBResidentBytes();
+    double growth = ((double)resident - (double)baseline) / (1024 * 1024);
+    if (baseline) {
+        XCTAssertLessThanOrEqual(growth, 4, @"resident memory grew by %.1fMB over %lu alerts", growth, (unsigned long)rounds);
+    }
+}
+
+@end
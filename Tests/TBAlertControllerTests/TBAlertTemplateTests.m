@@ -0,0 +1,89 @@
+//
+//  TBAlertTemplateTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertTemplate.h"
+
+@interface TBAlertTemplateTests : XCTestCase
+@end
+
+@implementation TBAlertTemplateTests
+
+/** Buttons copied from a template are the same buttons, not just the same titles and actions. */
+- (void)testButtonsKeepIdentifiersAndTitleProviders {
+    __block NSUInteger provided = 0;
+    TBAlertController *source = [TBAlertController alertViewWithTitle:@"Delete {name}?" message:nil];
+    TBAlertAction *delete = [TBAlertAction actionWithTitleProvider:^NSString *{
+        return [NSString stringWithFormat:@"Delete (%lu)", (unsigned long)++provided];
+    } block:nil];
+    delete.identifier = @"delete";
+    [source addAction:delete];
+    TBAlertAction *cancel = [[TBAlertAction alloc] initWithTitle:@"Cancel"];
+    cancel.identifier = @"cancel";
+    [source setCancelButton:cancel];
+
+    // Compiling doesn't call providers
+    TBAlertTemplate *template = [[TBAlertTemplate alloc] initWithAlertController:source];
+    XCTAssertEqual(provided, 0);
+    XCTAssertEqualObjects(template.buttonTitles, (@[@"", @"Cancel"]));
+
+    TBAlertController *alert = [template alertControllerWithParameters:@{ @"name": @"Photo" }];
+    XCTAssertEqualObjects(alert.title, @"Delete Photo?");
+    XCTAssertNotNil([alert buttonWithIdentifier:@"delete"]);
+    XCTAssertEqualObjects([alert buttonWithIdentifier:@"cancel"].title, @"Cancel");
+
+    // Each alert controller asks the provider again, the first time the title is read
+    XCTAssertEqual(provided, 0);
+    XCTAssertEqualObjects([alert buttonWithIdentifier:@"delete"].title, @"Delete (1)");
+    XCTAssertEqualObjects([alert buttonWithIdentifier:@"delete"].title, @"Delete (1)");
+    XCTAssertEqualObjects([template.alertController buttonWithIdentifier:@"delete"].title, @"Delete (2)");
+}
+
+/** Providers run for each alert controller, when it's shown, with placeholders replaced in their results. */
+- (void)testProvidersStayFresh {
+    __block NSString *status = @"offline";
+    __block NSUInteger provided = 0;
+    TBAlertTemplate *template = [TBAlertTemplate alertTemplate:^(TBAlert *make) {
+        make.titleProvider(^NSString *{
+            provided++;
+            return [NSString stringWithFormat:@"{name} is %@", status];
+        });
+        make.messageProvider(^NSString *{
+            provided++;
+            return @"Since {time}.";
+        });
+        make.button(@"Retry").titleProvider(^NSString *{
+            provided++;
+            return [NSString stringWithFormat:@"Retry {name} (%@)", status];
+        });
+        make.button(@"OK").cancelStyle();
+    }];
+    XCTAssertEqual(provided, 0);
+    XCTAssertNil(template.title);
+    XCTAssertNil(template.message);
+
+    __block BOOL retried = NO;
+    TBAlertController *first = [template alertControllerWithParameters:@{ @"name": @"Server", @"time": @"noon" }
+                                                               handlers:nil];
+    status = @"online";
+    XCTAssertEqualObjects(first.title, @"Server is online");
+    XCTAssertEqualObjects(first.message, @"Since noon.");
+    XCTAssertEqualObjects([first titleForButtonAtIndex:0], @"Retry Server (online)");
+    XCTAssertEqual(provided, 3);
+
+    // Provider buttons take their handler by identifier; this one has none, so its action is kept
+    status = @"away";
+    TBAlertController *second = [template alertControllerWithParameters:@{ @"name": @"Mail" }
+                                                                handlers:@{ @"": ^(NSArray *strings) { retried = YES; } }];
+    XCTAssertEqualObjects(second.title, @"Mail is away");
+    XCTAssertEqualObjects(second.message, @"Since {time}.");
+    [[second buttonAtIndex:0] perform];
+    XCTAssertFalse(retried);
+}
+
+@end
@@ -0,0 +1,138 @@
+//
+//  TBAlertTraceBufferTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertTrace.h"
+#include <stdatomic.h>
+
+/** A record whose every field is derived from \c writer and \c index, so a torn one can be told apart. */
+static TBAlertTraceRecord TBTestRecord(NSUInteger writer, NSUInteger index) {
+    uint64_t alert = ((uint64_t)writer << 32) | index;
+    return (TBAlertTraceRecord){ ~alert, alert, (TBAlertTraceEvent)(index % 6), (TBAlertTracePhase)(index % 3) };
+}
+
+static BOOL TBTestRecordIsWhole(TBAlertTraceRecord record) {
+    uint64_t index = record.alert & UINT32_MAX;
+    return record.timestamp == ~record.alert && record.event == index % 6 && record.phase == index % 3;
+}
+
+@interface TBAlertTraceBufferTests : XCTestCase
+@end
+
+@implementation TBAlertTraceBufferTests
+
+- (void)testCapacityIsRoundedUpToAPowerOfTwo {
+    XCTAssertEqual([[TBAlertTraceBuffer alloc] initWithCapacity:5].capacity, 8);
+    XCTAssertEqual([[TBAlertTraceBuffer alloc] initWithCapacity:8].capacity, 8);
+    XCTAssertEqual([TBAlertTraceBuffer new].capacity, 4096);
+}
+
+/** Once the buffer laps the drainer, the oldest records are dropped and counted, and the newest kept in order. */
+- (void)testWraparoundKeepsTheNewestRecords {
+    TBAlertTraceBuffer *buffer = [[TBAlertTraceBuffer alloc] initWithCapacity:8];
+    for (NSUInteger i = 0; i < 5; i++) {
+        [buffer recordTraceEvent:TBTestRecord(0, i)];
+    }
+
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray new];
+    void (^collect)(TBAlertTraceRecord) = ^(TBAlertTraceRecord record) {
+        XCTAssertTrue(TBTestRecordIsWhole(record));
+        [indexes addObject:@(record.alert & UINT32_MAX)];
+    };
+
+    XCTAssertEqual([buffer drainRecordsUsingBlock:collect], 5);
+    XCTAssertEqualObjects(indexes, (@[@0, @1, @2, @3, @4]));
+    XCTAssertEqual(buffer.droppedCount, 0);
+    XCTAssertEqual([buffer drainRecordsUsingBlock:collect], 0, @"drained the same records twice");
+
+    // Two and a half laps, starting mid-buffer
+    [indexes removeAllObjects];
+    for (NSUInteger i = 5; i < 25; i++) {
+        [buffer recordTraceEvent:TBTestRecord(0, i)];
+    }
+
+    XCTAssertEqual([buffer drainRecordsUsingBlock:collect], 8);
+    XCTAssertEqualObjects(indexes, (@[@17, @18, @19, @20, @21, @22, @23, @24]));
+    XCTAssertEqual(buffer.droppedCount, 12);
+}
+
+- (void)testJSONFormat {
+    TBAlertTraceBuffer *buffer = [TBAlertTraceBuffer new];
+    XCTAssertEqualObjects([NSJSONSerialization JSONObjectWithData:buffer.drainJSON options:0 error:nil], @[]);
+
+    [buffer recordTraceEvent:(TBAlertTraceRecord){ 1000, 7, TBAlertTraceEventPresent, TBAlertTracePhaseBegin }];
+    [buffer recordTraceEvent:(TBAlertTraceRecord){ 2500, 7, TBAlertTraceEventDecision, TBAlertTracePhaseInstant }];
+
+    NSError *error = nil;
+    NSArray *events = [NSJSONSerialization JSONObjectWithData:buffer.drainJSON options:0 error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(events, (@[
+        @{ @"alert": @7, @"event": @"present", @"phase": @"begin", @"timestamp": @1000 },
+        @{ @"alert": @7, @"event": @"decision", @"phase": @"instant", @"timestamp": @2500 },
+    ]));
+    XCTAssertEqual(buffer.drainJSON.length, 2, @"drained records were encoded again");
+}
+
+/** Many threads record into a small buffer while another keeps draining it. Every record drained must be
+ whole and in the order its writer recorded it, and every record must be either drained or counted as dropped. */
+- (void)testConcurrentWritersAndDrainer {
+    NSUInteger writers = MAX(NSProcessInfo.processInfo.activeProcessorCount, 4), recordsPerWriter = 50000;
+    TBAlertTraceBuffer *buffer = [[TBAlertTraceBuffer alloc] initWithCapacity:256];
+
+    static _Atomic(BOOL) writing;
+    atomic_store(&writing, YES);
+    __block NSUInteger drained = 0, torn = 0, outOfOrder = 0;
+    NSMutableData *lastIndexes = [NSMutableData dataWithLength:writers * sizeof(int64_t)];
+    memset(lastIndexes.mutableBytes, 0xff, lastIndexes.length);
+    int64_t *last = lastIndexes.mutableBytes;
+
+    void (^check)(TBAlertTraceRecord) = ^(TBAlertTraceRecord record) {
+        NSUInteger writer = (NSUInteger)(record.alert >> 32);
+        int64_t index = (int64_t)(record.alert & UINT32_MAX);
+        if (!TBTestRecordIsWhole(record) || writer >= writers) {
+            torn++;
+            return;
+        }
+        if (index <= last[writer]) {
+            outOfOrder++;
+        }
+        last[writer] = index;
+        drained++;
+    };
+
+    dispatch_semaphore_t drainerDone = dispatch_semaphore_create(0);
+    [NSThread detachNewThreadWithBlock:^{
+        while (atomic_load(&writing)) {
+            [buffer drainRecordsUsingBlock:check];
+        }
+        dispatch_semaphore_signal(drainerDone);
+    }];
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    for (NSUInteger w = 0; w < writers; w++) {
+        dispatch_group_async(group, queue, ^{
+            for (NSUInteger i = 0; i < recordsPerWriter; i++) {
+                [buffer recordTraceEvent:TBTestRecord(w, i)];
+            }
+        });
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    atomic_store(&writing, NO);
+    dispatch_semaphore_wait(drainerDone, DISPATCH_TIME_FOREVER);
+
+    // Whatever the drainer stopped short of
+    [buffer drainRecordsUsingBlock:check];
+
+    XCTAssertEqual(torn, 0, @"drained torn records");
+    XCTAssertEqual(outOfOrder, 0, @"drained records out of order");
+    XCTAssertEqual(drained + buffer.droppedCount, writers * recordsPerWriter);
+    XCTAssertGreaterThan(drained, 0);
+}
+
+@end
@@ -0,0 +1,106 @@
+//
+//  TBPresentingViewControllerResolverTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController.h"
+#import "TBHeadlessAlertPresenter.h"
+#import "TBSyntheticNode.h"
+
+/** Resolution and invalidation against changes to a synthetic tree, and showing an alert from the result. */
+@interface TBPresentingViewControllerResolverTests : XCTestCase
+@property (nonatomic) TBPresentingViewControllerResolver *resolver;
+@property (nonatomic) TBSyntheticNode *root;
+@end
+
+@implementation TBPresentingViewControllerResolverTests
+
+- (void)setUp {
+    [super setUp];
+    self.resolver = [TBPresentingViewControllerResolver new];
+    self.root = TBSyntheticTree();
+}
+
+- (void)tearDown {
+    TBPresentingViewControllerResolver.sharedResolver = nil;
+    [super tearDown];
+}
+
+- (void)assertTopOf:(TBSyntheticNode *)root is:(TBSyntheticNode *)expected walks:(NSUInteger)walks when:(NSString *)when {
+    id<TBPresentableNode> top = [self.resolver topNodeFromRoot:root];
+    XCTAssertTrue(top == expected, @"wrong node on top %@", when);
+    XCTAssertEqual(self.resolver.resolutionCount, walks, @"walked the tree too often or too rarely %@", when);
+}
+
+- (void)testWalksTheTreeOnlyWhenItChanges {
+    TBSyntheticNode *root = self.root;
+    TBSyntheticNode *stack = root.children[0];
+    TBSyntheticNode *modal = TBTopModal(root);
+
+    [self assertTopOf:root is:modal walks:1 when:@"at first"];
+    [self assertTopOf:root is:modal walks:1 when:@"when nothing changed"];
+
+    TBSyntheticNode *sheet = [TBSyntheticNode new];
+    [modal present:sheet];
+    [self assertTopOf:root is:sheet walks:2 when:@"after presenting"];
+    [modal dismiss];
+    [self assertTopOf:root is:modal walks:3 when:@"after dismissing"];
+
+    // Dismissing the first modal takes the rest of the chain with it
+    TBSyntheticNode *leaf = stack.children.lastObject;
+    [leaf dismiss];
+    [self assertTopOf:root is:leaf walks:4 when:@"after dismissing every modal"];
+
+    TBSyntheticNode *pushed = [TBSyntheticNode new];
+    [stack push:pushed];
+    [self assertTopOf:root is:pushed walks:5 when:@"after pushing"];
+    [stack pop];
+    [self assertTopOf:root is:leaf walks:6 when:@"after popping"];
+
+    [root select:3];
+    [self assertTopOf:root is:root.children[3].children.lastObject walks:7 when:@"after switching tabs"];
+}
+
+- (void)testInvalidatesForChangesItCannotSee {
+    TBSyntheticNode *top = TBTopModal(self.root);
+    [self assertTopOf:self.root is:top walks:1 when:@"at first"];
+
+    [self.resolver invalidate];
+    [self assertTopOf:self.root is:top walks:2 when:@"after invalidating"];
+    [NSNotificationCenter.defaultCenter postNotificationName:TBAlertControllerDidDismissNotification object:nil];
+    [self assertTopOf:self.root is:top walks:3 when:@"after an alert was dismissed"];
+}
+
+- (void)testCachesEveryRootOnItsOwn {
+    TBSyntheticNode *other = TBSyntheticTree();
+    [self assertTopOf:self.root is:TBTopModal(self.root) walks:1 when:@"of the first root"];
+    [self assertTopOf:other is:TBTopModal(other) walks:2 when:@"of a second root"];
+    [self assertTopOf:self.root is:TBTopModal(self.root) walks:2 when:@"of the first root again"];
+}
+
+- (void)testShowFromAutomaticPresenter {
+    // Shown from the resolved node, which isn't a view controller here
+    TBSyntheticNode *root = self.root;
+    TBHeadlessAlertPresenter *presenter = [TBHeadlessAlertPresenter new];
+    TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Automatic" message:nil];
+    alert.presenter = presenter;
+    [alert setCancelButtonWithTitle:@"OK"];
+
+    self.resolver.rootNodeProvider = ^id<TBPresentableNode> { return root; };
+    TBPresentingViewControllerResolver.sharedResolver = self.resolver;
+    XCTAssertTrue(self.resolver.automaticPresentingNode == TBTopModal(root), @"automaticPresentingNode ignored rootNodeProvider");
+
+    [alert showFromAutomaticPresenterAnimated:NO completion:nil];
+    XCTAssertEqualObjects(presenter.topPresentation.title, @"Automatic");
+
+    // Dismissing the alert invalidates the cache
+    [presenter.topPresentation tapButtonAtIndex:0];
+    XCTAssertNil(presenter.topPresentation);
+    [self assertTopOf:root is:TBTopModal(root) walks:2 when:@"after showFromAutomaticPresenter"];
+}
+
+@end
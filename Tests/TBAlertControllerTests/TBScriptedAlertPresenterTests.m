@@ -0,0 +1,73 @@
+//
+//  TBScriptedAlertPresenterTests.m
+//  TBAlertControllerTests
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TBAlertController.h"
+#import "TBScriptedAlertPresenter.h"
+
+@interface TBScriptedAlertPresenterTests : XCTestCase
+@end
+
+@implementation TBScriptedAlertPresenterTests
+
+/** A sign in alert answered twice by rules, the first time from within a button's action. */
+- (void)testRulesAnswerAlertsShownFromActions {
+    TBScriptedAlertPresenter *responder = [TBScriptedAlertPresenter new];
+
+    TBAlertResponseRule *retry = [TBAlertResponseRule ruleWithIdentifier:@"sign-in"];
+    retry.textFieldValues = @{ @0: @"tanner", @"password": @"wrong" };
+    retry.buttonTitle = @"Sign In";
+    retry.limit = 1;
+    [responder addRule:retry];
+    TBAlertResponseRule *giveUp = [TBAlertResponseRule ruleWithButtonTitles:@[@"Sign In", @"Cancel"]];
+    [responder addRule:giveUp];
+
+    TBAlertController *alert = [TBAlertController alertViewWithTitle:@"Sign in" message:nil];
+    alert.identifier = @"sign-in";
+    alert.presenter = responder;
+    alert.alertViewStyle = UIAlertViewStyleLoginAndPasswordInput;
+    __block NSArray *typed = nil;
+    __weak TBAlertController *weakAlert = alert;
+    [alert addOtherButtonWithTitle:@"Sign In" buttonAction:^(NSArray *strings) {
+        // Wrong password; ask again
+        typed = strings;
+        [weakAlert showFromViewController:nil];
+    }];
+    [alert setCancelButtonWithTitle:@"Cancel"];
+    [alert showFromViewController:nil];
+
+    NSArray<TBAlertTranscriptEntry *> *transcript = responder.transcript;
+    XCTAssertEqual(transcript.count, 2, @"transcript was %@", transcript);
+    if (transcript.count == 2) {
+        XCTAssertEqual(transcript[0].rule, retry);
+        XCTAssertEqual(transcript[1].rule, giveUp);
+        XCTAssertEqual(transcript[0].buttonIndex, 0);
+        XCTAssertEqual(transcript[1].buttonIndex, 1);
+        XCTAssertEqualObjects(transcript[0].textFieldValues, typed);
+    }
+    XCTAssertEqualObjects(typed, (@[@"tanner", @"wrong"]));
+    XCTAssertEqual(responder.presentations.count, 0, @"an answered alert is still presented");
+}
+
+/** Nothing matches an alert without those buttons; it waits for the test. */
+- (void)testUnmatchedAlertsWait {
+    TBScriptedAlertPresenter *responder = [TBScriptedAlertPresenter new];
+    [responder addRule:[TBAlertResponseRule ruleWithButtonTitles:@[@"Sign In", @"Cancel"]]];
+
+    TBAlertController *notice = [TBAlertController alertViewWithTitle:@"Saved" message:nil];
+    notice.presenter = responder;
+    [notice addOtherButtonWithTitle:@"OK"];
+    [notice showFromViewController:nil];
+
+    XCTAssertEqual(responder.topPresentation.alert, notice, @"an unmatched alert was answered");
+    XCTAssertEqual(responder.transcript.lastObject.buttonIndex, NSNotFound);
+    [responder.topPresentation tapButtonAtIndex:0];
+    XCTAssertNil(responder.topPresentation);
+}
+
+@end
@@ -0,0 +1,34 @@
+//
+//  TBSyntheticNode.h
+//  TBAlertTestSupport
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBPresentingViewControllerResolver.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Stands in for a view controller. With \c selectedIndex set it acts like a tab bar controller,
+ and otherwise like a navigation controller, showing its last child. Like a view's window,
+ \c attached is cleared for everything a node shows when it is taken off screen. */
+@interface TBSyntheticNode : NSObject <TBPresentableNode>
+@property (nonatomic, readonly) NSMutableArray<TBSyntheticNode *> *children;
+@property (nonatomic, nullable) TBSyntheticNode *presented;
+@property (nonatomic) NSUInteger selectedIndex;
+@property (nonatomic) BOOL attached;
+
+- (void)push:(TBSyntheticNode *)node;
+- (void)pop;
+- (void)select:(NSUInteger)index;
+- (void)present:(TBSyntheticNode *)node;
+- (void)dismiss;
+@end
+
+/** 1,000 nodes: a tab bar of 10 navigation stacks 90 deep, the first of which presents 89 modals in a chain. */
+extern TBSyntheticNode *TBSyntheticTree(void);
+/** The last modal presented from the top of the first stack of a \c TBSyntheticTree. */
+extern TBSyntheticNode *TBTopModal(TBSyntheticNode *root);
+
+NS_ASSUME_NONNULL_END
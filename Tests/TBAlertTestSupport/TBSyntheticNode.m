@@ -0,0 +1,105 @@
+//
+//  TBSyntheticNode.m
+//  TBAlertTestSupport
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBSyntheticNode.h"
+
+@implementation TBSyntheticNode
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _children = [NSMutableArray new];
+        _selectedIndex = NSNotFound;
+        _attached = YES;
+    }
+
+    return self;
+}
+
+- (id<TBPresentableNode>)tb_presentedNode {
+    return self.presented;
+}
+
+- (id<TBPresentableNode>)tb_visibleChildNode {
+    if (self.selectedIndex != NSNotFound) {
+        return self.children[self.selectedIndex];
+    }
+
+    return self.children.lastObject;
+}
+
+- (BOOL)tb_isAttached {
+    return self.attached;
+}
+
+- (void)setAttached:(BOOL)attached {
+    _attached = attached;
+    [(TBSyntheticNode *)self.tb_visibleChildNode setAttached:attached];
+    [self.presented setAttached:attached];
+}
+
+- (void)push:(TBSyntheticNode *)node {
+    [(TBSyntheticNode *)self.tb_visibleChildNode setAttached:NO];
+    [self.children addObject:node];
+    node.attached = self.attached;
+}
+
+- (void)pop {
+    [self.children.lastObject setAttached:NO];
+    [self.children removeLastObject];
+    [(TBSyntheticNode *)self.tb_visibleChildNode setAttached:self.attached];
+}
+
+- (void)select:(NSUInteger)index {
+    [(TBSyntheticNode *)self.tb_visibleChildNode setAttached:NO];
+    self.selectedIndex = index;
+    [(TBSyntheticNode *)self.tb_visibleChildNode setAttached:self.attached];
+}
+
+- (void)present:(TBSyntheticNode *)node {
+    self.presented = node;
+    node.attached = self.attached;
+}
+
+- (void)dismiss {
+    self.presented.attached = NO;
+    self.presented = nil;
+}
+
+@end
+
+TBSyntheticNode *TBSyntheticTree(void) {
+    TBSyntheticNode *root = [TBSyntheticNode new];
+    for (NSUInteger i = 0; i < 10; i++) {
+        TBSyntheticNode *stack = [TBSyntheticNode new];
+        for (NSUInteger j = 0; j < 90; j++) {
+            [stack push:[TBSyntheticNode new]];
+        }
+        stack.attached = i == 0;
+        [root.children addObject:stack];
+    }
+    root.selectedIndex = 0;
+
+    TBSyntheticNode *presenting = root.children[0].children.lastObject;
+    for (NSUInteger i = 0; i < 89; i++) {
+        TBSyntheticNode *modal = [TBSyntheticNode new];
+        [presenting present:modal];
+        presenting = modal;
+    }
+
+    return root;
+}
+
+TBSyntheticNode *TBTopModal(TBSyntheticNode *root) {
+    TBSyntheticNode *top = root.children[0].children.lastObject;
+    while (top.presented) {
+        top = top.presented;
+    }
+
+    return top;
+}
@@ -0,0 +1,34 @@
+//
+//  main.m
+//  tbalert-catalog
+//
+//  Created by Tanner Bennett on 10/17/26.
+//  Copyright (c) 2021 Tanner. All rights reserved.
+//
+
+#import "TBAlertCatalog.h"
+
+/// Compiles a directory of alert specs into a catalog, for use in a build phase:
+///
+///     tbalert-catalog Alerts/ Alerts.tbcatalog
+int main(int argc, const char *argv[]) {
+    @autoreleasepool {
+        if (argc != 3) {
+            fprintf(stderr, "usage: %s <spec directory> <catalog>\n", argv[0]);
+            return 2;
+        }
+
+        NSString *directory = @(argv[1]);
+        NSString *path = @(argv[2]);
+        NSError *error = nil;
+        if (![TBAlertCatalog compileSpecsInDirectory:directory toFile:path error:&error]) {
+            fprintf(stderr, "error: %s\n", error.localizedDescription.UTF8String);
+            return 1;
+        }
+
+        TBAlertCatalog *catalog = [TBAlertCatalog catalogWithContentsOfFile:path error:&error];
+        printf("%s: %lu alerts\n", path.UTF8String, (unsigned long)catalog.count);
+    }
+
+    return 0;
+}